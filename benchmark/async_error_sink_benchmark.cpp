@@ -0,0 +1,138 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the latency of an error handler which logs diagnostic_details.
+// Compares:
+//
+// - ostream:     operator<< into a std::ofstream opened on the null device,
+//                flushed after each message (like std::cerr);
+// - file:        print_to into a char buffer, then fwrite and fflush to a
+//                temporary file;
+// - async_sink:  async_error_sink::push, with the sink writing to a
+//                temporary file from its background thread.
+//
+// Pushing back to back, without pause, would fill the ring buffer of the
+// sink and measure the cost of dropping messages. Instead, the messages are
+// pushed in bursts which fit in the ring buffer, and the sink is flushed
+// between bursts; only the bursts are timed. The "dropped" column reports the
+// number of messages async_error_sink dropped anyway.
+
+#include <boost/leaf/async_error_sink.hpp>
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    struct e_file_name { std::string value; };
+    struct e_line { int value; };
+    struct e_ratio { double value; };
+    enum class e_kind { read = 1, write = 2 };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<void> fail()
+    {
+        auto load = leaf::on_error(e_kind::write);
+        return BOOST_LEAF_NEW_ERROR(e_file_name{"/var/log/leaf/benchmark.log"}, e_line{42}, e_ratio{0.75});
+    }
+
+    // Returns the average time of async_error_sink::push, in nanoseconds.
+    double measure_push_ns( leaf::async_error_sink & sink, leaf::diagnostic_details const & dd, int iterations, int burst )
+    {
+        using clock = std::chrono::steady_clock;
+        long long s = 0;
+        double best = -1;
+        for( int r = 0; r != 4; ++r )
+        {
+            double total = 0;
+            for( int i = 0; i < iterations; i += burst )
+            {
+                auto t0 = clock::now();
+                for( int j = 0; j != burst; ++j )
+                    s += sink.push(dd);
+                auto t1 = clock::now();
+                total += std::chrono::duration<double, std::nano>(t1 - t0).count();
+                sink.flush();
+            }
+            double ns = total / ((iterations + burst - 1) / burst * burst);
+            if( r && (best < 0 || ns < best) )
+                best = ns;
+        }
+        benchmark::sink() = benchmark::sink() + s;
+        return best;
+    }
+
+    void write_row( benchmark::report & rep, char const * writer, int iterations, double ns, long long dropped )
+    {
+        benchmark::row r(rep);
+        r   ("writer", writer)
+            ("iterations", iterations)
+            ("ns_per_call", ns)
+            ("dropped", dropped);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 200000;
+
+#ifdef _WIN32
+    std::ofstream null_device("NUL");
+#else
+    std::ofstream null_device("/dev/null");
+#endif
+
+    benchmark::report rep("async_error_sink");
+    leaf::try_handle_all(
+        []
+        {
+            return fail();
+        },
+        [&]( leaf::diagnostic_details const & dd )
+        {
+            if( null_device )
+                write_row(rep, "ostream", iterations, benchmark::measure_ns(iterations,
+                    [&]( int ) -> long long
+                    {
+                        null_device << dd << std::flush;
+                        return 1;
+                    } ), 0);
+
+            if( std::FILE * f = std::tmpfile() )
+            {
+                write_row(rep, "file", iterations, benchmark::measure_ns(iterations,
+                    [&]( int ) -> long long
+                    {
+                        char buf[1024];
+                        std::size_t n = print_to(buf, sizeof(buf), dd);
+                        n = std::fwrite(buf, 1, n < sizeof(buf) ? n : sizeof(buf) - 1, f);
+                        (void) std::fflush(f);
+                        return (long long) n;
+                    } ), 0);
+                std::fclose(f);
+            }
+
+            if( std::FILE * f = std::tmpfile() )
+            {
+                long long dropped;
+                double ns;
+                {
+                    leaf::async_error_sink sink(f, 4096);
+                    ns = measure_push_ns(sink, dd, iterations, 1024);
+                    dropped = (long long) sink.dropped();
+                }
+                write_row(rep, "async_sink", iterations, ns, dropped);
+                std::fclose(f);
+            }
+        } );
+    return 0;
+}
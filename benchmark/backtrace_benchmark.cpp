@@ -0,0 +1,124 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of recording an e_backtrace on the error path: an error
+// is created at the bottom of a chain of 10 calls that can't be inlined, and
+// handled at the top. Compares:
+//
+// - none: no backtrace;
+// - on_error: each function records its return address (BOOST_LEAF_BACKTRACE);
+// - capture: the call stack is captured when the error is created;
+// - capture_print: same as capture, and the handler also prints the
+//   backtrace, which symbolizes every frame.
+//
+// Except for capture_print, errors are handled without printing the
+// backtrace, so no symbolization takes place.
+
+#include <boost/leaf/backtrace.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <sstream>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int const depth = 10;
+
+    using backtrace = leaf::e_backtrace<32>;
+
+    enum class mode { none, on_error, capture };
+
+    template <mode M>
+    struct fail
+    {
+        static leaf::error_id f() { return leaf::new_error(); }
+    };
+
+    template <>
+    struct fail<mode::capture>
+    {
+        static leaf::error_id f() { return leaf::new_error(&backtrace::capture); }
+    };
+
+    template <mode M>
+    struct chain;
+
+    template <>
+    struct chain<mode::on_error>
+    {
+        BOOST_LEAF_BENCHMARK_NOINLINE static leaf::result<int> f( int depth, int i )
+        {
+            BOOST_LEAF_BACKTRACE(backtrace);
+            if( depth == 0 )
+                return fail<mode::on_error>::f();
+            BOOST_LEAF_AUTO(r, f(depth - 1, i));
+            return r + 1;
+        }
+    };
+
+    template <mode M>
+    struct chain
+    {
+        BOOST_LEAF_BENCHMARK_NOINLINE static leaf::result<int> f( int depth, int i )
+        {
+            if( depth == 0 )
+                return fail<M>::f();
+            BOOST_LEAF_AUTO(r, f(depth - 1, i));
+            return r + 1;
+        }
+    };
+
+    template <mode M, bool Print>
+    long long handle( int i )
+    {
+        return leaf::try_handle_all(
+            [=]
+            {
+                return chain<M>::f(depth, i);
+            },
+            []( backtrace const & bt ) -> long long
+            {
+                if( Print )
+                {
+                    std::ostringstream s;
+                    s << bt;
+                    return (long long) s.str().size();
+                }
+                return (long long) bt.size();
+            },
+            []
+            {
+                return -1ll;
+            } );
+    }
+
+    template <mode M, bool Print = false>
+    void run( benchmark::report & rep, char const * name, int iterations )
+    {
+        double ns = benchmark::measure_ns(iterations, &handle<M, Print>);
+        benchmark::row r(rep);
+        r   ("trace", name)
+            ("depth", depth)
+            ("capacity", int(backtrace::capacity()))
+            ("dladdr", BOOST_LEAF_CFG_DLADDR)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 200000;
+
+    benchmark::report rep("backtrace");
+    run<mode::none>(rep, "none", iterations);
+    run<mode::on_error>(rep, "on_error", iterations);
+    run<mode::capture>(rep, "capture", iterations);
+    run<mode::capture, true>(rep, "capture_print", iterations / 10);
+    return 0;
+}
@@ -0,0 +1,195 @@
+#ifndef BOOST_LEAF_BENCHMARK_HPP_INCLUDED
+#define BOOST_LEAF_BENCHMARK_HPP_INCLUDED
+
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Shared infrastructure for the LEAF benchmark programs. Each benchmark
+// writes a single JSON document to stdout: a "config" object describing how
+// LEAF was configured, followed by a "results" array with one object per
+// measurement. Keep the output machine-readable; do not print anything else
+// to stdout.
+
+#include <boost/leaf/config.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _MSC_VER
+#   define BOOST_LEAF_BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#   define BOOST_LEAF_BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace benchmark
+{
+    // Benchmarks accumulate computed values into sink, so the optimizer can't
+    // discard the work being measured.
+    inline long long volatile & sink() noexcept
+    {
+        static long long volatile x;
+        return x;
+    }
+
+    // Calls f(i) for i in [0, iterations) and returns the average time per
+    // call in nanoseconds. The measurement is repeated a few times (after a
+    // warm-up run) and the fastest run is reported, which filters out most of
+    // the noise caused by the OS.
+    template <class F>
+    double measure_ns( int iterations, F && f )
+    {
+        using clock = std::chrono::steady_clock;
+        long long s = 0;
+        for( int i = 0; i != iterations; ++i )
+            s += f(i);
+        double best = -1;
+        for( int r = 0; r != 3; ++r )
+        {
+            auto t0 = clock::now();
+            for( int i = 0; i != iterations; ++i )
+                s += f(i);
+            auto t1 = clock::now();
+            double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+            if( best < 0 || ns < best )
+                best = ns;
+        }
+        sink() = sink() + s;
+        return best;
+    }
+
+    ////////////////////////////////////////
+
+    namespace detail
+    {
+        inline void write_string( char const * s )
+        {
+            std::putchar('"');
+            for( ; *s; ++s )
+                if( *s == '"' || *s == '\\' )
+                    std::printf("\\%c", *s);
+                else if( static_cast<unsigned char>(*s) < 0x20 )
+                    std::printf("\\u%04x", static_cast<unsigned char>(*s));
+                else
+                    std::putchar(*s);
+            std::putchar('"');
+        }
+
+        inline void write_value( char const * x ) { write_string(x); }
+        inline void write_value( bool x ) { std::printf("%s", x ? "true" : "false"); }
+        inline void write_value( int x ) { std::printf("%d", x); }
+        inline void write_value( unsigned x ) { std::printf("%u", x); }
+        inline void write_value( long x ) { std::printf("%ld", x); }
+        inline void write_value( unsigned long x ) { std::printf("%lu", x); }
+        inline void write_value( long long x ) { std::printf("%lld", x); }
+        inline void write_value( unsigned long long x ) { std::printf("%llu", x); }
+        inline void write_value( double x ) { std::printf("%.3f", x); }
+    } // namespace detail
+
+    // The JSON document. The constructor writes the benchmark name and the
+    // LEAF configuration, the destructor closes the "results" array.
+    class report
+    {
+        report( report const & ) = delete;
+        report & operator=( report const & ) = delete;
+
+        char const * sep_;
+
+    public:
+
+        explicit report( char const * name ):
+            sep_("")
+        {
+            std::printf("{\n  \"benchmark\": ");
+            detail::write_string(name);
+            std::printf(",\n  \"config\": {");
+            config_item("cplusplus", static_cast<long>(__cplusplus), "");
+#if defined(__clang__)
+            config_item("compiler", "clang " __clang_version__);
+#elif defined(__GNUC__)
+            config_item("compiler", "gcc " __VERSION__);
+#elif defined(_MSC_VER)
+            config_item("compiler", "msvc");
+            config_item("msc_ver", static_cast<long>(_MSC_VER));
+#endif
+            config_item("BOOST_LEAF_CFG_DIAGNOSTICS", BOOST_LEAF_CFG_DIAGNOSTICS);
+            config_item("BOOST_LEAF_CFG_CAPTURE", BOOST_LEAF_CFG_CAPTURE);
+            config_item("BOOST_LEAF_CFG_STD_STRING", BOOST_LEAF_CFG_STD_STRING);
+            config_item("BOOST_LEAF_CFG_STD_SYSTEM_ERROR", BOOST_LEAF_CFG_STD_SYSTEM_ERROR);
+#ifdef BOOST_LEAF_NO_EXCEPTIONS
+            config_item("exceptions", false);
+#else
+            config_item("exceptions", true);
+#endif
+#ifdef BOOST_LEAF_NO_THREADS
+            config_item("threads", false);
+#else
+            config_item("threads", true);
+#endif
+            std::printf(" },\n  \"results\": [");
+        }
+
+        ~report() noexcept
+        {
+            std::printf("\n  ]\n}\n");
+            std::fflush(stdout);
+        }
+
+        template <class T>
+        void config_item( char const * name, T const & value, char const * sep = "," )
+        {
+            std::printf("%s ", sep);
+            detail::write_string(name);
+            std::printf(": ");
+            detail::write_value(value);
+        }
+
+        char const * next_row() noexcept
+        {
+            char const * s = sep_;
+            sep_ = ",";
+            return s;
+        }
+    };
+
+    // A single JSON object, written member by member:
+    //
+    //   benchmark::row r(rep);
+    //   r("strategy", "leaf_result")("depth", 10)("ns_per_call", 12.5);
+    //
+    // The closing brace is written by the destructor.
+    class row
+    {
+        row( row const & ) = delete;
+        row & operator=( row const & ) = delete;
+
+        char const * sep_;
+
+    public:
+
+        explicit row( report & rep ) noexcept:
+            sep_("")
+        {
+            std::printf("%s\n    {", rep.next_row());
+        }
+
+        ~row() noexcept
+        {
+            std::printf(" }");
+        }
+
+        template <class T>
+        row & operator()( char const * name, T const & value )
+        {
+            std::printf("%s ", sep_);
+            detail::write_string(name);
+            std::printf(": ");
+            detail::write_value(value);
+            sep_ = ",";
+            return *this;
+        }
+    };
+
+} // namespace benchmark
+
+#endif // #ifndef BOOST_LEAF_BENCHMARK_HPP_INCLUDED
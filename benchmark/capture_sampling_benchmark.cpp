@@ -0,0 +1,120 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of an error, from new_error to the end of an error
+// handler which takes diagnostic_details, when most error objects are not
+// handled and therefore are captured. The "captured" column reports the
+// fraction of errors which had their error objects captured. Compares:
+//
+// - diagnostic_info:  a handler which takes diagnostic_info instead, so
+//                     nothing is captured (the lower bound);
+// - no_policy:        every error is captured;
+// - sample_1_in_100:  capture_sampling_policy(100);
+// - max_100_per_sec:  capture_sampling_policy(1, 100);
+// - storm_1000:       capture_sampling_policy(1, 0, 1000), which stops
+//                     capturing since errors occur at a higher rate.
+
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <string>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    struct e_file_name { std::string value; };
+    struct e_line { int value; };
+    struct e_ratio { double value; };
+    enum class e_kind { read = 1, write = 2 };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> fail( int i )
+    {
+        auto load = leaf::on_error(e_kind::write);
+        return BOOST_LEAF_NEW_ERROR(e_file_name{"/var/log/leaf/benchmark.log"}, e_line{i}, e_ratio{0.75});
+    }
+
+    BOOST_LEAF_BENCHMARK_NOINLINE int handle_info( int i )
+    {
+        return leaf::try_handle_all(
+            [i]
+            {
+                return fail(i);
+            },
+            []( leaf::diagnostic_info const & di )
+            {
+                return di.error().value() & 1;
+            } );
+    }
+
+    BOOST_LEAF_BENCHMARK_NOINLINE int handle_details( int i )
+    {
+        return leaf::try_handle_all(
+            [i]
+            {
+                return fail(i);
+            },
+            []( leaf::diagnostic_details const & dd )
+            {
+                return dd.error().value() & 1;
+            } );
+    }
+
+    void write_row( benchmark::report & rep, char const * policy, int iterations, double ns, double captured )
+    {
+        benchmark::row r(rep);
+        r   ("policy", policy)
+            ("iterations", iterations)
+            ("ns_per_error", ns)
+            ("captured", captured);
+    }
+
+    void run( benchmark::report & rep, char const * name, int iterations, leaf::capture_sampling_policy * p )
+    {
+        leaf::set_capture_sampling_policy(p);
+        double ns = benchmark::measure_ns(iterations,
+            []( int i ) -> long long
+            {
+                return handle_details(i);
+            } );
+        leaf::set_capture_sampling_policy(nullptr);
+        write_row(rep, name, iterations, ns, p ? double(p->sampled()) / double(p->sampled() + p->declined()) : 1);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 1000000;
+
+    benchmark::report rep("capture_sampling");
+
+    write_row(rep, "diagnostic_info", iterations, benchmark::measure_ns(iterations,
+        []( int i ) -> long long
+        {
+            return handle_info(i);
+        } ), 0);
+
+    run(rep, "no_policy", iterations, nullptr);
+
+    {
+        leaf::capture_sampling_policy p(100);
+        run(rep, "sample_1_in_100", iterations, &p);
+    }
+
+    {
+        leaf::capture_sampling_policy p(1, 100);
+        run(rep, "max_100_per_sec", iterations, &p);
+    }
+
+    {
+        leaf::capture_sampling_policy p(1, 0, 1000);
+        run(rep, "storm_1000", iterations, &p);
+    }
+
+    return 0;
+}
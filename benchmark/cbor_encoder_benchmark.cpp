@@ -0,0 +1,116 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the size and the cost of serializing diagnostic_details with
+// cbor_encoder, compared to json_encoder. Both write into a char buffer.
+// The error is the same as in json_encoder_benchmark.cpp.
+
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/common.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/serialization/cbor_encoder.hpp>
+#include <boost/leaf/serialization/json_encoder.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace leaf = boost::leaf;
+
+namespace boost { namespace leaf {
+
+namespace serialization {
+
+template <class Handle, class T>
+void serialize( Handle & h, T const & x, name_id name )
+{
+    h.dispatch(
+        [&]( cbor_encoder & e ) { output_at(e, x, name); },
+        [&]( json_encoder & e ) { output_at(e, x, name); } );
+}
+
+}
+
+} }
+
+namespace
+{
+    struct e_request
+    {
+        int status;
+        std::string url;
+
+        template <class Encoder>
+        friend void output( Encoder & e, e_request const & x )
+        {
+            output_at(e, x.status, "status");
+            output_at(e, x.url, "url");
+        }
+    };
+
+    struct e_retry_count { int value; };
+    struct e_elapsed_ms { double value; };
+    struct e_offsets { std::vector<int> value; };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<void> fail()
+    {
+        auto load = leaf::on_error(e_retry_count{3}, e_elapsed_ms{12.5});
+        return BOOST_LEAF_NEW_ERROR(
+            e_request{503, "https://example.com/api/v1/items?id=42"},
+            leaf::e_api_function{"fetch_items"},
+            leaf::e_file_name{"/var/cache/items.json"},
+            e_offsets{{0, 512, 1024, 4096}} );
+    }
+
+    void write_row( benchmark::report & rep, char const * encoder, long long bytes, int iterations, double ns )
+    {
+        benchmark::row r(rep);
+        r   ("encoder", encoder)
+            ("bytes", bytes)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+
+    template <class F>
+    void run( benchmark::report & rep, char const * encoder, int iterations, F f )
+    {
+        double ns = benchmark::measure_ns(iterations, f);
+        write_row(rep, encoder, f(0), iterations, ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 200000;
+
+    benchmark::report rep("cbor_encoder");
+    leaf::try_handle_all(
+        []
+        {
+            return fail();
+        },
+        [&]( leaf::diagnostic_details const & dd )
+        {
+            run(rep, "cbor", iterations,
+                [&]( int ) -> long long
+                {
+                    unsigned char buf[2048];
+                    leaf::serialization::cbor_encoder e(buf, sizeof(buf));
+                    dd.serialize_to(e);
+                    return (long long) e.finish();
+                } );
+
+            run(rep, "json", iterations,
+                [&]( int ) -> long long
+                {
+                    char buf[2048];
+                    leaf::serialization::json_encoder e(buf, sizeof(buf));
+                    dd.serialize_to(e);
+                    return (long long) e.finish();
+                } );
+        } );
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of logging diagnostic_info for a caught std::runtime_error,
+// which includes the demangled name of the dynamic type of the exception.
+// Compares:
+//
+// - print_to:     formatting into a fixed char buffer;
+// - json_encoder: serializing into a fixed char buffer.
+//
+// Build with -DBOOST_LEAF_CFG_DEMANGLE_CACHE=0 to compare with demangling
+// on each call (see meson.build).
+
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/exception.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include <boost/leaf/serialization/json_encoder.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace leaf = boost::leaf;
+
+namespace boost { namespace leaf {
+
+namespace serialization {
+
+template <class Handle, class T>
+void serialize( Handle & h, T const & x, char const * name )
+{
+    h.dispatch(
+        [&]( json_encoder & e ) { output_at(e, x, name); } );
+}
+
+}
+
+} }
+
+namespace
+{
+    BOOST_LEAF_BENCHMARK_NOINLINE void fail()
+    {
+        throw std::runtime_error("connection reset by peer");
+    }
+
+    void write_row( benchmark::report & rep, char const * writer, long long bytes, int iterations, double ns )
+    {
+        benchmark::row r(rep);
+        r   ("demangle_cache", BOOST_LEAF_CFG_DEMANGLE_CACHE != 0)
+            ("writer", writer)
+            ("bytes", bytes)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+
+    template <class F>
+    void run( benchmark::report & rep, char const * writer, int iterations, F f )
+    {
+        double ns = benchmark::measure_ns(iterations, f);
+        write_row(rep, writer, f(0), iterations, ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 1000000;
+
+    benchmark::report rep("demangle");
+    leaf::try_catch(
+        []
+        {
+            fail();
+        },
+        [&]( leaf::diagnostic_info const & di )
+        {
+            run(rep, "print_to", iterations,
+                [&]( int ) -> long long
+                {
+                    char buf[1024];
+                    return (long long) print_to(buf, sizeof(buf), di);
+                } );
+
+            run(rep, "json_encoder", iterations,
+                [&]( int ) -> long long
+                {
+                    char buf[1024];
+                    leaf::serialization::json_encoder e(buf, sizeof(buf));
+                    di.serialize_to(e);
+                    return (long long) e.finish();
+                } );
+        } );
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of formatting diagnostic_info and diagnostic_details
+// into text. Compares:
+//
+// - ostream: operator<< into a std::ostringstream, then str();
+// - buffer: print_to into a fixed char buffer.
+//
+// The error carries a handful of typical error objects: integers, a double,
+// a string, an enum and a user-defined type printed through operator<<.
+
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    struct e_file_name { std::string value; };
+    struct e_line { int value; };
+    struct e_ratio { double value; };
+    struct e_offset { long long value; };
+    enum class e_kind { read = 1, write = 2 };
+
+    struct e_range
+    {
+        int first, last;
+
+        friend std::ostream & operator<<( std::ostream & os, e_range const & x )
+        {
+            return os << '[' << x.first << ", " << x.last << ')';
+        }
+    };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<void> fail()
+    {
+        auto load = leaf::on_error(e_kind::write, e_range{10, 20});
+        return BOOST_LEAF_NEW_ERROR(e_file_name{"/var/log/leaf/benchmark.log"}, e_line{42}, e_ratio{0.75}, e_offset{-1234567890123ll});
+    }
+
+    template <class T>
+    long long format_ostream( T const & x, int )
+    {
+        std::ostringstream s;
+        s << x;
+        return (long long) s.str().size();
+    }
+
+    template <class T>
+    long long format_buffer( T const & x, int )
+    {
+        char buf[1024];
+        return (long long) print_to(buf, sizeof(buf), x);
+    }
+
+    void write_row( benchmark::report & rep, char const * object, char const * writer, long long bytes, int iterations, double ns )
+    {
+        benchmark::row r(rep);
+        r   ("object", object)
+            ("writer", writer)
+            ("bytes", bytes)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+
+    template <class T>
+    void run( benchmark::report & rep, char const * object, T const & x, int iterations )
+    {
+        double ns_ostream = benchmark::measure_ns(iterations, [&]( int i ) { return format_ostream(x, i); });
+        write_row(rep, object, "ostream", format_ostream(x, 0), iterations, ns_ostream);
+        double ns_buffer = benchmark::measure_ns(iterations, [&]( int i ) { return format_buffer(x, i); });
+        write_row(rep, object, "buffer", format_buffer(x, 0), iterations, ns_buffer);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 200000;
+
+    benchmark::report rep("diagnostics_format");
+    leaf::try_handle_all(
+        []
+        {
+            return fail();
+        },
+        [&]( leaf::diagnostic_info const & di, leaf::diagnostic_details const & dd )
+        {
+            run(rep, "diagnostic_info", di, iterations);
+            run(rep, "diagnostic_details", dd, iterations);
+        } );
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Multi-thread scaling benchmark for error id generation. Every thread calls
+// leaf::new_error() in a tight loop, which is the worst case for contention
+// on the shared error id counter (see config/tls.hpp). Build this program with
+// different values of BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE to compare the
+// default (one atomic increment per error id) with per-thread id blocks.
+
+#include <boost/leaf/config.hpp>
+
+#ifdef BOOST_LEAF_NO_THREADS
+
+#include "benchmark.hpp"
+
+int main()
+{
+    benchmark::report rep("error_id");
+    return 0;
+}
+
+#else
+
+#include <boost/leaf/error.hpp>
+#include "benchmark.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    // Returns the elapsed time in nanoseconds between the moment all threads
+    // are released and the moment the last thread finishes.
+    double run( int thread_count, int ids_per_thread )
+    {
+        using clock = std::chrono::steady_clock;
+        std::atomic<int> ready(0);
+        std::atomic<bool> go(false);
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for( int t = 0; t != thread_count; ++t )
+            threads.emplace_back(
+                [&]
+                {
+                    ++ready;
+                    while( !go.load(std::memory_order_acquire) )
+                        ;
+                    unsigned s = 0;
+                    for( int i = 0; i != ids_per_thread; ++i )
+                        s += unsigned(leaf::new_error().value());
+                    benchmark::sink() += s;
+                } );
+        while( ready.load() != thread_count )
+            ;
+        auto t0 = clock::now();
+        go.store(true, std::memory_order_release);
+        for( auto & t : threads )
+            t.join();
+        auto t1 = clock::now();
+        return std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const ids_per_thread = quick ? 100000 : 2000000;
+    int max_threads = int(std::thread::hardware_concurrency());
+    if( max_threads < 1 )
+        max_threads = 1;
+
+    benchmark::report rep("error_id");
+    for( int thread_count = 1; ; thread_count *= 2 )
+    {
+        if( thread_count > max_threads )
+            thread_count = max_threads;
+        double best = -1;
+        for( int r = 0; r != 3; ++r )
+        {
+            double ns = run(thread_count, ids_per_thread);
+            if( best < 0 || ns < best )
+                best = ns;
+        }
+        double total_ids = double(thread_count) * ids_per_thread;
+        benchmark::row row(rep);
+        row ("block_size", BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE)
+            ("threads", thread_count)
+            ("ids_per_thread", ids_per_thread)
+            ("ns_per_id", best * thread_count / total_ids)
+            ("million_ids_per_second", total_ids * 1000 / best);
+        if( thread_count == max_threads )
+            break;
+    }
+    return 0;
+}
+
+#endif // #ifdef BOOST_LEAF_NO_THREADS
@@ -0,0 +1,270 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// End-to-end error path benchmark. An error is (maybe) detected at the bottom
+// of a call chain of configurable depth, then propagated up to a handler at
+// the top. The following strategies are compared:
+//
+// - leaf_result:    leaf::result<T> + leaf::try_handle_all;
+// - leaf_exception: BOOST_LEAF_THROW_EXCEPTION + leaf::try_catch;
+// - tl_expected:    tl::expected<T, E> (only if BOOST_LEAF_BENCHMARK_TL_EXPECTED
+//                   is defined, see meson.build);
+// - error_code:     a plain int error code, as a baseline.
+//
+// Each strategy is measured across call depths, error rates (the percentage of
+// calls that fail) and error payload sizes. The results are written to stdout
+// as JSON (see benchmark.hpp). Pass "--quick" to run a reduced matrix, e.g.
+// as a smoke test.
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include <boost/leaf/exception.hpp>
+#ifdef BOOST_LEAF_BENCHMARK_TL_EXPECTED
+#   include <tl/expected.hpp>
+#endif
+#include "benchmark.hpp"
+#include <cstring>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    // The error payload. For Size == 0 only the int value is communicated.
+    template <int Size>
+    struct e_payload
+    {
+        int value;
+        char data[Size];
+    };
+
+    template <>
+    struct e_payload<0>
+    {
+        int value;
+    };
+
+    template <int Size>
+    e_payload<Size> make_payload( int depth ) noexcept
+    {
+        e_payload<Size> p;
+        std::memset(&p, 0, sizeof(p));
+        p.value = depth;
+        return p;
+    }
+
+    // The failure pattern: fail[i % failure_pattern_size] determines whether
+    // iteration i fails. The failures are spread out deterministically, so that
+    // branch prediction doesn't distort the results for the error rates in
+    // between 0% and 100%.
+    int const failure_pattern_size = 1024;
+    bool fail[failure_pattern_size];
+
+    void init_failure_pattern( int error_rate_percent ) noexcept
+    {
+        int acc = 0;
+        unsigned x = 12345;
+        for( int i = 0; i != failure_pattern_size; ++i )
+            fail[i] = false;
+        int const n = failure_pattern_size * error_rate_percent / 100;
+        while( acc != n )
+        {
+            x = x * 1664525u + 1013904223u;
+            int j = int((x >> 8) % failure_pattern_size);
+            if( !fail[j] )
+            {
+                fail[j] = true;
+                ++acc;
+            }
+        }
+    }
+
+    ////////////////////////////////////////
+
+    template <int Size>
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> leaf_result_f( int depth, bool fail )
+    {
+        if( depth == 0 )
+        {
+            if( fail )
+                return leaf::new_error(make_payload<Size>(depth));
+            return 1;
+        }
+        BOOST_LEAF_AUTO(r, leaf_result_f<Size>(depth - 1, fail));
+        return r + 1;
+    }
+
+    template <int Size>
+    int leaf_result( int depth, int i )
+    {
+        return leaf::try_handle_all(
+            [=]
+            {
+                return leaf_result_f<Size>(depth, fail[i % failure_pattern_size]);
+            },
+            []( e_payload<Size> const & p )
+            {
+                return -p.value;
+            },
+            []
+            {
+                return -1;
+            } );
+    }
+
+    ////////////////////////////////////////
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    template <int Size>
+    BOOST_LEAF_BENCHMARK_NOINLINE int leaf_exception_f( int depth, bool fail )
+    {
+        if( depth == 0 )
+        {
+            if( fail )
+                BOOST_LEAF_THROW_EXCEPTION(make_payload<Size>(depth));
+            return 1;
+        }
+        return leaf_exception_f<Size>(depth - 1, fail) + 1;
+    }
+
+    template <int Size>
+    int leaf_exception( int depth, int i )
+    {
+        return leaf::try_catch(
+            [=]
+            {
+                return leaf_exception_f<Size>(depth, fail[i % failure_pattern_size]);
+            },
+            []( e_payload<Size> const & p )
+            {
+                return -p.value;
+            },
+            []
+            {
+                return -1;
+            } );
+    }
+#endif
+
+    ////////////////////////////////////////
+
+#ifdef BOOST_LEAF_BENCHMARK_TL_EXPECTED
+    template <int Size>
+    BOOST_LEAF_BENCHMARK_NOINLINE tl::expected<int, e_payload<Size>> tl_expected_f( int depth, bool fail )
+    {
+        if( depth == 0 )
+        {
+            if( fail )
+                return tl::make_unexpected(make_payload<Size>(depth));
+            return 1;
+        }
+        auto r = tl_expected_f<Size>(depth - 1, fail);
+        if( !r )
+            return tl::make_unexpected(r.error());
+        return *r + 1;
+    }
+
+    template <int Size>
+    int tl_expected( int depth, int i )
+    {
+        auto r = tl_expected_f<Size>(depth, fail[i % failure_pattern_size]);
+        if( r )
+            return *r;
+        return -r.error().value;
+    }
+#endif
+
+    ////////////////////////////////////////
+
+    // Baseline: the error code is returned, the payload (if any) is
+    // communicated through an out parameter.
+    template <int Size>
+    BOOST_LEAF_BENCHMARK_NOINLINE int error_code_f( int depth, bool fail, int & value, e_payload<Size> & payload )
+    {
+        if( depth == 0 )
+        {
+            if( fail )
+            {
+                payload = make_payload<Size>(depth);
+                return 1;
+            }
+            value = 1;
+            return 0;
+        }
+        if( int ec = error_code_f<Size>(depth - 1, fail, value, payload) )
+            return ec;
+        ++value;
+        return 0;
+    }
+
+    template <int Size>
+    int error_code( int depth, int i )
+    {
+        int value;
+        e_payload<Size> payload;
+        if( error_code_f<Size>(depth, fail[i % failure_pattern_size], value, payload) )
+            return -payload.value;
+        return value;
+    }
+
+    ////////////////////////////////////////
+
+    // Scale the iteration count with the call depth so that each measurement
+    // takes roughly the same time.
+    int iterations( int depth, bool quick ) noexcept
+    {
+        int n = (quick ? 200000 : 2000000) / (depth + 10);
+        return n < 100 ? 100 : n;
+    }
+
+    template <int Size>
+    void run( benchmark::report & rep, char const * strategy, int (*f)(int, int), int depth, int error_rate, bool quick )
+    {
+        int const n = iterations(depth, quick);
+        double ns = benchmark::measure_ns(n, [=]( int i ) { return f(depth, i); });
+        benchmark::row r(rep);
+        r   ("strategy", strategy)
+            ("depth", depth)
+            ("error_rate", error_rate)
+            ("payload_size", int(sizeof(e_payload<Size>)))
+            ("iterations", n)
+            ("ns_per_call", ns);
+    }
+
+    template <int Size>
+    void run_strategies( benchmark::report & rep, int depth, int error_rate, bool quick )
+    {
+        run<Size>(rep, "leaf_result", &leaf_result<Size>, depth, error_rate, quick);
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+        run<Size>(rep, "leaf_exception", &leaf_exception<Size>, depth, error_rate, quick);
+#endif
+#ifdef BOOST_LEAF_BENCHMARK_TL_EXPECTED
+        run<Size>(rep, "tl_expected", &tl_expected<Size>, depth, error_rate, quick);
+#endif
+        run<Size>(rep, "error_code", &error_code<Size>, depth, error_rate, quick);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+
+    int const depths[ ] = { 1, 10, 100, 1000 };
+    int const error_rates[ ] = { 0, 1, 10, 50, 100 };
+
+    benchmark::report rep("error_path");
+    for( int error_rate : error_rates )
+    {
+        init_failure_pattern(error_rate);
+        for( int depth : depths )
+        {
+            if( quick && depth > 100 )
+                continue;
+            run_strategies<0>(rep, depth, error_rate, quick);
+            run_strategies<64>(rep, depth, error_rate, quick);
+            run_strategies<1024>(rep, depth, error_rate, quick);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of throwing an exception and dispatching it by type,
+// with 15 listed exception types, for three hierarchies:
+//
+// - flat: 15 unrelated types deriving from std::exception;
+// - deep: a single chain of 15 types, each deriving from the previous one;
+// - mixin: types deriving from std::exception and from several of 15
+//   polymorphic mixin types, which requires cross casts.
+//
+// Each hierarchy is dispatched with leaf::exception_to_result, and with
+// leaf::try_catch using one leaf::catch_<> handler per type. Build this
+// program with BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE=0 to compare with uncached
+// dynamic_cast.
+
+#include <boost/leaf/exception.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include <boost/leaf/pred.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <utility>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int const type_count = 15;
+
+    template <int I>
+    struct flat: std::exception
+    {
+    };
+
+    template <int I>
+    struct deep: deep<I - 1>
+    {
+    };
+
+    template <>
+    struct deep<0>: std::exception
+    {
+    };
+
+    template <int I>
+    struct mixin
+    {
+        virtual ~mixin() noexcept { }
+    };
+
+    template <int I>
+    struct mixed: std::exception, mixin<I>, mixin<(I + 5) % type_count>, mixin<(I + 10) % type_count>
+    {
+    };
+
+    // The thrown exception matches only the last listed type (flat, mixin),
+    // or all of them (deep).
+    template <template <int> class T>
+    struct hierarchy;
+
+    template <>
+    struct hierarchy<flat>
+    {
+        static char const * name() noexcept { return "flat"; }
+        using thrown = flat<type_count - 1>;
+    };
+
+    template <>
+    struct hierarchy<deep>
+    {
+        static char const * name() noexcept { return "deep"; }
+        using thrown = deep<type_count - 1>;
+    };
+
+    template <>
+    struct hierarchy<mixin>
+    {
+        static char const * name() noexcept { return "mixin"; }
+        using thrown = mixed<type_count - 1>;
+    };
+
+    template <template <int> class T>
+    BOOST_LEAF_BENCHMARK_NOINLINE int f( int i )
+    {
+        if( i >= 0 )
+            throw typename hierarchy<T>::thrown();
+        return i;
+    }
+
+    template <template <int> class T, std::size_t... I>
+    long long exception_to_result( int i, std::index_sequence<I...> )
+    {
+        return leaf::try_handle_all(
+            [=]
+            {
+                return leaf::exception_to_result<T<int(I)>...>(
+                    [=]
+                    {
+                        return f<T>(i);
+                    } );
+            },
+            []( leaf::error_info const & ei )
+            {
+                return (long long) ei.error().value();
+            } );
+    }
+
+    template <template <int> class T, std::size_t... I>
+    long long try_catch( int i, std::index_sequence<I...> )
+    {
+        return leaf::try_catch(
+            [=]
+            {
+                return (long long) f<T>(i);
+            },
+            []( leaf::catch_<T<int(I)>> ) -> long long
+            {
+                return I;
+            }...,
+            []
+            {
+                return -1ll;
+            } );
+    }
+
+    template <template <int> class T>
+    void run( benchmark::report & rep, int iterations )
+    {
+        double ns_to_result = benchmark::measure_ns(iterations,
+            []( int i )
+            {
+                return exception_to_result<T>(i, std::make_index_sequence<type_count>());
+            } );
+        double ns_try_catch = benchmark::measure_ns(iterations,
+            []( int i )
+            {
+                return try_catch<T>(i, std::make_index_sequence<type_count>());
+            } );
+        for( int k = 0; k != 2; ++k )
+        {
+            benchmark::row r(rep);
+            r   ("hierarchy", hierarchy<T>::name())
+                ("dispatch", k == 0 ? "exception_to_result" : "try_catch")
+                ("types", type_count)
+                ("dynamic_cast_cache", BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE)
+                ("iterations", iterations)
+                ("ns_per_call", k == 0 ? ns_to_result : ns_try_catch);
+        }
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 200000;
+
+    benchmark::report rep("exception_dispatch");
+    run<flat>(rep, iterations);
+    run<deep>(rep, iterations);
+    run<mixin>(rep, iterations);
+    return 0;
+}
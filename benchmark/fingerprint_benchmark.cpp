@@ -0,0 +1,87 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the per-occurrence cost of an error handler in an error storm,
+// where the same error is reported over and over. Compares:
+//
+// - print_to:    formatting diagnostic_details into a fixed char buffer, as
+//                when logging each occurrence;
+// - fingerprint: computing the fingerprint of diagnostic_details;
+// - aggregate:   error_aggregator::record, which computes the fingerprint
+//                and counts the occurrence (the exemplar is formatted only
+//                once).
+
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/fingerprint.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <string>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    struct e_file_name { std::string value; };
+    struct e_line { int value; };
+    struct e_ratio { double value; };
+    enum class e_kind { read = 1, write = 2 };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<void> fail()
+    {
+        auto load = leaf::on_error(e_kind::write);
+        return BOOST_LEAF_NEW_ERROR(e_file_name{"/var/log/leaf/benchmark.log"}, e_line{42}, e_ratio{0.75});
+    }
+
+    void write_row( benchmark::report & rep, char const * method, int iterations, double ns )
+    {
+        benchmark::row r(rep);
+        r   ("method", method)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 1000000;
+
+    benchmark::report rep("fingerprint");
+    leaf::try_handle_all(
+        []
+        {
+            return fail();
+        },
+        [&]( leaf::diagnostic_details const & dd )
+        {
+            write_row(rep, "print_to", iterations, benchmark::measure_ns(iterations,
+                [&]( int ) -> long long
+                {
+                    char buf[1024];
+                    return (long long) print_to(buf, sizeof(buf), dd);
+                } ));
+
+            write_row(rep, "fingerprint", iterations, benchmark::measure_ns(iterations,
+                [&]( int ) -> long long
+                {
+                    return (long long) leaf::fingerprint(dd);
+                } ));
+
+            write_row(rep, "fingerprint<e_line>", iterations, benchmark::measure_ns(iterations,
+                [&]( int ) -> long long
+                {
+                    return (long long) leaf::fingerprint<e_line>(dd);
+                } ));
+
+            leaf::error_aggregator agg;
+            write_row(rep, "aggregate", iterations, benchmark::measure_ns(iterations,
+                [&]( int ) -> long long
+                {
+                    return agg.record(dd);
+                } ));
+        } );
+    return 0;
+}
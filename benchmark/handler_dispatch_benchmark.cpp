@@ -0,0 +1,97 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of handler selection in leaf::try_handle_all as the
+// number of handlers grows from 1 to 64. All handlers share e_common and one
+// of a few e_kind types, and each takes its own e_tag type, so that most of
+// the slot probes made during handler selection are for the same few slots.
+// The error is matched by the last handler, which is the worst case.
+
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <utility>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    struct e_common
+    {
+        int value;
+    };
+
+    template <int K>
+    struct e_kind
+    {
+        int value;
+    };
+
+    template <int I>
+    struct e_tag
+    {
+        int value;
+    };
+
+    template <int I>
+    struct handler
+    {
+        int operator()( e_common const & c, e_kind<I % 4> const &, e_tag<I> const & ) const
+        {
+            return c.value + I;
+        }
+    };
+
+    template <int Handlers>
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> fail( int i )
+    {
+        return leaf::new_error(e_common{i}, e_kind<(Handlers - 1) % 4>{i}, e_tag<Handlers - 1>{i});
+    }
+
+    template <int Handlers, std::size_t... I>
+    long long handle( int i, std::index_sequence<I...> )
+    {
+        return leaf::try_handle_all(
+            [=]
+            {
+                return fail<Handlers>(i);
+            },
+            handler<int(I)>{ }...,
+            []
+            {
+                return -1;
+            } );
+    }
+
+    template <int Handlers>
+    void run( benchmark::report & rep, int iterations )
+    {
+        double ns = benchmark::measure_ns(iterations,
+            []( int i )
+            {
+                return handle<Handlers>(i, std::make_index_sequence<Handlers>());
+            } );
+        benchmark::row r(rep);
+        r   ("handlers", Handlers)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 10000 : 1000000;
+
+    benchmark::report rep("handler_dispatch");
+    run<1>(rep, iterations);
+    run<2>(rep, iterations);
+    run<4>(rep, iterations);
+    run<8>(rep, iterations);
+    run<16>(rep, iterations);
+    run<32>(rep, iterations);
+    run<64>(rep, iterations);
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of serializing diagnostic_details to JSON text. Compares:
+//
+// - json_buffer:    json_encoder writing into a char buffer;
+// - json_file:      json_encoder writing to a FILE* opened on the null device;
+// - nlohmann_json:  nlohmann_json_encoder building a nlohmann::json, followed
+//                   by dump() (only if BOOST_LEAF_BENCHMARK_NLOHMANN_JSON is
+//                   defined);
+// - boost_json:     boost_json_encoder building a boost::json::value,
+//                   followed by boost::json::serialize (only if
+//                   BOOST_LEAF_BENCHMARK_BOOST_JSON is defined, see
+//                   meson.build).
+
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/common.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/serialization/json_encoder.hpp>
+
+#ifdef BOOST_LEAF_BENCHMARK_NLOHMANN_JSON
+#   include "nlohmann/json.hpp"
+#   include <boost/leaf/serialization/nlohmann_json_encoder.hpp>
+#endif
+#ifdef BOOST_LEAF_BENCHMARK_BOOST_JSON
+#   include <boost/json.hpp>
+#   include <boost/json/src.hpp>
+#   include <boost/leaf/serialization/boost_json_encoder.hpp>
+#endif
+
+#include "benchmark.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace leaf = boost::leaf;
+
+#ifdef BOOST_LEAF_BENCHMARK_NLOHMANN_JSON
+using nlohmann_encoder = leaf::serialization::nlohmann_json_encoder<nlohmann::json>;
+#endif
+
+namespace boost { namespace leaf {
+
+namespace serialization {
+
+template <class Handle, class T>
+void serialize( Handle & h, T const & x, char const * name )
+{
+    h.dispatch(
+#ifdef BOOST_LEAF_BENCHMARK_NLOHMANN_JSON
+        [&]( ::nlohmann_encoder & e ) { output_at(e, x, name); },
+#endif
+#ifdef BOOST_LEAF_BENCHMARK_BOOST_JSON
+        [&]( boost_json_encoder & e ) { output_at(e, x, name); },
+#endif
+        [&]( json_encoder & e ) { output_at(e, x, name); } );
+}
+
+}
+
+} }
+
+namespace
+{
+    struct e_request
+    {
+        int status;
+        std::string url;
+
+        template <class Encoder>
+        friend void output( Encoder & e, e_request const & x )
+        {
+            output_at(e, x.status, "status");
+            output_at(e, x.url, "url");
+        }
+    };
+
+    struct e_retry_count { int value; };
+    struct e_elapsed_ms { double value; };
+    struct e_offsets { std::vector<int> value; };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<void> fail()
+    {
+        auto load = leaf::on_error(e_retry_count{3}, e_elapsed_ms{12.5});
+        return BOOST_LEAF_NEW_ERROR(
+            e_request{503, "https://example.com/api/v1/items?id=42"},
+            leaf::e_api_function{"fetch_items"},
+            leaf::e_file_name{"/var/cache/items.json"},
+            e_offsets{{0, 512, 1024, 4096}} );
+    }
+
+    void write_row( benchmark::report & rep, char const * encoder, long long bytes, int iterations, double ns )
+    {
+        benchmark::row r(rep);
+        r   ("encoder", encoder)
+            ("bytes", bytes)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+
+    template <class F>
+    void run( benchmark::report & rep, char const * encoder, int iterations, F f )
+    {
+        double ns = benchmark::measure_ns(iterations, f);
+        write_row(rep, encoder, f(0), iterations, ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 200000;
+
+#ifdef _WIN32
+    std::FILE * null_device = std::fopen("NUL", "w");
+#else
+    std::FILE * null_device = std::fopen("/dev/null", "w");
+#endif
+
+    benchmark::report rep("json_encoder");
+    leaf::try_handle_all(
+        []
+        {
+            return fail();
+        },
+        [&]( leaf::diagnostic_details const & dd )
+        {
+            run(rep, "json_buffer", iterations,
+                [&]( int ) -> long long
+                {
+                    char buf[2048];
+                    leaf::serialization::json_encoder e(buf, sizeof(buf));
+                    dd.serialize_to(e);
+                    return (long long) e.finish();
+                } );
+
+            if( null_device )
+                run(rep, "json_file", iterations,
+                    [&]( int ) -> long long
+                    {
+                        leaf::serialization::json_encoder e(null_device);
+                        dd.serialize_to(e);
+                        return (long long) e.finish();
+                    } );
+
+#ifdef BOOST_LEAF_BENCHMARK_NLOHMANN_JSON
+            run(rep, "nlohmann_json", iterations,
+                [&]( int ) -> long long
+                {
+                    nlohmann::json j;
+                    nlohmann_encoder e{j};
+                    dd.serialize_to(e);
+                    return (long long) j.dump().size();
+                } );
+#endif
+
+#ifdef BOOST_LEAF_BENCHMARK_BOOST_JSON
+            run(rep, "boost_json", iterations,
+                [&]( int ) -> long long
+                {
+                    boost::json::value v;
+                    leaf::serialization::boost_json_encoder e{v};
+                    dd.serialize_to(e);
+                    return (long long) boost::json::serialize(v).size();
+                } );
+#endif
+        } );
+
+    if( null_device )
+        std::fclose(null_device);
+    return 0;
+}
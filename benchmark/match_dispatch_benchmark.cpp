@@ -0,0 +1,120 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of handler selection in leaf::try_handle_all for a run of
+// 1 to 64 handlers, each taking a leaf::match<err_code, V...> with 1 or 4
+// values. A run of handlers which take a single match<> argument is
+// dispatched through a sorted table of values; for comparison, the "linear"
+// rows use the same handlers with an extra leaf::error_info argument, which
+// disables the table, so that each match<> is evaluated in turn. The error is
+// matched by the last handler, which is the worst case for linear dispatch.
+
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include <boost/leaf/pred.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <utility>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    enum class err_code
+    {
+    };
+
+    template <int Values, int I, int... V>
+    struct match_type
+    {
+        using type = typename match_type<Values - 1, I, I * 4 + Values - 1, V...>::type;
+    };
+
+    template <int I, int... V>
+    struct match_type<0, I, V...>
+    {
+        using type = leaf::match<err_code, err_code(V)...>;
+    };
+
+    template <int Values, int I>
+    struct handler_table
+    {
+        int operator()( typename match_type<Values, I>::type ) const
+        {
+            return I;
+        }
+    };
+
+    template <int Values, int I>
+    struct handler_linear
+    {
+        int operator()( typename match_type<Values, I>::type, leaf::error_info const & ) const
+        {
+            return I;
+        }
+    };
+
+    template <int Handlers, int Values>
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> fail( int )
+    {
+        return leaf::new_error(err_code((Handlers - 1) * 4 + Values - 1));
+    }
+
+    template <int Handlers, int Values, template <int, int> class Handler, std::size_t... I>
+    long long handle( int i, std::index_sequence<I...> )
+    {
+        return leaf::try_handle_all(
+            [=]
+            {
+                return fail<Handlers, Values>(i);
+            },
+            Handler<Values, int(I)>{ }...,
+            []
+            {
+                return -1;
+            } );
+    }
+
+    template <int Handlers, int Values, template <int, int> class Handler>
+    void run( benchmark::report & rep, char const * dispatch, int iterations )
+    {
+        double ns = benchmark::measure_ns(iterations,
+            []( int i )
+            {
+                return handle<Handlers, Values, Handler>(i, std::make_index_sequence<Handlers>());
+            } );
+        benchmark::row r(rep);
+        r   ("dispatch", dispatch)
+            ("handlers", Handlers)
+            ("values_per_handler", Values)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+
+    template <int Handlers, int Values>
+    void run( benchmark::report & rep, int iterations )
+    {
+        run<Handlers, Values, handler_table>(rep, "table", iterations);
+        run<Handlers, Values, handler_linear>(rep, "linear", iterations);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 10000 : 1000000;
+
+    benchmark::report rep("match_dispatch");
+    run<2, 1>(rep, iterations);
+    run<4, 1>(rep, iterations);
+    run<8, 1>(rep, iterations);
+    run<16, 1>(rep, iterations);
+    run<32, 1>(rep, iterations);
+    run<64, 1>(rep, iterations);
+    run<2, 4>(rep, iterations);
+    run<8, 4>(rep, iterations);
+    run<32, 4>(rep, iterations);
+    run<64, 4>(rep, iterations);
+    return 0;
+}
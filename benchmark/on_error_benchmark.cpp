@@ -0,0 +1,79 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of leaf::on_error on the success path: a chain of 10
+// calls that can't be inlined, each with an on_error scope, which never
+// fails. Compared to the same chain without on_error. Build this program
+// with BOOST_LEAF_CFG_MONITOR_EXCEPTIONS=0 and 1 to compare the two: under
+// BOOST_LEAF_CFG_MONITOR_EXCEPTIONS=0, on_error doesn't call
+// std::uncaught_exceptions.
+
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int const depth = 10;
+
+    struct e_depth
+    {
+        int value;
+    };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> f_plain( int depth, int i )
+    {
+        if( depth == 0 )
+            return i;
+        BOOST_LEAF_AUTO(r, f_plain(depth - 1, i));
+        return r + 1;
+    }
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> f_on_error( int depth, int i )
+    {
+        if( depth == 0 )
+            return i;
+        auto load = leaf::on_error(e_depth{depth});
+        BOOST_LEAF_AUTO(r, f_on_error(depth - 1, i));
+        return r + 1;
+    }
+
+    template <class F>
+    void run( benchmark::report & rep, char const * scope, int iterations, F && f )
+    {
+        double ns = benchmark::measure_ns(iterations, f);
+        benchmark::row r(rep);
+        r   ("scope", scope)
+            ("monitor_exceptions", BOOST_LEAF_CFG_MONITOR_EXCEPTIONS)
+            ("depth", depth)
+            ("error_rate", 0)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 100000 : 5000000;
+
+    benchmark::report rep("on_error");
+
+    run(rep, "none", iterations,
+        []( int i ) -> long long
+        {
+            return f_plain(depth, i).value();
+        } );
+
+    run(rep, "on_error", iterations,
+        []( int i ) -> long long
+        {
+            return f_on_error(depth, i).value();
+        } );
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Reports sizeof(result<T>) and measures the cost of filling and scanning a
+// std::vector of result<T> objects, for pointer and enum types T that opt
+// into is_result_niche, compared to the same types that don't. Build this
+// program with BOOST_LEAF_CFG_CAPTURE=0, otherwise is_result_niche has no
+// effect.
+
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <vector>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    struct node_niche
+    {
+        int value;
+    };
+
+    struct node_plain
+    {
+        int value;
+    };
+
+    enum class kind_niche: unsigned
+    {
+        a,
+        b,
+        c,
+        d
+    };
+
+    enum class kind_plain: unsigned
+    {
+        a,
+        b,
+        c,
+        d
+    };
+
+    template <class T>
+    struct make
+    {
+        static T value( int i ) noexcept
+        {
+            return T(i & 3);
+        }
+
+        static long long as_number( T x ) noexcept
+        {
+            return (long long) x;
+        }
+    };
+
+    template <class T>
+    struct make<T *>
+    {
+        static T nodes[64];
+
+        static T * value( int i ) noexcept
+        {
+            return &nodes[i & 63];
+        }
+
+        static long long as_number( T * x ) noexcept
+        {
+            return x->value;
+        }
+    };
+
+    template <class T>
+    T make<T *>::nodes[64];
+}
+
+namespace boost { namespace leaf {
+
+template <> struct is_result_niche<node_niche *>: std::true_type { };
+template <> struct is_result_niche<kind_niche>: std::true_type { };
+
+} }
+
+namespace
+{
+    template <class T>
+    void run( benchmark::report & rep, char const * type, bool niche, int elements, int iterations )
+    {
+        std::vector<leaf::result<T>> v;
+        v.reserve(elements);
+
+        // One error every 64 elements.
+        double fill_ns = benchmark::measure_ns(iterations,
+            [&]( int ) -> long long
+            {
+                v.clear();
+                for( int i = 0; i != elements; ++i )
+                    if( i & 63 )
+                        v.push_back(make<T>::value(i));
+                    else
+                        v.push_back(leaf::new_error());
+                return (long long) v.size();
+            } );
+
+        double scan_ns = benchmark::measure_ns(iterations,
+            [&]( int ) -> long long
+            {
+                long long s = 0;
+                for( auto const & r : v )
+                    if( r )
+                        s += make<T>::as_number(*r);
+                    else
+                        --s;
+                return s;
+            } );
+
+        benchmark::row r(rep);
+        r   ("type", type)
+            ("niche", niche)
+            ("error_id_bits", BOOST_LEAF_CFG_ERROR_ID_BITS)
+            ("sizeof_T", int(sizeof(T)))
+            ("sizeof_result", int(sizeof(leaf::result<T>)))
+            ("elements", elements)
+            ("bytes", (long long) elements * (long long) sizeof(leaf::result<T>))
+            ("iterations", iterations)
+            ("fill_ns_per_element", fill_ns / elements)
+            ("scan_ns_per_element", scan_ns / elements);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const elements = 1 << 20;
+    int const iterations = quick ? 2 : 20;
+
+    for( int i = 0; i != 64; ++i )
+    {
+        make<node_niche *>::nodes[i].value = i;
+        make<node_plain *>::nodes[i].value = i;
+    }
+
+    benchmark::report rep("result_niche");
+    run<node_niche *>(rep, "node *", true, elements, iterations);
+    run<node_plain *>(rep, "node *", false, elements, iterations);
+    run<kind_niche>(rep, "enum class: unsigned", true, elements, iterations);
+    run<kind_plain>(rep, "enum class: unsigned", false, elements, iterations);
+    return 0;
+}
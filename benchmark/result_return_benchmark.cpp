@@ -0,0 +1,136 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of returning result<int> through a chain of calls that
+// can't be inlined, compared to returning a plain int error code and (if
+// available) std::expected<int, int>. Build this program with
+// BOOST_LEAF_CFG_CAPTURE=0 and 1 to compare the two: under
+// BOOST_LEAF_CFG_CAPTURE=0, result<int> is trivially copyable, so it is
+// returned in registers rather than through a hidden pointer.
+
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <type_traits>
+
+#if defined(__has_include)
+#   if __has_include(<expected>)
+#       include <expected>
+#   endif
+#endif
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int const depth = 10;
+
+    struct e_code
+    {
+        int value;
+    };
+
+    // Plain int error codes, the value is returned through an out parameter.
+    BOOST_LEAF_BENCHMARK_NOINLINE int f_code( int depth, int i, int & out )
+    {
+        if( depth == 0 )
+        {
+            if( (i & 1023) == 0 )
+                return i | 1;
+            out = i;
+            return 0;
+        }
+        if( int ec = f_code(depth - 1, i, out) )
+            return ec;
+        ++out;
+        return 0;
+    }
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> f_result( int depth, int i )
+    {
+        if( depth == 0 )
+        {
+            if( (i & 1023) == 0 )
+                return leaf::new_error(e_code{i | 1});
+            return i;
+        }
+        BOOST_LEAF_AUTO(r, f_result(depth - 1, i));
+        return r + 1;
+    }
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+    BOOST_LEAF_BENCHMARK_NOINLINE std::expected<int, int> f_expected( int depth, int i )
+    {
+        if( depth == 0 )
+        {
+            if( (i & 1023) == 0 )
+                return std::unexpected(i | 1);
+            return i;
+        }
+        auto r = f_expected(depth - 1, i);
+        if( !r )
+            return r;
+        return *r + 1;
+    }
+#endif
+
+    template <class F>
+    void run( benchmark::report & rep, char const * type, bool trivially_copyable, int iterations, F && f )
+    {
+        double ns = benchmark::measure_ns(iterations, f);
+        benchmark::row r(rep);
+        r   ("type", type)
+            ("trivially_copyable", trivially_copyable)
+            ("depth", depth)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 100000 : 5000000;
+
+    benchmark::report rep("result_return");
+
+    run(rep, "int", true, iterations,
+        []( int i ) -> long long
+        {
+            int out;
+            if( int ec = f_code(depth, i, out) )
+                return -ec;
+            return out;
+        } );
+
+    run(rep, "leaf::result<int>", std::is_trivially_copyable<leaf::result<int>>::value, iterations,
+        []( int i ) -> long long
+        {
+            return leaf::try_handle_all(
+                [=]
+                {
+                    return f_result(depth, i);
+                },
+                []( e_code const & e )
+                {
+                    return -e.value;
+                },
+                []
+                {
+                    return -1;
+                } );
+        } );
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+    run(rep, "std::expected<int, int>", std::is_trivially_copyable<std::expected<int, int>>::value, iterations,
+        []( int i ) -> long long
+        {
+            auto r = f_expected(depth, i);
+            return r ? *r : -r.error();
+        } );
+#endif
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Reports sizeof(result<T>) for a range of types T, and measures the cost of
+// returning result<T> through a chain of calls. Build this program with
+// BOOST_LEAF_CFG_ERROR_ID_BITS=32 and 64 to compare the two: when T is
+// pointer-sized or larger, the wider error ids do not increase the size of
+// result<T> on 64-bit platforms.
+
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+#include <string>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    struct e_code
+    {
+        int value;
+    };
+
+    template <class T>
+    struct make
+    {
+        static T value( int i ) { return T(i); }
+    };
+
+    template <class T>
+    struct make<T *>
+    {
+        static T * value( int i ) { static T x[2]; return &x[i & 1]; }
+    };
+
+    template <>
+    struct make<std::string>
+    {
+        static std::string value( int i ) { return std::string(1, char('a' + (i & 15))); }
+    };
+
+    template <class T>
+    long long as_number( T const & x ) { return (long long) x; }
+
+    template <class T>
+    long long as_number( T * x ) { return (long long) (x != nullptr); }
+
+    inline long long as_number( std::string const & x ) { return (long long) x.size(); }
+
+    template <class T>
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<T> f( int depth, int i )
+    {
+        if( depth == 0 )
+        {
+            if( (i & 1023) == 0 )
+                return leaf::new_error(e_code{i});
+            return make<T>::value(i);
+        }
+        BOOST_LEAF_AUTO(r, f<T>(depth - 1, i));
+        return r;
+    }
+
+    template <class T>
+    void run( benchmark::report & rep, char const * type, int iterations )
+    {
+        int const depth = 10;
+        double ns = benchmark::measure_ns(iterations,
+            [=]( int i )
+            {
+                return leaf::try_handle_all(
+                    [=]() -> leaf::result<long long>
+                    {
+                        BOOST_LEAF_AUTO(r, f<T>(depth, i));
+                        return as_number(r);
+                    },
+                    []( e_code const & e ) -> long long
+                    {
+                        return -e.value;
+                    },
+                    []() -> long long
+                    {
+                        return -1;
+                    } );
+            } );
+        benchmark::row r(rep);
+        r   ("type", type)
+            ("error_id_bits", BOOST_LEAF_CFG_ERROR_ID_BITS)
+            ("sizeof_T", int(sizeof(T)))
+            ("sizeof_result", int(sizeof(leaf::result<T>)))
+            ("depth", depth)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 100000 : 2000000;
+
+    benchmark::report rep("result_size");
+    run<char>(rep, "char", iterations);
+    run<int>(rep, "int", iterations);
+    run<long long>(rep, "long long", iterations);
+    run<int *>(rep, "int *", iterations);
+    run<double>(rep, "double", iterations);
+    run<std::string>(rep, "std::string", iterations);
+    return 0;
+}
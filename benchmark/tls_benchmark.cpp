@@ -0,0 +1,15 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Runs the TLS benchmark implemented in the (dynamically linked) module built
+// from tls_module.cpp. Build the module with different TLS configurations to
+// compare them, e.g. the default C++11 thread_local backend and the
+// contiguous per-thread block enabled by BOOST_LEAF_USE_TLS_BLOCK.
+
+#include "tls_module.hpp"
+
+int main( int argc, char const * argv[] )
+{
+    return leaf_tls_benchmark("tls", argc, argv);
+}
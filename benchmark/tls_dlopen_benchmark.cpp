@@ -0,0 +1,41 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Loads each of the modules specified on the command line with dlopen, and
+// runs the TLS benchmark implemented in tls_module.cpp. This is how plugins
+// are typically loaded, and (unlike linking the module to the executable) it
+// prevents the linker from relaxing the TLS accesses in the module. Build the
+// modules with different values of BOOST_LEAF_CFG_TLS_MODEL to compare them.
+//
+// Usage: tls_dlopen_benchmark [--quick] module...
+
+#include "tls_module.hpp"
+#include <dlfcn.h>
+#include <cstdio>
+#include <cstring>
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    char const * module_argv[ ] = { argv[0], quick ? "--quick" : "" };
+    for( int i = quick ? 2 : 1; i < argc; ++i )
+    {
+        void * module = dlopen(argv[i], RTLD_NOW | RTLD_LOCAL);
+        if( !module )
+        {
+            std::fprintf(stderr, "%s\n", dlerror());
+            return 1;
+        }
+        auto f = reinterpret_cast<decltype(&leaf_tls_benchmark)>(dlsym(module, "leaf_tls_benchmark"));
+        if( !f )
+        {
+            std::fprintf(stderr, "%s\n", dlerror());
+            return 1;
+        }
+        if( int r = f("tls_dlopen", 2, module_argv) )
+            return r;
+        dlclose(module);
+    }
+    return 0;
+}
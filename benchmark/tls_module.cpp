@@ -0,0 +1,142 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// TLS access benchmark. This file is built as a shared library (module), since
+// in position-independent code the cost of accessing thread_local variables
+// depends on the TLS backend and on the TLS model (see BOOST_LEAF_CFG_TLS_MODEL
+// in tls_cpp11.hpp). It measures, for contexts with 1, 8 and 32 e-types:
+//
+// - activate:      context::activate() + context::deactivate() around a call
+//                  that succeeds;
+// - handle_ok:     try_handle_all where the try block succeeds;
+// - handle_error:  try_handle_all where the try block fails, loading a single
+//                  e-type.
+//
+// See tls_benchmark.cpp and tls_dlopen_benchmark.cpp.
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/context.hpp>
+#include <boost/leaf/handle_errors.hpp>
+#include <boost/leaf/result.hpp>
+#include "benchmark.hpp"
+#define BOOST_LEAF_BENCHMARK_BUILDING_TLS_MODULE
+#include "tls_module.hpp"
+#include <cstring>
+#include <utility>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    template <int I>
+    struct e_type
+    {
+        int value;
+    };
+
+    template <int... I>
+    struct int_sequence
+    {
+    };
+
+    template <int N, int... I>
+    struct make_int_sequence: make_int_sequence<N - 1, N - 1, I...>
+    {
+    };
+
+    template <int... I>
+    struct make_int_sequence<0, I...>
+    {
+        using type = int_sequence<I...>;
+    };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<int> work( int i, bool fail )
+    {
+        if( fail )
+            return leaf::new_error(e_type<0>{i});
+        return i;
+    }
+
+    template <int... I>
+    int activate( int_sequence<I...>, int i )
+    {
+        leaf::context<e_type<I>...> ctx;
+        ctx.activate();
+        leaf::result<int> r = work(i, false);
+        ctx.deactivate();
+        return r ? *r : 0;
+    }
+
+    template <int... I>
+    int handle( int_sequence<I...>, int i, bool fail )
+    {
+        return leaf::try_handle_all(
+            [=]
+            {
+                return work(i, fail);
+            },
+            []( e_type<I> const & ... e )
+            {
+                int const v[ ] = { e.value... };
+                return -v[0];
+            },
+            []( e_type<0> const & e )
+            {
+                return -e.value;
+            },
+            []
+            {
+                return -1;
+            } );
+    }
+
+    template <int N>
+    void run( benchmark::report & rep, char const * backend, char const * model, int iterations )
+    {
+        using seq = typename make_int_sequence<N>::type;
+        double ns_activate = benchmark::measure_ns(iterations, [=]( int i ) { return activate(seq(), i); });
+        double ns_ok = benchmark::measure_ns(iterations, [=]( int i ) { return handle(seq(), i, false); });
+        double ns_error = benchmark::measure_ns(iterations, [=]( int i ) { return handle(seq(), i, true); });
+        benchmark::row r(rep);
+        r   ("tls_backend", backend)
+            ("tls_model", model)
+            ("e_types", N)
+            ("iterations", iterations)
+            ("activate_ns", ns_activate)
+            ("handle_ok_ns", ns_ok)
+            ("handle_error_ns", ns_error);
+    }
+}
+
+BOOST_LEAF_TLS_MODULE_API int leaf_tls_benchmark( char const * name, int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 100000 : 2000000;
+#if defined(BOOST_LEAF_USE_TLS_BLOCK)
+    char const * backend = "tls_block";
+#elif defined(BOOST_LEAF_USE_TLS_AGENT)
+    char const * backend = "tls_agent";
+#elif defined(BOOST_LEAF_USE_TLS_ARRAY)
+    char const * backend = "tls_array";
+#elif BOOST_LEAF_CFG_WIN32 == 2
+    char const * backend = "tls_win32";
+#elif defined(BOOST_LEAF_NO_THREADS)
+    char const * backend = "tls_globals";
+#else
+    char const * backend = "tls_cpp11";
+#endif
+#if !defined(BOOST_LEAF_CFG_TLS_MODEL) || BOOST_LEAF_CFG_TLS_MODEL == 0
+    char const * model = "default";
+#elif BOOST_LEAF_CFG_TLS_MODEL == 1
+    char const * model = "initial-exec";
+#else
+    char const * model = "local-dynamic";
+#endif
+
+    benchmark::report rep(name);
+    run<1>(rep, backend, model, iterations);
+    run<8>(rep, backend, model, iterations);
+    run<32>(rep, backend, model, iterations);
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef BOOST_LEAF_BENCHMARK_TLS_MODULE_HPP_INCLUDED
+#define BOOST_LEAF_BENCHMARK_TLS_MODULE_HPP_INCLUDED
+
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef _WIN32
+#   ifdef BOOST_LEAF_BENCHMARK_BUILDING_TLS_MODULE
+#       define BOOST_LEAF_TLS_MODULE_API extern "C" __declspec(dllexport)
+#   else
+#       define BOOST_LEAF_TLS_MODULE_API extern "C" __declspec(dllimport)
+#   endif
+#else
+#   define BOOST_LEAF_TLS_MODULE_API extern "C" [[gnu::visibility("default")]]
+#endif
+
+// Runs the TLS benchmark defined in tls_module.cpp, writing the results to
+// stdout, labeled with the specified benchmark name.
+BOOST_LEAF_TLS_MODULE_API int leaf_tls_benchmark( char const * name, int argc, char const * argv[] );
+
+#endif // #ifndef BOOST_LEAF_BENCHMARK_TLS_MODULE_HPP_INCLUDED
@@ -0,0 +1,100 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the per error object overhead of serializing diagnostic_details:
+// computing type names, hashing them, and dispatching to the encoder. The
+// null encoder does no work of its own, so the results are dominated by this
+// overhead; the cbor encoder shows its effect on a real encoder.
+//
+// Build with -DBOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME=0 to compare with type
+// names computed at run time (see meson.build).
+
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/result.hpp>
+#include <boost/leaf/serialization/cbor_encoder.hpp>
+#include "benchmark.hpp"
+#include <cstring>
+
+namespace leaf = boost::leaf;
+
+struct null_encoder
+{
+    int members;
+
+    template <class T>
+    friend void output_at( null_encoder & e, T const &, char const * name )
+    {
+        e.members += name[0] != 0;
+    }
+};
+
+namespace boost { namespace leaf {
+
+namespace serialization {
+
+template <class Handle, class T>
+void serialize( Handle & h, T const & x, char const * name )
+{
+    h.dispatch(
+        [&]( ::null_encoder & e ) { output_at(e, x, name); },
+        [&]( cbor_encoder & e ) { output_at(e, x, name); } );
+}
+
+}
+
+} }
+
+namespace
+{
+    template <int> struct e_info { int value; };
+
+    BOOST_LEAF_BENCHMARK_NOINLINE leaf::result<void> fail()
+    {
+        auto load = leaf::on_error(e_info<5>{5}, e_info<6>{6}, e_info<7>{7}, e_info<8>{8});
+        return BOOST_LEAF_NEW_ERROR(e_info<1>{1}, e_info<2>{2}, e_info<3>{3}, e_info<4>{4});
+    }
+
+    void write_row( benchmark::report & rep, char const * encoder, int iterations, double ns )
+    {
+        benchmark::row r(rep);
+        r   ("type_name", BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME ? "constexpr" : "runtime")
+            ("encoder", encoder)
+            ("iterations", iterations)
+            ("ns_per_call", ns);
+    }
+}
+
+int main( int argc, char const * argv[] )
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "--quick") == 0;
+    int const iterations = quick ? 2000 : 500000;
+
+    benchmark::report rep("type_name");
+    leaf::try_handle_all(
+        []
+        {
+            return fail();
+        },
+        [&]( leaf::diagnostic_details const & dd )
+        {
+            write_row(rep, "null", iterations, benchmark::measure_ns(iterations,
+                [&]( int ) -> long long
+                {
+                    null_encoder e{0};
+                    dd.serialize_to(e);
+                    return e.members;
+                } ) );
+
+            write_row(rep, "cbor", iterations, benchmark::measure_ns(iterations,
+                [&]( int ) -> long long
+                {
+                    unsigned char buf[1024];
+                    leaf::serialization::cbor_encoder e(buf, sizeof(buf));
+                    dd.serialize_to(e);
+                    return (long long) e.finish();
+                } ) );
+        } );
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Converts error records written by leaf::serialization::cbor_encoder to JSON
+// text, so that binary error telemetry can be read by humans.
+//
+// Usage: cbor_to_json [-n names.txt]... [file.cbor]
+//
+// The CBOR is read from the named file or from stdin, and the JSON is written
+// to stdout. cbor_encoder replaces type and member names with numeric ids;
+// the names of the types and members LEAF itself serializes are known, the
+// names of user-defined error types and their members can be supplied in one
+// or more text files, one name per line (e.g. "my_app::e_request" or
+// "status"). Ids with no known name are written as "#" followed by the id in
+// hex.
+
+#include <boost/leaf.hpp>
+#include <boost/leaf/serialization/cbor_decoder.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace leaf = boost::leaf;
+
+enum error_code
+{
+    bad_command_line = 1,
+    open_error,
+    read_error,
+    decode_error
+};
+
+leaf::result<void> load_names( leaf::serialization::cbor_names & names, char const * file_name )
+{
+    auto load = leaf::on_error(leaf::e_file_name{file_name});
+    std::ifstream f(file_name);
+    if( !f )
+        return leaf::new_error(open_error);
+    for( std::string name; std::getline(f, name); )
+        if( !name.empty() )
+            names.add(name.c_str());
+    if( f.bad() )
+        return leaf::new_error(read_error);
+    return { };
+}
+
+leaf::result<std::vector<unsigned char>> read_input( char const * file_name )
+{
+    auto load = leaf::on_error(leaf::e_file_name{file_name ? file_name : "<stdin>"});
+    std::ifstream f;
+    if( file_name )
+    {
+        f.open(file_name, std::ios::binary);
+        if( !f )
+            return leaf::new_error(open_error);
+    }
+    std::istream & is = file_name ? f : std::cin;
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    if( is.bad() )
+        return leaf::new_error(read_error);
+    return data;
+}
+
+int main( int argc, char const * argv[] )
+{
+    return leaf::try_handle_all(
+        [&]() -> leaf::result<int>
+        {
+            leaf::serialization::cbor_names names;
+            char const * file_name = nullptr;
+            for( int i = 1; i != argc; ++i )
+            {
+                if( std::string(argv[i]) == "-n" && i + 1 != argc )
+                    BOOST_LEAF_CHECK(load_names(names, argv[++i]));
+                else if( !file_name && argv[i][0] != '-' )
+                    file_name = argv[i];
+                else
+                    return leaf::new_error(bad_command_line);
+            }
+
+            BOOST_LEAF_AUTO(data, read_input(file_name));
+            if( !leaf::serialization::cbor_to_json(data.data(), data.size(), std::cout, names) )
+                return leaf::new_error(decode_error);
+            std::cout << std::endl;
+            return 0;
+        },
+
+        []( leaf::match<error_code, bad_command_line> )
+        {
+            std::cerr << "Usage: cbor_to_json [-n names.txt]... [file.cbor]" << std::endl;
+            return 1;
+        },
+
+        []( leaf::match<error_code, open_error, read_error>, leaf::e_file_name const & fn )
+        {
+            std::cerr << "Failed to read " << fn.value << std::endl;
+            return 2;
+        },
+
+        []( leaf::match<error_code, decode_error> )
+        {
+            std::cout << std::endl;
+            std::cerr << "Malformed or truncated CBOR input" << std::endl;
+            return 3;
+        },
+
+        []( leaf::error_info const & unmatched )
+        {
+            std::cerr << "Unknown failure detected" << std::endl << unmatched;
+            return 4;
+        } );
+}
+
+////////////////////////////////////////
+
+#ifdef BOOST_LEAF_NO_EXCEPTIONS
+
+namespace boost
+{
+    [[noreturn]] void throw_exception( std::exception const & e )
+    {
+        std::cerr << "Terminating due to a C++ exception under BOOST_LEAF_NO_EXCEPTIONS: " << e.what();
+        std::terminate();
+    }
+
+    struct source_location;
+    [[noreturn]] void throw_exception( std::exception const & e, boost::source_location const & )
+    {
+        throw_exception(e);
+    }
+}
+
+#endif
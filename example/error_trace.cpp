@@ -2,19 +2,19 @@
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
-// This program demonstrates the use of leaf::on_error to capture the path an
+// This program demonstrates the use of leaf::e_trace to capture the path an
 // error takes as is bubbles up the call stack. The error path-capturing code
 // only runs if:
 // - An error occurs, and
-// - A handler that takes e_error_trace argument is present. Otherwise none of
+// - A handler that takes an e_trace argument is present. Otherwise none of
 //   the error trace machinery will be invoked by LEAF.
 
 // This example is similar to error_log, except the path the error takes is
-// recorded in a std::deque, rather than just printed in-place.
+// recorded in a fixed-capacity leaf::e_trace, rather than just printed
+// in-place.
 
 #include <boost/leaf.hpp>
 #include <iostream>
-#include <deque>
 #include <cstdlib>
 
 #define ENABLE_ERROR_TRACE 1
@@ -22,39 +22,20 @@
 namespace leaf = boost::leaf;
 
 // The error trace is activated only if an error handling scope provides a
-// handler for e_error_trace.
-struct e_error_trace
-{
-    struct rec
-    {
-        char const * file;
-        int line;
-        friend std::ostream & operator<<( std::ostream & os, rec const & x )
-        {
-            return os << x.file << '(' << x.line << ')' << std::endl;
-        }
-    };
-
-    std::deque<rec> value;
-
-    friend std::ostream & operator<<( std::ostream & os, e_error_trace const & tr )
-    {
-        for( auto & i : tr.value )
-            os << i;
-        return os;
-    }
-};
+// handler for error_trace. It records up to 16 frames; if the error
+// bubbles up through more frames, the oldest ones are dropped.
+using error_trace = leaf::e_trace<16>;
 
 // The ERROR_TRACE macro is designed for use in functions that detect or forward
 // errors up the call stack. If an error occurs, and if an error handling scope
-// provides a handler for e_error_trace, the supplied lambda is executed as the
-// error bubbles up.
-#define ERROR_TRACE auto _trace = leaf::on_error( []( e_error_trace & tr ) { tr.value.emplace_front(e_error_trace::rec{__FILE__, __LINE__}); } )
+// provides a handler for error_trace, the current __FILE__ and __LINE__ are
+// recorded as the error bubbles up.
+#define ERROR_TRACE BOOST_LEAF_TRACE(error_trace)
 
 // Each function in the sequence below calls the previous function, and each
 // function has failure_percent chance of failing. If a failure occurs, the
 // ERROR_TRACE macro will cause the path the error takes to be captured in an
-// e_error_trace.
+// error_trace.
 int const failure_percent = 25;
 
 leaf::result<void> f1()
@@ -114,9 +95,11 @@ int main()
                 return { };
             },
 #if ENABLE_ERROR_TRACE // This single #if enables or disables the capturing of the error trace.
-            []( e_error_trace const & tr )
+            []( error_trace const & tr )
             {
-                std::cerr << "Error! Trace:" << std::endl << tr;
+                std::cerr << "Error! Trace:" << std::endl;
+                for( std::size_t i = 0; i != tr.size(); ++i )
+                    std::cerr << tr[i] << std::endl;
             },
 #endif
             []
@@ -0,0 +1,265 @@
+#ifndef BOOST_LEAF_ASYNC_ERROR_SINK_HPP_INCLUDED
+#define BOOST_LEAF_ASYNC_ERROR_SINK_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/detail/output_sink.hpp>
+
+#ifndef BOOST_LEAF_NO_THREADS
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace boost { namespace leaf {
+
+// Writes diagnostic messages from a background thread. push formats the
+// message into a slot of a bounded ring buffer, with the same allocation-free
+// formatting as print_to; the background thread writes the messages in
+// batches, so error handlers do not block on I/O, and messages from
+// concurrent threads do not interleave. Pushing takes no locks; if the ring
+// buffer is full, the message is dropped and counted.
+class async_error_sink
+{
+    async_error_sink( async_error_sink const & ) = delete;
+    async_error_sink & operator=( async_error_sink const & ) = delete;
+
+    // Each slot is owned by the producers while seq == position, and by the
+    // consumer while seq == position + 1 (bounded MPMC queue by D. Vyukov,
+    // with a single consumer).
+    struct slot
+    {
+        std::atomic<std::size_t> seq;
+        std::size_t size;
+    };
+
+    constexpr static std::size_t batch_size = 64 * 1024;
+
+    static std::size_t round_up_pow2( std::size_t n ) noexcept
+    {
+        std::size_t r = 2;
+        while( r < n )
+            r <<= 1;
+        return r;
+    }
+
+    void (* const write_)( void * state, char const * s, std::size_t n );
+    void * const state_;
+    std::FILE * const file_;
+    std::size_t const mask_;
+    std::size_t const record_size_;
+    std::unique_ptr<slot[]> slots_;
+    std::unique_ptr<char[]> data_;
+    std::unique_ptr<char[]> batch_;
+    std::size_t const batch_capacity_;
+
+    std::atomic<std::size_t> push_pos_;
+    std::atomic<std::uint64_t> dropped_;
+    std::atomic<std::uint64_t> truncated_;
+    std::size_t pop_pos_;
+    std::atomic<std::size_t> written_;
+
+    std::mutex m_;
+    std::condition_variable wake_;
+    std::condition_variable written_cv_;
+    bool stop_;
+    std::thread thread_;
+
+    // Moves the messages which are ready to the batch buffer, and writes it.
+    // Returns false if no message was ready.
+    bool write_batch()
+    {
+        std::size_t const first = pop_pos_;
+        std::size_t n = 0;
+        for( ;; )
+        {
+            slot & s = slots_[pop_pos_ & mask_];
+            if( s.seq.load(std::memory_order_acquire) != pop_pos_ + 1 )
+                break;
+            if( n + s.size + 1 > batch_capacity_ )
+                break;
+            char const * r = &data_[(pop_pos_ & mask_) * record_size_];
+            std::memcpy(&batch_[n], r, s.size);
+            n += s.size;
+            if( s.size && r[s.size - 1] != '\n' )
+                batch_[n++] = '\n';
+            s.seq.store(pop_pos_ + mask_ + 1, std::memory_order_release);
+            ++pop_pos_;
+        }
+        if( pop_pos_ == first )
+            return false;
+        if( n )
+        {
+            write_(state_, batch_.get(), n);
+            if( file_ )
+                (void) std::fflush(file_);
+        }
+        written_.store(pop_pos_, std::memory_order_release);
+        return true;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lk(m_);
+        for( ;; )
+        {
+            lk.unlock();
+            while( write_batch() )
+                ;
+            lk.lock();
+            written_cv_.notify_all();
+            if( stop_ )
+            {
+                lk.unlock();
+                while( write_batch() )
+                    ;
+                return;
+            }
+            (void) wake_.wait_for(lk, std::chrono::milliseconds(10));
+        }
+    }
+
+    async_error_sink( void (*write)( void * state, char const * s, std::size_t n ), void * state, std::FILE * file, std::size_t capacity, std::size_t record_size ):
+        write_(write),
+        state_(state),
+        file_(file),
+        mask_(round_up_pow2(capacity) - 1),
+        record_size_(record_size),
+        slots_(new slot[mask_ + 1]),
+        data_(new char[(mask_ + 1) * record_size]),
+        batch_(new char[record_size + 1 > batch_size ? record_size + 1 : batch_size]),
+        batch_capacity_(record_size + 1 > batch_size ? record_size + 1 : batch_size),
+        push_pos_(0),
+        dropped_(0),
+        truncated_(0),
+        pop_pos_(0),
+        written_(0),
+        stop_(false)
+    {
+        BOOST_LEAF_ASSERT(write != nullptr);
+        BOOST_LEAF_ASSERT(record_size > 1);
+        for( std::size_t i = 0; i <= mask_; ++i )
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        thread_ = std::thread([this] { run(); });
+    }
+
+public:
+
+    // Messages are written with write(state, s, n), from the background
+    // thread. The write function must not throw.
+    async_error_sink( void (*write)( void * state, char const * s, std::size_t n ), void * state, std::size_t capacity = 1024, std::size_t record_size = 1024 ):
+        async_error_sink(write, state, nullptr, capacity, record_size)
+    {
+    }
+
+    // Messages are written to f, which is flushed after each batch.
+    explicit async_error_sink( std::FILE * f, std::size_t capacity = 1024, std::size_t record_size = 1024 ):
+        async_error_sink(&detail::output_sink::write_file, f, f, capacity, record_size)
+    {
+    }
+
+    // Writes all messages pushed so far, then stops the background thread.
+    ~async_error_sink()
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        thread_.join();
+    }
+
+    // Formats x, which may be error_info, diagnostic_info or
+    // diagnostic_details, and queues the message for writing. Messages
+    // longer than record_size - 1 characters are truncated (and counted).
+    // Returns false if the message was dropped because the ring buffer was
+    // full.
+    template <class T>
+    bool push( T const & x )
+    {
+        std::size_t pos = push_pos_.load(std::memory_order_relaxed);
+        for( ;; )
+        {
+            slot & s = slots_[pos & mask_];
+            std::size_t const seq = s.seq.load(std::memory_order_acquire);
+            if( seq == pos )
+            {
+                if( push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) )
+                    break;
+            }
+            else if( seq - pos > mask_ + 1 )
+            {
+                // seq < pos: the consumer has not yet released the slot.
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+                pos = push_pos_.load(std::memory_order_relaxed);
+        }
+        {
+            // The slot is published even if formatting throws (as an empty
+            // message), otherwise the consumer would wait for it forever.
+            struct publish
+            {
+                slot & s;
+                std::size_t pos;
+                ~publish() { s.seq.store(pos + 1, std::memory_order_release); }
+            };
+            slot & s = slots_[pos & mask_];
+            s.size = 0;
+            publish p { s, pos };
+            std::size_t n = print_to(&data_[(pos & mask_) * record_size_], record_size_, x);
+            if( n >= record_size_ )
+            {
+                n = record_size_ - 1;
+                truncated_.fetch_add(1, std::memory_order_relaxed);
+            }
+            s.size = n;
+        }
+        if( ((pos + 1) & (mask_ >> 1)) == 0 )
+            wake_.notify_one();
+        return true;
+    }
+
+    // Blocks until all messages pushed so far are written.
+    void flush()
+    {
+        std::size_t const pos = push_pos_.load(std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lk(m_);
+        while( written_.load(std::memory_order_acquire) < pos )
+        {
+            wake_.notify_one();
+            (void) written_cv_.wait_for(lk, std::chrono::milliseconds(10));
+        }
+    }
+
+    // The number of messages dropped because the ring buffer was full.
+    std::uint64_t dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // The number of messages which were truncated to record_size - 1
+    // characters.
+    std::uint64_t truncated() const noexcept
+    {
+        return truncated_.load(std::memory_order_relaxed);
+    }
+}; // class async_error_sink
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_NO_THREADS
+
+#endif // #ifndef BOOST_LEAF_ASYNC_ERROR_SINK_HPP_INCLUDED
@@ -0,0 +1,253 @@
+#ifndef BOOST_LEAF_BACKTRACE_HPP_INCLUDED
+#define BOOST_LEAF_BACKTRACE_HPP_INCLUDED
+
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/common.hpp>
+#include <boost/leaf/on_error.hpp>
+#include <boost/leaf/detail/demangle.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#if BOOST_LEAF_CFG_WIN32
+#   include <windows.h>
+#   ifdef min
+#       undef min
+#   endif
+#   ifdef max
+#       undef max
+#   endif
+#elif defined(__GNUC__) && defined(__has_include)
+#   if __has_include(<unwind.h>)
+#       include <unwind.h>
+#       define BOOST_LEAF_HAS_UNWIND_H
+#   endif
+#endif
+
+#if BOOST_LEAF_CFG_DLADDR
+#   include <dlfcn.h>
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#   define BOOST_LEAF_RETURN_ADDRESS() _ReturnAddress()
+#   define BOOST_LEAF_BACKTRACE_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__)
+#   define BOOST_LEAF_RETURN_ADDRESS() __builtin_return_address(0)
+#   define BOOST_LEAF_BACKTRACE_NOINLINE __attribute__((noinline))
+#else
+#   define BOOST_LEAF_RETURN_ADDRESS() nullptr
+#   define BOOST_LEAF_BACKTRACE_NOINLINE
+#endif
+
+#define BOOST_LEAF_BACKTRACE(Backtrace) auto BOOST_LEAF_TOKEN_PASTE2(boost_leaf_backtrace_, __LINE__) = ::boost::leaf::on_error(::boost::leaf::detail::backtrace_push<Backtrace>{BOOST_LEAF_RETURN_ADDRESS()})
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+    template <class Backtrace>
+    struct backtrace_push
+    {
+        void const * address;
+
+        void operator()( Backtrace & bt ) const noexcept
+        {
+            bt.push(address);
+        }
+    };
+
+    template <std::size_t S>
+    char const * format_address( char (&buf)[S], std::uintptr_t x ) noexcept
+    {
+        static_assert(S >= 2 * sizeof(std::uintptr_t) + 3, "Buffer too small");
+        char * p = buf + S;
+        *--p = 0;
+        do
+            *--p = "0123456789abcdef"[x & 15];
+        while( x >>= 4 );
+        *--p = 'x';
+        *--p = '0';
+        return p;
+    }
+
+    // Symbolization happens only when a backtrace is printed or serialized,
+    // one frame at a time. Without BOOST_LEAF_CFG_DLADDR, only the address
+    // is available.
+    class backtrace_frame
+    {
+        void const * address_;
+        char const * module_;
+        std::uintptr_t module_offset_;
+        char const * function_;
+
+    public:
+
+        explicit backtrace_frame( void const * address ) noexcept:
+            address_(address),
+            module_(nullptr),
+            module_offset_(0),
+            function_(nullptr)
+        {
+#if BOOST_LEAF_CFG_DLADDR
+            Dl_info info;
+            if( address && dladdr(const_cast<void *>(address), &info) )
+            {
+                module_ = info.dli_fname;
+                module_offset_ = reinterpret_cast<std::uintptr_t>(address) - reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+                function_ = info.dli_sname;
+            }
+#endif
+        }
+
+        template <class CharT, class Traits>
+        friend std::ostream & operator<<(std::basic_ostream<CharT, Traits> & os, backtrace_frame const & x)
+        {
+            char buf[2 * sizeof(std::uintptr_t) + 3];
+            os << format_address(buf, reinterpret_cast<std::uintptr_t>(x.address_));
+            if( x.function_ )
+                os << ' ' << demangler(x.function_).get();
+            if( x.module_ )
+                os << " (" << x.module_ << '+' << format_address(buf, x.module_offset_) << ')';
+            return os;
+        }
+
+        template <class Encoder>
+        friend void output( Encoder & e, backtrace_frame const & x )
+        {
+            char buf[2 * sizeof(std::uintptr_t) + 3];
+            output_at(e, format_address(buf, reinterpret_cast<std::uintptr_t>(x.address_)), detail::member_names::address);
+            if( x.function_ )
+            {
+                demangler d(x.function_);
+                output_at(e, d.get(), detail::member_names::function);
+            }
+            if( x.module_ )
+            {
+                output_at(e, x.module_, detail::member_names::module);
+                output_at(e, format_address(buf, x.module_offset_), detail::member_names::module_offset);
+            }
+        }
+    };
+} // namespace detail
+
+// Records raw return addresses in a buffer of N entries: the call stack when
+// the error is created (see capture), and/or each on_error scope the error
+// passes through (see BOOST_LEAF_BACKTRACE). Once the buffer is full, further
+// addresses are dropped and counted.
+template <std::size_t N>
+class e_backtrace
+{
+    static_assert(N > 0, "e_backtrace capacity must be greater than 0");
+
+    void const * frames_[N];
+    std::size_t count_;
+
+    struct frames_ref
+    {
+        e_backtrace const & bt;
+
+        template <class Encoder>
+        friend void output( Encoder & e, frames_ref const & x )
+        {
+            for( std::size_t i = 0; i != x.bt.size(); ++i )
+                detail::output_indexed_at(e, i, detail::backtrace_frame(x.bt[i]));
+        }
+    };
+
+#ifdef BOOST_LEAF_HAS_UNWIND_H
+    struct unwind_state
+    {
+        e_backtrace * bt;
+        int skip;
+    };
+
+    static _Unwind_Reason_Code unwind_callback( _Unwind_Context * ctx, void * arg ) noexcept
+    {
+        unwind_state & s = *static_cast<unwind_state *>(arg);
+        if( s.skip )
+            --s.skip;
+        else if( std::uintptr_t ip = _Unwind_GetIP(ctx) )
+            s.bt->push(reinterpret_cast<void const *>(ip));
+        return _URC_NO_REASON;
+    }
+#endif
+
+public:
+
+    BOOST_LEAF_CONSTEXPR e_backtrace() noexcept:
+        frames_(),
+        count_(0)
+    {
+    }
+
+    BOOST_LEAF_CONSTEXPR static std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    BOOST_LEAF_CONSTEXPR std::size_t size() const noexcept
+    {
+        return count_ < N ? count_ : N;
+    }
+
+    BOOST_LEAF_CONSTEXPR std::size_t dropped() const noexcept
+    {
+        return count_ - size();
+    }
+
+    void const * operator[]( std::size_t i ) const noexcept
+    {
+        BOOST_LEAF_ASSERT(i < size());
+        return frames_[i];
+    }
+
+    void push( void const * address ) noexcept
+    {
+        if( count_ < N )
+            frames_[count_] = address;
+        ++count_;
+    }
+
+    // Returns the return addresses of the current call stack, starting with
+    // the caller of capture. On platforms where this is not supported, the
+    // returned object is empty.
+    BOOST_LEAF_BACKTRACE_NOINLINE static e_backtrace capture() noexcept
+    {
+        e_backtrace bt;
+#if BOOST_LEAF_CFG_WIN32
+        USHORT n = CaptureStackBackTrace(1, N, const_cast<void * *>(bt.frames_), nullptr);
+        bt.count_ = n;
+#elif defined(BOOST_LEAF_HAS_UNWIND_H)
+        unwind_state s = { &bt, 1 };
+        _Unwind_Backtrace(&unwind_callback, &s);
+#endif
+        return bt;
+    }
+
+    template <class CharT, class Traits>
+    friend std::ostream & operator<<(std::basic_ostream<CharT, Traits> & os, e_backtrace const & x)
+    {
+        for( std::size_t i = 0; i != x.size(); ++i )
+            os << (i ? ", " : "") << detail::backtrace_frame(x[i]);
+        if( std::size_t d = x.dropped() )
+            os << " (" << d << " dropped)";
+        return os;
+    }
+
+    template <class Encoder>
+    friend void output( Encoder & e, e_backtrace const & x )
+    {
+        output_at(e, x.dropped(), detail::member_names::dropped);
+        output_at(e, frames_ref{x}, detail::member_names::frames);
+    }
+};
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_BACKTRACE_HPP_INCLUDED
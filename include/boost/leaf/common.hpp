@@ -6,9 +6,12 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <boost/leaf/config.hpp>
+#include <boost/leaf/detail/member_names.hpp>
+#include <boost/leaf/detail/output_sink.hpp>
 
 #include <iosfwd>
 #include <cerrno>
+#include <cstddef>
 #include <cstring>
 
 #if BOOST_LEAF_CFG_STD_STRING
@@ -61,8 +64,8 @@ struct e_errno
     template <class Encoder>
     friend void output( Encoder & e, e_errno const & x )
     {
-        output_at(e, x.value, "errno");
-        output_at(e, std::strerror(x.value), "strerror");
+        output_at(e, x.value, detail::member_names::errno_);
+        output_at(e, std::strerror(x.value), detail::member_names::strerror);
     }
 };
 
@@ -70,6 +73,118 @@ struct e_type_info_name { char const * value; };
 
 struct e_at_line { int value; };
 
+struct trace_frame
+{
+    char const * file;
+    int line;
+
+    template <class CharT, class Traits>
+    friend std::ostream & operator<<(std::basic_ostream<CharT, Traits> & os, trace_frame const & x)
+    {
+        return os << x.file << '(' << x.line << ')';
+    }
+
+    template <class Encoder>
+    friend void output( Encoder & e, trace_frame const & x )
+    {
+        output_at(e, x.file, detail::member_names::file);
+        output_at(e, x.line, detail::member_names::line);
+    }
+};
+
+namespace detail
+{
+    // Outputs x as the member of e named i, in decimal; used to serialize
+    // array-like members.
+    template <class Encoder, class T>
+    void output_indexed_at( Encoder & e, std::size_t i, T const & x )
+    {
+        char name[max_decimal_length<std::size_t>::value + 1];
+        name[sizeof(name) - 1] = 0;
+        output_at(e, x, format_decimal(name + sizeof(name) - 1, i));
+    }
+} // namespace detail
+
+// Records the path an error takes as it bubbles up, in a ring buffer of N
+// frames (see BOOST_LEAF_TRACE). Once full, each new frame overwrites the
+// oldest one, which is then counted as dropped.
+template <std::size_t N>
+class e_trace
+{
+    static_assert(N > 0, "e_trace capacity must be greater than 0");
+
+    trace_frame frames_[N];
+    std::size_t count_;
+
+    struct frames_ref
+    {
+        e_trace const & tr;
+
+        template <class Encoder>
+        friend void output( Encoder & e, frames_ref const & x )
+        {
+            for( std::size_t i = 0; i != x.tr.size(); ++i )
+                detail::output_indexed_at(e, i, x.tr[i]);
+        }
+    };
+
+public:
+
+    BOOST_LEAF_CONSTEXPR e_trace() noexcept:
+        frames_(),
+        count_(0)
+    {
+    }
+
+    BOOST_LEAF_CONSTEXPR static std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    BOOST_LEAF_CONSTEXPR std::size_t size() const noexcept
+    {
+        return count_ < N ? count_ : N;
+    }
+
+    BOOST_LEAF_CONSTEXPR std::size_t dropped() const noexcept
+    {
+        return count_ - size();
+    }
+
+    // Frames are in the order they were pushed, starting with the oldest one
+    // that was not dropped.
+    trace_frame const & operator[]( std::size_t i ) const noexcept
+    {
+        BOOST_LEAF_ASSERT(i < size());
+        return frames_[(count_ - size() + i) % N];
+    }
+
+    void push( char const * file, int line ) noexcept
+    {
+        trace_frame & f = frames_[count_ % N];
+        f.file = file;
+        f.line = line;
+        ++count_;
+    }
+
+    template <class CharT, class Traits>
+    friend std::ostream & operator<<(std::basic_ostream<CharT, Traits> & os, e_trace const & x)
+    {
+        for( std::size_t i = 0; i != x.size(); ++i )
+            os << (i ? ", " : "") << x[i];
+        if( std::size_t d = x.dropped() )
+            os << " (" << d << " dropped)";
+        return os;
+    }
+
+    template <class Encoder>
+    friend void output( Encoder & e, e_trace const & x )
+    {
+        output_at(e, x.dropped(), detail::member_names::dropped);
+        output_at(e, frames_ref{x}, detail::member_names::frames);
+    }
+};
+
 namespace windows
 {
     struct e_LastError
@@ -25,10 +25,29 @@
 #       define BOOST_LEAF_CFG_STD_STRING 0
 #   endif
 #   ifndef BOOST_LEAF_CFG_CAPTURE
-#       define BOOST_LEAF_CFG_CAPTURE 0
+#       if defined(BOOST_LEAF_CFG_CAPTURE_BUDGET) && BOOST_LEAF_CFG_CAPTURE_BUDGET > 0
+#           define BOOST_LEAF_CFG_CAPTURE 1
+#       else
+#           define BOOST_LEAF_CFG_CAPTURE 0
+#       endif
+#   endif
+#   ifndef BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE
+#       define BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE 0
+#   endif
+#   ifndef BOOST_LEAF_CFG_DEMANGLE_CACHE
+#       define BOOST_LEAF_CFG_DEMANGLE_CACHE 0
+#   endif
+#   ifndef BOOST_LEAF_CFG_DLADDR
+#       define BOOST_LEAF_CFG_DLADDR 0
 #   endif
 #endif // #ifdef BOOST_LEAF_EMBEDDED
 
+#if defined(BOOST_LEAF_CFG_ERROR_ID_BITS) && BOOST_LEAF_CFG_ERROR_ID_BITS == 64
+#   ifndef BOOST_LEAF_CFG_STD_SYSTEM_ERROR
+#       define BOOST_LEAF_CFG_STD_SYSTEM_ERROR 0
+#   endif
+#endif
+
 ////////////////////////////////////////
 
 #ifndef BOOST_LEAF_ASSERT
@@ -54,10 +73,64 @@
 #   define BOOST_LEAF_CFG_CAPTURE 1
 #endif
 
+#ifndef BOOST_LEAF_CFG_CAPTURE_CHUNK_SIZE
+#   define BOOST_LEAF_CFG_CAPTURE_CHUNK_SIZE 256
+#endif
+
+#ifndef BOOST_LEAF_CFG_CAPTURE_BUDGET
+#   define BOOST_LEAF_CFG_CAPTURE_BUDGET 0
+#endif
+
+#ifndef BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE
+#   define BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE 16
+#endif
+
+#ifndef BOOST_LEAF_CFG_DEMANGLE_CACHE
+#   define BOOST_LEAF_CFG_DEMANGLE_CACHE 64
+#endif
+
+#ifndef BOOST_LEAF_CFG_MONITOR_EXCEPTIONS
+#   define BOOST_LEAF_CFG_MONITOR_EXCEPTIONS 1
+#endif
+
+#ifndef BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME
+#   if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#       define BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME 1
+#   else
+#       define BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME 0
+#   endif
+#endif
+
+#ifndef BOOST_LEAF_CFG_STD_PMR
+#   if BOOST_LEAF_CFG_CAPTURE_BUDGET == 0 && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)) && defined(__has_include)
+#       if __has_include(<memory_resource>)
+#           define BOOST_LEAF_CFG_STD_PMR 1
+#       endif
+#   endif
+#   ifndef BOOST_LEAF_CFG_STD_PMR
+#       define BOOST_LEAF_CFG_STD_PMR 0
+#   endif
+#endif
+
 #ifndef BOOST_LEAF_CFG_WIN32
 #   define BOOST_LEAF_CFG_WIN32 0
 #endif
 
+#ifndef BOOST_LEAF_CFG_DLADDR
+#   if !defined(_WIN32) && defined(__has_include)
+#       if __has_include(<dlfcn.h>)
+#           define BOOST_LEAF_CFG_DLADDR 1
+#       endif
+#   endif
+#   ifndef BOOST_LEAF_CFG_DLADDR
+#       define BOOST_LEAF_CFG_DLADDR 0
+#   endif
+#endif
+
+#ifndef BOOST_LEAF_CFG_ERROR_ID_BITS
+#   define BOOST_LEAF_CFG_ERROR_ID_BITS 32
+#endif
+
 #ifndef BOOST_LEAF_CFG_GNUC_STMTEXPR
 #   ifdef __GNUC__
 #   	define BOOST_LEAF_CFG_GNUC_STMTEXPR 1
@@ -90,10 +163,54 @@
 #   error BOOST_LEAF_CFG_CAPTURE must be 0 or 1.
 #endif
 
+#if BOOST_LEAF_CFG_CAPTURE_CHUNK_SIZE < 0
+#   error BOOST_LEAF_CFG_CAPTURE_CHUNK_SIZE must be non-negative.
+#endif
+
+#if BOOST_LEAF_CFG_CAPTURE_BUDGET < 0
+#   error BOOST_LEAF_CFG_CAPTURE_BUDGET must be non-negative.
+#endif
+
+#if BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE < 0
+#   error BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE must be non-negative.
+#endif
+
+#if BOOST_LEAF_CFG_DEMANGLE_CACHE < 0
+#   error BOOST_LEAF_CFG_DEMANGLE_CACHE must be non-negative.
+#endif
+
+#if BOOST_LEAF_CFG_MONITOR_EXCEPTIONS != 0 && BOOST_LEAF_CFG_MONITOR_EXCEPTIONS != 1
+#   error BOOST_LEAF_CFG_MONITOR_EXCEPTIONS must be 0 or 1.
+#endif
+
+#if BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME != 0 && BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME != 1
+#   error BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME must be 0 or 1.
+#endif
+
+#if BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME && !(__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#   error BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME requires C++17 or newer.
+#endif
+
+#if BOOST_LEAF_CFG_STD_PMR != 0 && BOOST_LEAF_CFG_STD_PMR != 1
+#   error BOOST_LEAF_CFG_STD_PMR must be 0 or 1.
+#endif
+
+#if BOOST_LEAF_CFG_STD_PMR && BOOST_LEAF_CFG_CAPTURE_BUDGET
+#   error BOOST_LEAF_CFG_STD_PMR requires BOOST_LEAF_CFG_CAPTURE_BUDGET=0.
+#endif
+
 #if BOOST_LEAF_CFG_WIN32 != 0 && BOOST_LEAF_CFG_WIN32 != 1 && BOOST_LEAF_CFG_WIN32 != 2
 #   error BOOST_LEAF_CFG_WIN32 must be 0 or 1 or 2.
 #endif
 
+#if BOOST_LEAF_CFG_DLADDR != 0 && BOOST_LEAF_CFG_DLADDR != 1
+#   error BOOST_LEAF_CFG_DLADDR must be 0 or 1.
+#endif
+
+#if BOOST_LEAF_CFG_ERROR_ID_BITS != 32 && BOOST_LEAF_CFG_ERROR_ID_BITS != 64
+#   error BOOST_LEAF_CFG_ERROR_ID_BITS must be 32 or 64.
+#endif
+
 #if BOOST_LEAF_CFG_WIN32 && !defined(_WIN32)
 #   warning "Ignoring BOOST_LEAF_CFG_WIN32 because _WIN32 is not defined"
 #   define BOOST_LEAF_CFG_WIN32 0
@@ -111,6 +228,10 @@
 #   error BOOST_LEAF_CFG_STD_SYSTEM_ERROR requires BOOST_LEAF_CFG_STD_STRING, which has been disabled.
 #endif
 
+#if BOOST_LEAF_CFG_ERROR_ID_BITS == 64 && BOOST_LEAF_CFG_STD_SYSTEM_ERROR
+#   error BOOST_LEAF_CFG_ERROR_ID_BITS=64 requires BOOST_LEAF_CFG_STD_SYSTEM_ERROR=0, because std::error_code can not store 64-bit error ids.
+#endif
+
 ////////////////////////////////////////
 
 #ifndef BOOST_LEAF_PRETTY_FUNCTION
@@ -278,6 +399,24 @@ namespace leaf
 
 ////////////////////////////////////////
 
+namespace boost { namespace leaf {
+
+namespace detail
+{
+    // The integer types used to store error ids.
+#if BOOST_LEAF_CFG_ERROR_ID_BITS == 64
+    using error_id_int = long long;
+    using error_id_uint = unsigned long long;
+#else
+    using error_id_int = int;
+    using error_id_uint = unsigned;
+#endif
+} // namespace detail
+
+} } // namespace boost::leaf
+
+////////////////////////////////////////
+
 // Configure TLS access
 #include <boost/leaf/config/tls.hpp>
 
@@ -15,21 +15,24 @@ namespace tls
     // Generate the next unique error_id. Values start at 1 and increment by 4.
     // Error ids must be unique for the lifetime of the process, and this
     // function must be thread-safe. Postcondition: (id & 3) == 1 && id != 0.
+    // Ids generated by different threads need not be ordered (see
+    // BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE in tls_cpp11.hpp). The type of error
+    // ids is determined by BOOST_LEAF_CFG_ERROR_ID_BITS, see config.hpp.
     //
     // This function may not fail.
-    unsigned generate_next_error_id() noexcept;
+    detail::error_id_uint generate_next_error_id() noexcept;
 
     // Write x to the TLS for the current error_id. The initial value for each
     // thread must be 0. Precondition: x == 0 or (x & 3) == 1.
     //
     // This function may not fail.
-    void write_current_error_id( unsigned x ) noexcept;
+    void write_current_error_id( detail::error_id_uint x ) noexcept;
 
     // Read the current error_id for this thread. The initial value for each
     // thread must be 0.
     //
     // This function may not fail.
-    unsigned read_current_error_id() noexcept;
+    detail::error_id_uint read_current_error_id() noexcept;
 
     // Reserve TLS storage for T. The TLS may be allocated dynamically on the
     // first call to reserve_ptr<T>, but subsequent calls must reuse the same
@@ -63,6 +66,16 @@ namespace tls
 #   ifndef BOOST_LEAF_USE_TLS_ARRAY
 #       define BOOST_LEAF_USE_TLS_ARRAY
 #   endif
+#elif defined(BOOST_LEAF_USE_TLS_BLOCK)
+#   include <boost/leaf/config/tls_block.hpp>
+#   ifndef BOOST_LEAF_USE_TLS_ARRAY
+#       define BOOST_LEAF_USE_TLS_ARRAY
+#   endif
+#elif defined(BOOST_LEAF_USE_TLS_AGENT)
+#   include <boost/leaf/config/tls_agent.hpp>
+#   ifndef BOOST_LEAF_USE_TLS_ARRAY
+#       define BOOST_LEAF_USE_TLS_ARRAY
+#   endif
 #endif
 
 #ifndef BOOST_LEAF_USE_TLS_ARRAY
@@ -77,6 +90,15 @@ namespace tls
 #	endif
 #endif
 
+#if defined(BOOST_LEAF_USE_TLS_ARRAY) || defined(BOOST_LEAF_USE_TLS_BLOCK) || defined(BOOST_LEAF_USE_TLS_AGENT) || BOOST_LEAF_CFG_WIN32 == 2 || defined(BOOST_LEAF_NO_THREADS)
+#	ifdef BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE
+#		warning "BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE" is ignored unless the C++11 thread_local TLS implementation is used.
+#	endif
+#	ifdef BOOST_LEAF_CFG_TLS_MODEL
+#		warning "BOOST_LEAF_CFG_TLS_MODEL" is ignored unless the C++11 thread_local TLS implementation is used.
+#	endif
+#endif
+
 #if defined BOOST_LEAF_USE_TLS_ARRAY
 #   include <boost/leaf/config/tls_array.hpp>
 #elif BOOST_LEAF_CFG_WIN32 == 2
@@ -0,0 +1,123 @@
+#ifndef BOOST_LEAF_CONFIG_TLS_AGENT_HPP_INCLUDED
+#define BOOST_LEAF_CONFIG_TLS_AGENT_HPP_INCLUDED
+
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This header implements the TLS API specified in tls.hpp for programs where
+// the unit of execution is not an OS thread but a task, fiber or coroutine
+// (an execution agent) which may be suspended on one thread and resumed on
+// another, using the more general implementation defined in tls_array.hpp.
+//
+// All LEAF per-thread state (the current error id, and the pointers to the
+// active slots, contexts and dynamic allocators) is kept in a tls::agent_state
+// object. Each thread uses its own default agent_state until a scheduler
+// installs a different one by calling tls::exchange_agent_state, which costs a
+// few pointer writes. To make an execution agent portable across threads,
+// the scheduler keeps an agent_state object per task, installs it whenever the
+// task is resumed, and restores the previous state when it is suspended.
+
+#include <cstdint>
+
+#ifndef BOOST_LEAF_CFG_TLS_ARRAY_SIZE
+#   define BOOST_LEAF_CFG_TLS_ARRAY_SIZE 64
+#endif
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+    template <class>
+    struct current_agent_state;
+}
+
+namespace tls
+{
+    class agent_state
+    {
+        agent_state( agent_state const & ) = delete;
+        agent_state & operator=( agent_state const & ) = delete;
+
+        template <class>
+        friend struct detail::current_agent_state;
+
+        // Accesses are not bounds-checked; index_counter (tls_array.hpp) calls
+        // std::abort if a type is assigned an index which does not fit.
+        void * p_[BOOST_LEAF_CFG_TLS_ARRAY_SIZE];
+
+    public:
+
+        BOOST_LEAF_CONSTEXPR agent_state() noexcept:
+            p_()
+        {
+        }
+    };
+}
+
+namespace detail
+{
+    // The per-thread data is kept in a single thread_local variable of a
+    // trivial type, so that no TLS init function needs to be called. The
+    // installed agent_state is located by adding an offset to the address of
+    // the default state, rather than by testing for null, so that accessing it
+    // does not branch and the compiler can reuse the address of the TLS
+    // variable across multiple accesses.
+    struct agent_tls
+    {
+        tls::agent_state * current;
+        std::uintptr_t offset;
+        void * default_state[BOOST_LEAF_CFG_TLS_ARRAY_SIZE];
+    };
+
+    template <class=void>
+    struct BOOST_LEAF_SYMBOL_VISIBLE current_agent_state
+    {
+        static thread_local agent_tls x;
+
+        BOOST_LEAF_ALWAYS_INLINE static void * * get() noexcept
+        {
+            agent_tls & t = x;
+            return reinterpret_cast<void * *>(reinterpret_cast<std::uintptr_t>(t.default_state) + t.offset);
+        }
+
+        BOOST_LEAF_ALWAYS_INLINE static tls::agent_state * exchange( tls::agent_state * s ) noexcept
+        {
+            agent_tls & t = x;
+            tls::agent_state * prev = t.current;
+            t.current = s;
+            t.offset = s ? reinterpret_cast<std::uintptr_t>(s->p_) - reinterpret_cast<std::uintptr_t>(t.default_state) : 0;
+            return prev;
+        }
+    };
+
+    template <class T>
+    thread_local agent_tls current_agent_state<T>::x;
+} // namespace detail
+
+namespace tls
+{
+    // Installs s as the agent_state of the calling thread (if s is null, the
+    // thread's default agent_state is installed), and returns the previously
+    // installed agent_state (null if it was the default one).
+    BOOST_LEAF_ALWAYS_INLINE agent_state * exchange_agent_state( agent_state * s ) noexcept
+    {
+        return detail::current_agent_state<>::exchange(s);
+    }
+
+    BOOST_LEAF_ALWAYS_INLINE void * read_void_ptr( int tls_index ) noexcept
+    {
+        BOOST_LEAF_ASSERT(tls_index >= 0 && tls_index < (BOOST_LEAF_CFG_TLS_ARRAY_SIZE));
+        return detail::current_agent_state<>::get()[tls_index];
+    }
+
+    BOOST_LEAF_ALWAYS_INLINE void write_void_ptr( int tls_index, void * p ) noexcept
+    {
+        BOOST_LEAF_ASSERT(tls_index >= 0 && tls_index < (BOOST_LEAF_CFG_TLS_ARRAY_SIZE));
+        detail::current_agent_state<>::get()[tls_index] = p;
+    }
+}
+
+} }
+
+#endif // #ifndef BOOST_LEAF_CONFIG_TLS_AGENT_HPP_INCLUDED
@@ -28,6 +28,7 @@ namespace tls
 #include <atomic>
 #include <limits>
 #include <cstdint>
+#include <cstdlib>
 #include <type_traits>
 
 #ifndef BOOST_LEAF_CFG_TLS_INDEX_TYPE
@@ -54,7 +55,7 @@ namespace boost { namespace leaf {
 
 namespace detail
 {
-    using atomic_unsigned_int = std::atomic<unsigned int>;
+    using atomic_unsigned_int = std::atomic<error_id_uint>;
 
     template <class=void>
     struct BOOST_LEAF_SYMBOL_VISIBLE id_factory
@@ -75,6 +76,13 @@ namespace detail
             int idx = ++c_;
             BOOST_LEAF_ASSERT(idx > (BOOST_LEAF_CFG_TLS_ARRAY_START_INDEX + 1));
             BOOST_LEAF_ASSERT(idx < (BOOST_LEAF_CFG_TLS_ARRAY_SIZE));
+#ifdef BOOST_LEAF_CFG_TLS_ARRAY_SIZE
+            // Also checked in release builds: unlike FreeRTOS, the arrays used
+            // by BOOST_LEAF_USE_TLS_BLOCK and BOOST_LEAF_USE_TLS_AGENT are not
+            // bounds-checked on access.
+            if( idx >= (BOOST_LEAF_CFG_TLS_ARRAY_SIZE) )
+                std::abort();
+#endif
             return idx;
         }
 
@@ -117,23 +125,23 @@ namespace boost { namespace leaf {
 
 namespace tls
 {
-    BOOST_LEAF_ALWAYS_INLINE unsigned generate_next_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint generate_next_error_id() noexcept
     {
-        unsigned id = (detail::id_factory<>::counter += 4);
+        detail::error_id_uint id = (detail::id_factory<>::counter += 4);
         BOOST_LEAF_ASSERT((id&3) == 1);
         return id;
     }
 
-    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id( unsigned x ) noexcept
+    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id( detail::error_id_uint x ) noexcept
     {
-        static_assert(sizeof(std::intptr_t) >= sizeof(unsigned), "Incompatible tls_array implementation");
+        static_assert(sizeof(std::intptr_t) >= sizeof(detail::error_id_uint), "Incompatible tls_array implementation");
         write_void_ptr(BOOST_LEAF_CFG_TLS_ARRAY_START_INDEX, (void *) (std::intptr_t) x);
     }
 
-    BOOST_LEAF_ALWAYS_INLINE unsigned read_current_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint read_current_error_id() noexcept
     {
-        static_assert(sizeof(std::intptr_t) >= sizeof(unsigned), "Incompatible tls_array implementation");
-        return (unsigned) (std::intptr_t) read_void_ptr(BOOST_LEAF_CFG_TLS_ARRAY_START_INDEX);
+        static_assert(sizeof(std::intptr_t) >= sizeof(detail::error_id_uint), "Incompatible tls_array implementation");
+        return (detail::error_id_uint) (std::intptr_t) read_void_ptr(BOOST_LEAF_CFG_TLS_ARRAY_START_INDEX);
     }
 
     template <class T>
@@ -0,0 +1,51 @@
+#ifndef BOOST_LEAF_CONFIG_TLS_BLOCK_HPP_INCLUDED
+#define BOOST_LEAF_CONFIG_TLS_BLOCK_HPP_INCLUDED
+
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This header implements the TLS API specified in tls.hpp by keeping all of
+// the LEAF per-thread state in a single, cache-aligned C++11 thread_local
+// array of pointers, using the more general implementation defined in
+// tls_array.hpp. Each type that needs TLS is assigned a dense index into the
+// array, so that activating a context and accessing slots reads and writes
+// adjacent memory through a single TLS variable (in position-independent code
+// that is a single __tls_get_addr lookup, rather than one per type).
+
+#ifndef BOOST_LEAF_CFG_TLS_ARRAY_SIZE
+#   define BOOST_LEAF_CFG_TLS_ARRAY_SIZE 128
+#endif
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+    template <class=void>
+    struct BOOST_LEAF_SYMBOL_VISIBLE tls_block
+    {
+        alignas(64) static thread_local void * p[BOOST_LEAF_CFG_TLS_ARRAY_SIZE];
+    };
+
+    template <class T>
+    alignas(64) thread_local void * tls_block<T>::p[BOOST_LEAF_CFG_TLS_ARRAY_SIZE];
+} // namespace detail
+
+namespace tls
+{
+    BOOST_LEAF_ALWAYS_INLINE void * read_void_ptr( int tls_index ) noexcept
+    {
+        BOOST_LEAF_ASSERT(tls_index >= 0 && tls_index < (BOOST_LEAF_CFG_TLS_ARRAY_SIZE));
+        return detail::tls_block<>::p[tls_index];
+    }
+
+    BOOST_LEAF_ALWAYS_INLINE void write_void_ptr( int tls_index, void * p ) noexcept
+    {
+        BOOST_LEAF_ASSERT(tls_index >= 0 && tls_index < (BOOST_LEAF_CFG_TLS_ARRAY_SIZE));
+        detail::tls_block<>::p[tls_index] = p;
+    }
+}
+
+} }
+
+#endif // #ifndef BOOST_LEAF_CONFIG_TLS_BLOCK_HPP_INCLUDED
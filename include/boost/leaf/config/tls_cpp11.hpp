@@ -14,11 +14,52 @@
 #include <atomic>
 #include <cstdint>
 
+#ifndef BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE
+#   define BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE 1
+#endif
+
+static_assert((BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE) >= 1 && (BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE) <= 0x1000000,
+    "Bad BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE");
+
+#if BOOST_LEAF_CFG_ERROR_ID_BITS == 64 && BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE > 1
+#   warning "BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE" is ignored if BOOST_LEAF_CFG_ERROR_ID_BITS is 64.
+#endif
+
+// BOOST_LEAF_CFG_TLS_MODEL selects the TLS model used for the thread_local
+// variables defined in this header:
+// 0 - the compiler default (general-dynamic in position-independent code);
+// 1 - initial-exec: the variables are accessed at a fixed offset from the
+//     thread pointer, without calling __tls_get_addr. Modules loaded with
+//     dlopen take space from the static TLS surplus reserved by the dynamic
+//     loader, so loading may fail if that space is exhausted (with glibc,
+//     see the glibc.rtld.optional_static_tls tunable);
+// 2 - local-dynamic: legal only if the LEAF TLS variables of a module are not
+//     shared with other modules, that is, if error objects do not cross the
+//     module boundary.
+#ifndef BOOST_LEAF_CFG_TLS_MODEL
+#   define BOOST_LEAF_CFG_TLS_MODEL 0
+#endif
+
+#if BOOST_LEAF_CFG_TLS_MODEL != 0 && BOOST_LEAF_CFG_TLS_MODEL != 1 && BOOST_LEAF_CFG_TLS_MODEL != 2
+#   error BOOST_LEAF_CFG_TLS_MODEL must be 0 or 1 or 2.
+#endif
+
+#if BOOST_LEAF_CFG_TLS_MODEL == 0
+#   define BOOST_LEAF_TLS_MODEL
+#elif !defined(__GNUC__)
+#   warning "BOOST_LEAF_CFG_TLS_MODEL" is ignored because the compiler does not support the tls_model attribute.
+#   define BOOST_LEAF_TLS_MODEL
+#elif BOOST_LEAF_CFG_TLS_MODEL == 1
+#   define BOOST_LEAF_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#   define BOOST_LEAF_TLS_MODEL __attribute__((tls_model("local-dynamic")))
+#endif
+
 namespace boost { namespace leaf {
 
 namespace detail
 {
-    using atomic_unsigned_int = std::atomic<unsigned int>;
+    using atomic_unsigned_int = std::atomic<error_id_uint>;
 
     template <class=void>
     struct BOOST_LEAF_SYMBOL_VISIBLE id_factory
@@ -32,7 +73,7 @@ namespace detail
     template <class T>
     struct BOOST_LEAF_SYMBOL_VISIBLE ptr
     {
-        static thread_local T * p;
+        static thread_local T * p BOOST_LEAF_TLS_MODEL;
     };
 
     template <class T>
@@ -41,11 +82,63 @@ namespace detail
     template <class=void>
     struct BOOST_LEAF_SYMBOL_VISIBLE current_error_id_storage
     {
-        static thread_local unsigned x;
+        static thread_local error_id_uint x BOOST_LEAF_TLS_MODEL;
+    };
+
+    template <class T>
+    thread_local error_id_uint current_error_id_storage<T>::x;
+
+#if BOOST_LEAF_CFG_ERROR_ID_BITS == 64
+    // With BOOST_LEAF_CFG_ERROR_ID_BITS=64, error ids are composed of a thread
+    // ordinal (bits 32 to 62) and a per-thread sequence number (bits 2 to 31).
+    // A thread takes a new ordinal from the shared id_factory counter the
+    // first time it generates an error id, and then once every 2^30 error ids,
+    // so generating an error id practically never touches shared memory.
+    template <class=void>
+    struct BOOST_LEAF_SYMBOL_VISIBLE id_sequence
+    {
+        static thread_local error_id_uint next BOOST_LEAF_TLS_MODEL;
+
+        static error_id_uint reserve() noexcept
+        {
+            error_id_uint ordinal = ++id_factory<>::counter;
+            BOOST_LEAF_ASSERT(ordinal < (error_id_uint(1) << 31));
+            return (ordinal << 32) | 1;
+        }
+    };
+
+    template <class T>
+    thread_local error_id_uint id_sequence<T>::next;
+#elif BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE > 1
+    // With BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE > 1, each thread reserves a
+    // block of that many error ids with a single update of the shared
+    // id_factory counter, then generates ids from the block without touching
+    // shared memory. Since the counter still moves in steps of 4, all ids
+    // satisfy (id&3)==1 and blocks reserved by different threads never
+    // overlap; however, ids generated by different threads are no longer
+    // ordered by time of generation.
+    struct id_block_state
+    {
+        unsigned next;
+        unsigned end;
+    };
+
+    template <class=void>
+    struct BOOST_LEAF_SYMBOL_VISIBLE id_block
+    {
+        static thread_local id_block_state s BOOST_LEAF_TLS_MODEL;
+
+        static unsigned reserve() noexcept
+        {
+            unsigned last = (id_factory<>::counter += 4 * (BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE));
+            s.end = last + 4;
+            return last - 4 * ((BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE) - 1);
+        }
     };
 
     template <class T>
-    thread_local unsigned current_error_id_storage<T>::x;
+    thread_local id_block_state id_block<T>::s;
+#endif
 } // namespace detail
 
 } } // namespace boost::leaf
@@ -56,19 +149,33 @@ namespace boost { namespace leaf {
 
 namespace tls
 {
-    BOOST_LEAF_ALWAYS_INLINE unsigned generate_next_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint generate_next_error_id() noexcept
     {
+#if BOOST_LEAF_CFG_ERROR_ID_BITS == 64
+        detail::error_id_uint & next = detail::id_sequence<>::next;
+        detail::error_id_uint id = next;
+        if( !id )
+            id = detail::id_sequence<>::reserve();
+        next = (id & 0xFFFFFFFFu) == 0xFFFFFFFDu ? 0 : id + 4;
+#elif BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE > 1
+        detail::id_block_state & s = detail::id_block<>::s;
+        unsigned id = s.next;
+        if( id == s.end )
+            id = detail::id_block<>::reserve();
+        s.next = id + 4;
+#else
         unsigned id = (detail::id_factory<>::counter += 4);
+#endif
         BOOST_LEAF_ASSERT((id&3) == 1);
         return id;
     }
 
-    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id( unsigned x ) noexcept
+    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id( detail::error_id_uint x ) noexcept
     {
         detail::current_error_id_storage<>::x = x;
     }
 
-    BOOST_LEAF_ALWAYS_INLINE unsigned read_current_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint read_current_error_id() noexcept
     {
         return detail::current_error_id_storage<>::x;
     }
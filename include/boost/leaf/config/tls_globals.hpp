@@ -14,7 +14,7 @@ namespace boost { namespace leaf {
 
 namespace detail
 {
-    using atomic_unsigned_int = unsigned int;
+    using atomic_unsigned_int = error_id_uint;
 
     template <class=void>
     struct BOOST_LEAF_SYMBOL_VISIBLE id_factory
@@ -37,11 +37,11 @@ namespace detail
     template <class=void>
     struct BOOST_LEAF_SYMBOL_VISIBLE current_error_id_storage
     {
-        static unsigned x;
+        static error_id_uint x;
     };
 
     template <class T>
-    unsigned current_error_id_storage<T>::x = 0;
+    error_id_uint current_error_id_storage<T>::x = 0;
 } // namespace detail
 
 } } // namespace boost::leaf
@@ -52,19 +52,19 @@ namespace boost { namespace leaf {
 
 namespace tls
 {
-    BOOST_LEAF_ALWAYS_INLINE unsigned generate_next_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint generate_next_error_id() noexcept
     {
-        unsigned id = (detail::id_factory<>::counter += 4);
+        detail::error_id_uint id = (detail::id_factory<>::counter += 4);
         BOOST_LEAF_ASSERT((id&3) == 1);
         return id;
     }
 
-    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id( unsigned v ) noexcept
+    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id( detail::error_id_uint v ) noexcept
     {
         detail::current_error_id_storage<>::x = v;
     }
 
-    BOOST_LEAF_ALWAYS_INLINE unsigned read_current_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint read_current_error_id() noexcept
     {
         return detail::current_error_id_storage<>::x;
     }
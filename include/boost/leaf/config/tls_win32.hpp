@@ -107,7 +107,7 @@ namespace detail
         }
     };
 
-    using atomic_unsigned_int = std::atomic<unsigned int>;
+    using atomic_unsigned_int = std::atomic<error_id_uint>;
 
     template <int N, int I>
     struct cpp11_hash_step
@@ -485,10 +485,10 @@ namespace detail
     template<int N>
     module_state module<N>::state;
 
-    BOOST_LEAF_ALWAYS_INLINE unsigned generate_next_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE error_id_uint generate_next_error_id() noexcept
     {
         static atomic_unsigned_int & counter = module<>::state.sm().error_id_storage();
-        unsigned id = (counter += 4);
+        error_id_uint id = (counter += 4);
         BOOST_LEAF_ASSERT((id&3) == 1);
         return id;
     }
@@ -530,26 +530,27 @@ namespace boost { namespace leaf {
 
 namespace tls
 {
-    BOOST_LEAF_ALWAYS_INLINE unsigned generate_next_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint generate_next_error_id() noexcept
     {
         return detail::generate_next_error_id();
     }
 
-    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id(unsigned x) noexcept
+    BOOST_LEAF_ALWAYS_INLINE void write_current_error_id(detail::error_id_uint x) noexcept
     {
         using namespace detail;
+        static_assert(sizeof(std::uintptr_t) >= sizeof(error_id_uint), "Incompatible tls_win32 implementation");
         DWORD slot = module<>::state.sm().error_id_slot();
         BOOL r = TlsSetValue(slot, reinterpret_cast<void *>(static_cast<std::uintptr_t>(x)));
         BOOST_LEAF_ASSERT(r), (void) r;
     }
 
-    BOOST_LEAF_ALWAYS_INLINE unsigned read_current_error_id() noexcept
+    BOOST_LEAF_ALWAYS_INLINE detail::error_id_uint read_current_error_id() noexcept
     {
         using namespace detail;
         DWORD slot = module<>::state.sm().error_id_slot();
         LPVOID value = TlsGetValue(slot);
         BOOST_LEAF_ASSERT(GetLastError() == ERROR_SUCCESS);
-        return static_cast<unsigned>(reinterpret_cast<std::uintptr_t>(value));
+        return static_cast<error_id_uint>(reinterpret_cast<std::uintptr_t>(value));
     }
 
     template <class T>
@@ -9,7 +9,7 @@
 #include <boost/leaf/detail/diagnostics_writer.hpp>
 #include <boost/leaf/error.hpp>
 
-#if !defined(BOOST_LEAF_NO_THREADS) && !defined(NDEBUG)
+#if !defined(BOOST_LEAF_NO_THREADS) && !defined(BOOST_LEAF_USE_TLS_AGENT) && !defined(NDEBUG)
 #   include <thread>
 #endif
 
@@ -195,7 +195,7 @@ namespace detail
             tuple_for_each<I-1,Tup>::deactivate(tup);
         }
 
-        BOOST_LEAF_CONSTEXPR static void unload( Tup & tup, int err_id ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
+        BOOST_LEAF_CONSTEXPR static void unload( Tup & tup, error_id_int err_id ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
         {
             static_assert(!std::is_same<error_info, typename std::decay<decltype(std::get<I-1>(tup))>::type>::value, "Bug in LEAF: context type deduction");
             BOOST_LEAF_ASSERT(err_id != 0);
@@ -218,16 +218,22 @@ namespace detail
     {
         BOOST_LEAF_CONSTEXPR static void activate( Tup & ) noexcept { }
         BOOST_LEAF_CONSTEXPR static void deactivate( Tup & ) noexcept { }
-        BOOST_LEAF_CONSTEXPR static void unload( Tup &, int ) noexcept { }
+        BOOST_LEAF_CONSTEXPR static void unload( Tup &, error_id_int ) noexcept { }
         BOOST_LEAF_CONSTEXPR static void serialize_to(encoder &, void const *, error_id) { }
     };
 
     class context_base;
 
+    // Contexts are serialized through type-erased calls which take encoder &,
+    // so fingerprint_builder is recovered here, once per context, rather than
+    // for each error object.
     template <class Context>
     void serialize_context_to(encoder & e, context_base const & ctx, error_id id)
     {
-        static_cast<Context const &>(ctx).serialize_to(e, id);
+        if( fingerprint_builder * fb = e.get<fingerprint_builder>() )
+            static_cast<Context const &>(ctx).serialize_to(*fb, id);
+        else
+            static_cast<Context const &>(ctx).serialize_to(e, id);
     }
 } // namespace detail
 
@@ -327,7 +333,7 @@ class context final:
     Tup tup_;
     bool is_active_;
 
-#if !defined(BOOST_LEAF_NO_THREADS) && !defined(NDEBUG)
+#if !defined(BOOST_LEAF_NO_THREADS) && !defined(BOOST_LEAF_USE_TLS_AGENT) && !defined(NDEBUG)
     std::thread::id thread_id_;
 #endif
 
@@ -360,9 +366,7 @@ class context final:
 #if BOOST_LEAF_CFG_CAPTURE
     void serialize_to_( detail::encoder & e, error_id id ) const override
     {
-        detail::tuple_for_each<std::tuple_size<Tup>::value, Tup>::serialize_to(e, &tup_, id);
-        if( parent_ )
-            parent_->serialize_to_(e, id);
+        detail::serialize_context_to<context>(e, *this, id);
     }
 #endif
 
@@ -410,7 +414,7 @@ public:
     {
         using namespace detail;
         BOOST_LEAF_ASSERT(!is_active());
-#if !defined(BOOST_LEAF_NO_THREADS) && !defined(NDEBUG)
+#if !defined(BOOST_LEAF_NO_THREADS) && !defined(BOOST_LEAF_USE_TLS_AGENT) && !defined(NDEBUG)
         thread_id_ = std::this_thread::get_id();
 #endif
 #if BOOST_LEAF_CFG_CAPTURE
@@ -424,7 +428,7 @@ public:
     {
         using namespace detail;
         BOOST_LEAF_ASSERT(is_active());
-#if !defined(BOOST_LEAF_NO_THREADS) && !defined(NDEBUG)
+#if !defined(BOOST_LEAF_NO_THREADS) && !defined(BOOST_LEAF_USE_TLS_AGENT) && !defined(NDEBUG)
         BOOST_LEAF_ASSERT(std::this_thread::get_id() == thread_id_);
         thread_id_ = std::thread::id();
 #endif
@@ -438,7 +442,7 @@ public:
     void unload(error_id id) noexcept(!BOOST_LEAF_CFG_CAPTURE)
     {
         BOOST_LEAF_ASSERT(!is_active());
-        tls::write_current_error_id(static_cast<unsigned>(id.value()));
+        tls::write_current_error_id(static_cast<detail::error_id_uint>(id.value()));
         detail::tuple_for_each<std::tuple_size<Tup>::value,Tup>::unload(tup_, id.value());
     }
 
@@ -12,5 +12,7 @@
 #include <boost/leaf/pred.hpp>
 #include <boost/leaf/result.hpp>
 #include <boost/leaf/serialization/boost_json_encoder.hpp>
+#include <boost/leaf/serialization/cbor_encoder.hpp>
+#include <boost/leaf/serialization/json_encoder.hpp>
 #include <boost/leaf/serialization/nlohmann_json_encoder.hpp>
 #include <boost/leaf/to_variant.hpp>
@@ -0,0 +1,282 @@
+#ifndef BOOST_LEAF_DETAIL_BUFFER_WRITER_HPP_INCLUDED
+#define BOOST_LEAF_DETAIL_BUFFER_WRITER_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/detail/diagnostics_writer.hpp>
+#include <boost/leaf/detail/output_sink.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#if BOOST_LEAF_CFG_STD_STRING
+#   include <string>
+#endif
+
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+#   include <new>
+#   include <ostream>
+#   include <streambuf>
+#endif
+
+#if (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)) && defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+    // Formats into a caller-supplied buffer without allocating. Output which
+    // doesn't fit is truncated, the buffer is always zero-terminated, and
+    // size() keeps counting past the end, like snprintf.
+    //
+    // Strings, characters, arithmetic types and type names are formatted
+    // directly. Other types are printed through their operator<<, using a
+    // std::ostream which writes into the same buffer; it is only constructed
+    // if needed.
+    class buffer_stream
+    {
+        buffer_stream( buffer_stream const & ) = delete;
+        buffer_stream & operator=( buffer_stream const & ) = delete;
+
+        output_sink sink_;
+
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+        class streambuf: public std::streambuf
+        {
+            buffer_stream & s_;
+
+        protected:
+
+            int_type overflow( int_type c ) override
+            {
+                if( !traits_type::eq_int_type(c, traits_type::eof()) )
+                {
+                    char ch = traits_type::to_char_type(c);
+                    s_.write(&ch, 1);
+                }
+                return traits_type::not_eof(c);
+            }
+
+            std::streamsize xsputn( char const * s, std::streamsize n ) override
+            {
+                s_.write(s, static_cast<std::size_t>(n));
+                return n;
+            }
+
+        public:
+
+            explicit streambuf( buffer_stream & s ) noexcept:
+                s_(s)
+            {
+            }
+        };
+
+        struct fallback
+        {
+            streambuf sb;
+            std::ostream os;
+
+            explicit fallback( buffer_stream & s ):
+                sb(s),
+                os(&sb)
+            {
+            }
+        };
+
+        alignas(fallback) unsigned char fallback_storage_[sizeof(fallback)];
+        fallback * fallback_;
+
+        std::ostream & fallback_os()
+        {
+            if( !fallback_ )
+                fallback_ = new (fallback_storage_) fallback(*this);
+            return fallback_->os;
+        }
+#endif
+
+        template <class T>
+        buffer_stream & write_floating_point( T x, char const * format )
+        {
+            char buf[64];
+#ifdef __cpp_lib_to_chars
+            (void) format;
+            std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), x, std::chars_format::general, 6);
+            write(buf, static_cast<std::size_t>(r.ptr - buf));
+#else
+            int n = std::snprintf(buf, sizeof(buf), format, x);
+            if( n > 0 )
+                write(buf, static_cast<std::size_t>(n) < sizeof(buf) ? static_cast<std::size_t>(n) : sizeof(buf) - 1);
+#endif
+            return *this;
+        }
+
+    public:
+
+        buffer_stream( char * buf, std::size_t size ) noexcept:
+            sink_(buf, size, true)
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+            , fallback_(nullptr)
+#endif
+        {
+        }
+
+        ~buffer_stream() noexcept
+        {
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+            if( fallback_ )
+                fallback_->~fallback();
+#endif
+        }
+
+        std::size_t size() const noexcept
+        {
+            return sink_.size();
+        }
+
+        void write( char const * s, std::size_t n ) noexcept
+        {
+            sink_.write(s, n);
+        }
+
+        buffer_stream & operator<<( char const * s ) noexcept
+        {
+            if( s )
+                write(s, std::strlen(s));
+            return *this;
+        }
+
+        buffer_stream & operator<<( char c ) noexcept
+        {
+            write(&c, 1);
+            return *this;
+        }
+
+        buffer_stream & operator<<( signed char c ) noexcept
+        {
+            return *this << static_cast<char>(c);
+        }
+
+        buffer_stream & operator<<( unsigned char c ) noexcept
+        {
+            return *this << static_cast<char>(c);
+        }
+
+        buffer_stream & operator<<( bool x ) noexcept
+        {
+            return *this << (x ? '1' : '0');
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value, buffer_stream &>::type
+        operator<<( T x ) noexcept
+        {
+            sink_.write_decimal(x);
+            return *this;
+        }
+
+        buffer_stream & operator<<( float x )
+        {
+            return write_floating_point(static_cast<double>(x), "%.6g");
+        }
+
+        buffer_stream & operator<<( double x )
+        {
+            return write_floating_point(x, "%.6g");
+        }
+
+        buffer_stream & operator<<( long double x )
+        {
+            return write_floating_point(x, "%.6Lg");
+        }
+
+#if BOOST_LEAF_CFG_STD_STRING
+        buffer_stream & operator<<( std::string const & s ) noexcept
+        {
+            write(s.data(), s.size());
+            return *this;
+        }
+#endif
+
+        buffer_stream & operator<<( type_name const & x ) noexcept
+        {
+            write(x.name_not_zero_terminated_at_length, x.length);
+            return *this;
+        }
+
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+        template <class T>
+        typename std::enable_if<!std::is_arithmetic<T>::value, buffer_stream &>::type
+        operator<<( T const & x )
+        {
+            fallback_os() << x;
+            return *this;
+        }
+#endif
+    }; // class buffer_stream
+
+    ////////////////////////////////////////
+
+    // Formats diagnostic information the same way as diagnostics_writer, but
+    // into a buffer_stream.
+    class buffer_writer: public encoder
+    {
+        buffer_writer( buffer_writer const & ) = delete;
+        buffer_writer & operator=( buffer_writer const & ) = delete;
+
+        buffer_stream os_;
+        char const * prefix_;
+        char const * delimiter_;
+
+    public:
+
+        buffer_writer( char * buf, std::size_t size, error_id const & id, e_source_location const * loc, std::exception const * ex ):
+            encoder(this),
+            os_(buf, size),
+            prefix_(print_diagnostic_header(os_, id, loc, ex)),
+            delimiter_(BOOST_LEAF_CFG_DIAGNOSTICS_DELIMITER)
+        {
+        }
+
+        buffer_stream & stream() noexcept
+        {
+            return os_;
+        }
+
+        void set_prefix( char const * prefix ) noexcept
+        {
+            prefix_ = prefix;
+        }
+
+        void set_delimiter( char const * delimiter ) noexcept
+        {
+            delimiter_ = delimiter;
+        }
+
+        template <class T>
+        void write( T const & x )
+        {
+            diagnostic<T>::print(os_, prefix_, delimiter_, x);
+        }
+
+        // Terminates the message, and returns the length of the complete
+        // message, which may be greater than the size of the buffer.
+        std::size_t finish() noexcept
+        {
+            os_ << '\n';
+            return os_.size();
+        }
+    }; // class buffer_writer
+} // namespace detail
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_DETAIL_BUFFER_WRITER_HPP_INCLUDED
@@ -9,6 +9,14 @@
 
 #if BOOST_LEAF_CFG_CAPTURE
 
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if BOOST_LEAF_CFG_STD_PMR
+#   include <memory_resource>
+#endif
+
 namespace boost { namespace leaf {
 
 class error_id;
@@ -16,48 +24,349 @@ class error_id;
 namespace detail
 {
     class encoder;
+    class fingerprint_builder;
+
+    // Type-erased operations on an object stored in a capture_chunk.
+    struct capture_entry_ops
+    {
+        std::size_t size;
+        std::size_t align;
+        void (*unload)( void *, error_id_int );
+        void (*serialize_to)( void const *, encoder &, error_id const & );
+        void (*fingerprint_to)( void const *, fingerprint_builder &, error_id const & );
+        void (*deactivate)( void const * );
+        void (*destroy)( void * );
+        void (*move)( void * to, void * from ); // Moves, then destroys *from.
+    };
+
+#if BOOST_LEAF_CFG_CAPTURE_BUDGET
 
+    // Defined in error.hpp.
+    inline void load_capture_overflow( error_id_int, std::size_t );
+    inline void serialize_capture_overflow( encoder &, error_id const &, std::size_t );
+    inline void serialize_capture_overflow( fingerprint_builder &, error_id const &, std::size_t );
+
+    // Under BOOST_LEAF_CFG_CAPTURE_BUDGET, captured objects are stored in a
+    // fixed-capacity buffer embedded in the capture_list itself (that is, in
+    // the try_capture_all frame, and then in the returned result<T>), so no
+    // memory is ever allocated dynamically. Each entry is a pointer to the
+    // capture_entry_ops for the type of the object, followed by the (suitably
+    // aligned) object itself. Offsets are relative to the beginning of the
+    // buffer, so entries keep their layout when moved to another capture_list.
+    //
+    // Objects that do not fit (or are over-aligned) are dropped, and the count
+    // of dropped objects is communicated as e_capture_overflow.
     class capture_list
     {
         capture_list( capture_list const & ) = delete;
         capture_list & operator=( capture_list const & ) = delete;
 
-    protected:
+        using entry = capture_entry_ops const *;
+
+        std::size_t size_;
+        std::size_t dropped_;
+        alignas(std::max_align_t) unsigned char buf_[BOOST_LEAF_CFG_CAPTURE_BUDGET];
+
+        static std::size_t align_up( std::size_t n, std::size_t align ) noexcept
+        {
+            BOOST_LEAF_ASSERT(align && !(align & (align - 1)));
+            return (n + align - 1) & ~(align - 1);
+        }
 
-        class node
+        entry & ops_at( std::size_t e ) const noexcept
         {
-            friend class capture_list;
+            return *reinterpret_cast<entry *>(const_cast<unsigned char *>(buf_ + e));
+        }
 
-            virtual void unload( int err_id ) = 0;
-            virtual void serialize_to_(encoder &, error_id const &) const = 0;
+        std::size_t object( std::size_t e ) const noexcept
+        {
+            return align_up(e + sizeof(entry), ops_at(e)->align);
+        }
 
-        protected:
+        std::size_t next( std::size_t e ) const noexcept
+        {
+            return align_up(object(e) + ops_at(e)->size, alignof(entry));
+        }
+
+    protected:
 
-            virtual ~node() noexcept
+        template <class F>
+        void for_each( F f ) const
+        {
+            for( std::size_t e = 0; e != size_; e = next(e) )
+                f(*ops_at(e), const_cast<unsigned char *>(buf_ + object(e)));
+        }
+
+        // Upper bound of the space an entry for objects described by ops
+        // requires.
+        static constexpr std::size_t max_entry_size( std::size_t size, std::size_t align ) noexcept
+        {
+            return sizeof(entry) + align - 1 + size + alignof(entry) - 1;
+        }
+
+        // Returns uninitialized storage for an object described by ops, or
+        // null (counting the object as dropped) if there is no room for it,
+        // while leaving at least headroom bytes available. The caller must
+        // initialize the object.
+        void * push( capture_entry_ops const & ops, std::size_t headroom = 0 ) noexcept
+        {
+            std::size_t const obj = align_up(size_ + sizeof(entry), ops.align);
+            if( ops.align > alignof(std::max_align_t) || obj + ops.size + headroom > sizeof(buf_) )
             {
-            };
+                ++dropped_;
+                return nullptr;
+            }
+            ops_at(size_) = &ops;
+            size_ = align_up(obj + ops.size, alignof(entry));
+            return buf_ + obj;
+        }
+
+        void clear() noexcept
+        {
+            for_each(
+                []( capture_entry_ops const & ops, void * obj )
+                {
+                    ops.destroy(obj);
+                } );
+            size_ = 0;
+            dropped_ = 0;
+        }
+
+    public:
 
-            node * next_;
+        capture_list() noexcept:
+            size_(0),
+            dropped_(0)
+        {
+        }
 
-            BOOST_LEAF_CONSTEXPR explicit node( node * * & last ) noexcept:
-                next_(nullptr)
+        capture_list( capture_list && other ) noexcept:
+            size_(other.size_),
+            dropped_(other.dropped_)
+        {
+            for( std::size_t e = 0; e != size_; e = next(e) )
             {
-                BOOST_LEAF_ASSERT(last != nullptr);
-                *last = this;
-                last = &next_;
+                ops_at(e) = other.ops_at(e);
+                std::size_t const obj = object(e);
+                ops_at(e)->move(buf_ + obj, other.buf_ + obj);
             }
-        } * first_;
+            other.size_ = 0;
+            other.dropped_ = 0;
+        }
+
+        ~capture_list() noexcept
+        {
+            clear();
+        }
+
+        std::size_t dropped() const noexcept
+        {
+            return dropped_;
+        }
+
+        void unload( error_id_int const err_id )
+        {
+            struct clear_on_exit
+            {
+                capture_list & cl;
+                ~clear_on_exit() noexcept { cl.clear(); }
+            } guard { *this };
+            tls::write_current_error_id(error_id_uint(err_id));
+            if( dropped_ )
+                load_capture_overflow(err_id, dropped_);
+            for_each(
+                [err_id]( capture_entry_ops const & ops, void * obj )
+                {
+                    ops.unload(obj, err_id); // last entry may throw
+                } );
+        }
+
+        void serialize_to(encoder & e, error_id const & id) const
+        {
+            for_each(
+                [&e, &id]( capture_entry_ops const & ops, void const * obj )
+                {
+                    ops.serialize_to(obj, e, id);
+                } );
+            if( dropped_ )
+                serialize_capture_overflow(e, id, dropped_);
+        }
+
+        void serialize_to(fingerprint_builder & fb, error_id const & id) const
+        {
+            for_each(
+                [&fb, &id]( capture_entry_ops const & ops, void const * obj )
+                {
+                    ops.fingerprint_to(obj, fb, id);
+                } );
+            if( dropped_ )
+                serialize_capture_overflow(fb, id, dropped_);
+        }
+    }; // class capture_list
+
+#else // #if BOOST_LEAF_CFG_CAPTURE_BUDGET
+
+    // A contiguous block of memory storing captured objects of different
+    // types. Each entry is a pointer to the capture_entry_ops for the type of
+    // the object, followed by the (suitably aligned) object itself. Entries are
+    // never moved while in the chunk, so their addresses remain stable.
+    class capture_chunk
+    {
+        capture_chunk( capture_chunk const & ) = delete;
+        capture_chunk & operator=( capture_chunk const & ) = delete;
+
+        using entry = capture_entry_ops const *;
+
+        char * end_;
+        char * const limit_;
+#if BOOST_LEAF_CFG_STD_PMR
+        std::pmr::memory_resource * const mr_;
+#endif
+
+        static char * align_up( char * p, std::size_t align ) noexcept
+        {
+            BOOST_LEAF_ASSERT(align && !(align & (align - 1)));
+            return p + ((std::uintptr_t(0) - reinterpret_cast<std::uintptr_t>(p)) & (align - 1));
+        }
+
+        static void * object( char * e ) noexcept
+        {
+            return align_up(e + sizeof(entry), (*reinterpret_cast<entry *>(e))->align);
+        }
+
+        static char * next( char * e ) noexcept
+        {
+            return align_up(static_cast<char *>(object(e)) + (*reinterpret_cast<entry *>(e))->size, alignof(entry));
+        }
+
+        char * begin() const noexcept
+        {
+            return const_cast<char *>(reinterpret_cast<char const *>(this + 1));
+        }
+
+    public:
+
+        capture_chunk * next_chunk;
+
+#if BOOST_LEAF_CFG_STD_PMR
+        capture_chunk( std::size_t capacity, std::pmr::memory_resource * mr ) noexcept:
+            end_(begin()),
+            limit_(begin() + capacity),
+            mr_(mr),
+            next_chunk(nullptr)
+        {
+        }
+#else
+        explicit capture_chunk( std::size_t capacity ) noexcept:
+            end_(begin()),
+            limit_(begin() + capacity),
+            next_chunk(nullptr)
+        {
+        }
+#endif
+
+        ~capture_chunk() noexcept
+        {
+            clear();
+        }
+
+        // Upper bound of the space an entry for objects described by ops
+        // requires, regardless of the alignment of the chunk.
+        static std::size_t max_entry_size( capture_entry_ops const & ops ) noexcept
+        {
+            return sizeof(entry) + ops.align - 1 + ops.size + alignof(entry) - 1;
+        }
+
+#if BOOST_LEAF_CFG_STD_PMR
+        // If mr is null, memory is allocated with ::operator new.
+        static capture_chunk * new_( std::size_t capacity, std::pmr::memory_resource * mr )
+        {
+            void * p = mr ?
+                mr->allocate(sizeof(capture_chunk) + capacity, alignof(capture_chunk)) :
+                ::operator new(sizeof(capture_chunk) + capacity);
+            return new (p) capture_chunk(capacity, mr);
+        }
+
+        static void delete_( capture_chunk * c ) noexcept
+        {
+            std::pmr::memory_resource * mr = c->mr_;
+            std::size_t size = sizeof(capture_chunk) + c->capacity();
+            c->~capture_chunk();
+            if( mr )
+                mr->deallocate(c, size, alignof(capture_chunk));
+            else
+                ::operator delete(c);
+        }
+#else
+        static capture_chunk * new_( std::size_t capacity )
+        {
+            return new (::operator new(sizeof(capture_chunk) + capacity)) capture_chunk(capacity);
+        }
+
+        static void delete_( capture_chunk * c ) noexcept
+        {
+            c->~capture_chunk();
+            ::operator delete(c);
+        }
+#endif
+
+        std::size_t capacity() const noexcept
+        {
+            return std::size_t(limit_ - begin());
+        }
+
+        // Returns uninitialized storage for an object described by ops, or
+        // null if the chunk is full. The caller must initialize the object.
+        void * push( capture_entry_ops const & ops ) noexcept
+        {
+            char * e = align_up(end_, alignof(entry));
+            char * obj = align_up(e + sizeof(entry), ops.align);
+            if( obj + ops.size > limit_ )
+                return nullptr;
+            *reinterpret_cast<entry *>(e) = &ops;
+            end_ = align_up(obj + ops.size, alignof(entry));
+            return obj;
+        }
+
+        template <class F>
+        void for_each( F f ) const
+        {
+            for( char * e = begin(); e != end_; e = next(e) )
+                f(**reinterpret_cast<entry *>(e), object(e));
+        }
+
+        void clear() noexcept
+        {
+            for_each(
+                []( capture_entry_ops const & ops, void * obj )
+                {
+                    ops.destroy(obj);
+                } );
+            end_ = begin();
+        }
+    }; // class capture_chunk
+
+    // A list of capture_chunks, storing the objects captured by
+    // try_capture_all. Typically there is only one chunk.
+    class capture_list
+    {
+        capture_list( capture_list const & ) = delete;
+        capture_list & operator=( capture_list const & ) = delete;
+
+    protected:
+
+        capture_chunk * first_;
 
         template <class F>
-        BOOST_LEAF_CONSTEXPR void for_each( F f ) const
+        void for_each( F f ) const
         {
-            for( node * p=first_; p; p=p->next_ )
-                f(*p);
+            for( capture_chunk const * c = first_; c; c = c->next_chunk )
+                c->for_each(f);
         }
 
     public:
 
-        BOOST_LEAF_CONSTEXPR explicit capture_list( node * first ) noexcept:
+        BOOST_LEAF_CONSTEXPR explicit capture_list( capture_chunk * first ) noexcept:
             first_(first)
         {
         }
@@ -70,39 +379,47 @@ namespace detail
 
         ~capture_list() noexcept
         {
-            for( node const * p = first_; p; )
+            for( capture_chunk * c = first_; c; )
             {
-                node const * n = p -> next_;
-                delete p;
-                p = n;
+                capture_chunk * n = c->next_chunk;
+                capture_chunk::delete_(c);
+                c = n;
             }
         }
 
-        void unload( int const err_id )
+        void unload( error_id_int const err_id )
         {
             capture_list moved(first_);
             first_ = nullptr;
-            tls::write_current_error_id(unsigned(err_id));
+            tls::write_current_error_id(error_id_uint(err_id));
             moved.for_each(
-                [err_id]( node & n )
+                [err_id]( capture_entry_ops const & ops, void * obj )
                 {
-                    n.unload(err_id); // last node may throw
+                    ops.unload(obj, err_id); // last entry may throw
                 } );
         }
 
         void serialize_to(encoder & e, error_id const & id) const
         {
-            if( first_ )
-            {
-                for_each(
-                    [&e, &id]( node const & n )
-                    {
-                        n.serialize_to_(e, id);
-                    } );
-            }
+            for_each(
+                [&e, &id]( capture_entry_ops const & ops, void const * obj )
+                {
+                    ops.serialize_to(obj, e, id);
+                } );
+        }
+
+        void serialize_to(fingerprint_builder & fb, error_id const & id) const
+        {
+            for_each(
+                [&fb, &id]( capture_entry_ops const & ops, void const * obj )
+                {
+                    ops.fingerprint_to(obj, fb, id);
+                } );
         }
     }; // class capture_list
 
+#endif // #else (#if BOOST_LEAF_CFG_CAPTURE_BUDGET)
+
 } // namespace detail
 
 } } // namespace boost::leaf
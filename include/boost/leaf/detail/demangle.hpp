@@ -40,6 +40,12 @@
 #   endif
 #endif
 
+#if BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME
+#   define BOOST_LEAF_TYPE_NAME_CONSTEXPR constexpr
+#else
+#   define BOOST_LEAF_TYPE_NAME_CONSTEXPR
+#endif
+
 namespace boost { namespace leaf {
 
 namespace detail
@@ -112,7 +118,7 @@ namespace detail
     ////////////////////////////////////////
 
     template <std::size_t S>
-    BOOST_LEAF_ALWAYS_INLINE std::size_t compute_hash(char const (&str)[S], std::size_t begin, std::size_t end) noexcept
+    BOOST_LEAF_ALWAYS_INLINE BOOST_LEAF_TYPE_NAME_CONSTEXPR std::size_t compute_hash(char const (&str)[S], std::size_t begin, std::size_t end) noexcept
     {
         std::size_t h = 2166136261u;
         for( std::size_t i = begin; i != end; ++i )
@@ -136,8 +142,10 @@ namespace n
 #   define BOOST_LEAF_CDECL
 #endif
 
+    // Under BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME, p is constexpr, which gcc
+    // includes in __PRETTY_FUNCTION__.
     template <class T>
-    BOOST_LEAF_ALWAYS_INLINE r BOOST_LEAF_CDECL p()
+    BOOST_LEAF_ALWAYS_INLINE BOOST_LEAF_TYPE_NAME_CONSTEXPR r BOOST_LEAF_CDECL p()
     {
         // C++11 compile-time parsing of __PRETTY_FUNCTION__/__FUNCSIG__. The sizeof hacks are a
         // workaround for older GCC versions, where __PRETTY_FUNCTION__ is not constexpr, which triggers
@@ -159,6 +167,9 @@ namespace n
         // gcc style:
         std::size_t const p05 = BOOST_LEAF_P("boost::leaf::n::r boost::leaf::n::p() [with T = ");
         std::size_t const p06 = BOOST_LEAF_P("boost::leaf::n::r __cdecl boost::leaf::n::p() [with T = ");
+        // gcc style, constexpr:
+        std::size_t const p11 = BOOST_LEAF_P("constexpr boost::leaf::n::r boost::leaf::n::p() [with T = ");
+        std::size_t const p12 = BOOST_LEAF_P("constexpr boost::leaf::n::r __cdecl boost::leaf::n::p() [with T = ");
         // msvc style, struct:
         std::size_t const p07 = BOOST_LEAF_P("struct boost::leaf::n::r __cdecl boost::leaf::n::p<struct ");
         // msvc style, class:
@@ -178,16 +189,16 @@ namespace n
 
         char static_assert_unrecognized_pretty_function_format_please_file_github_issue[sizeof(
             char[
-                (s01 && (1 == (!!p01 + !!p02 + !!p03 + !!p04 + !!p05 + !!p06)))
+                (s01 && (1 == (!!p01 + !!p02 + !!p03 + !!p04 + !!p05 + !!p06 + !!p11 + !!p12)))
                 ||
                 (s02 && (1 == (!!p07 + !!p08 + !!p09)))
                 ||
                 (s02 && !!p10)
             ]
-        ) * 2 - 1];
+        ) * 2 - 1] = { };
         (void) static_assert_unrecognized_pretty_function_format_please_file_github_issue;
 
-        if( std::size_t const p = sizeof(char[1 + !!s01 * (p01 + p02 + p03 + p04 + p05 + p06)]) - 1 )
+        if( std::size_t const p = sizeof(char[1 + !!s01 * (p01 + p02 + p03 + p04 + p05 + p06 + p11 + p12)]) - 1 )
             return { BOOST_LEAF_PRETTY_FUNCTION + p, s01 - p, detail::compute_hash(BOOST_LEAF_PRETTY_FUNCTION, p, s01) };
 
         if( std::size_t const p = sizeof(char[1 + !!s02 * (p07 + p08 + p09)]) - 1 )
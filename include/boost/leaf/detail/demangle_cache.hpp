@@ -0,0 +1,167 @@
+#ifndef BOOST_LEAF_DETAIL_DEMANGLE_CACHE_HPP_INCLUDED
+#define BOOST_LEAF_DETAIL_DEMANGLE_CACHE_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/detail/demangle.hpp>
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+
+#include <cstddef>
+#include <cstdint>
+#include <typeinfo>
+
+#if BOOST_LEAF_CFG_DEMANGLE_CACHE && defined(BOOST_LEAF_HAS_CXXABI_H) && !defined(BOOST_LEAF_NO_THREADS)
+#   include <atomic>
+#endif
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+#if BOOST_LEAF_CFG_DEMANGLE_CACHE && defined(BOOST_LEAF_HAS_CXXABI_H)
+
+    // Demangled names of the dynamic types of exceptions, kept for the life
+    // of the process, so that after the first occurrence of a given type,
+    // demangling takes a single lookup rather than a call to __cxa_demangle
+    // and a malloc / free pair.
+    //
+    // The cache is a hash table of singly-linked lists, keyed on the address
+    // of the std::type_info object. Nodes are never modified or freed once
+    // published, so readers need no synchronization beyond an acquire load
+    // of the list head. Writers push new nodes with compare-and-swap; if two
+    // threads demangle the same type at the same time, the loser discards
+    // its node.
+    template <int = 0>
+    class demangle_cache
+    {
+        struct node
+        {
+            std::type_info const * type;
+            char const * name;
+            node * next;
+        };
+
+#ifdef BOOST_LEAF_NO_THREADS
+        struct head
+        {
+            node * x;
+            node * load() const noexcept { return x; }
+        };
+
+        static bool push( head & h, node * & expected, node * n ) noexcept
+        {
+            BOOST_LEAF_ASSERT(h.x == expected);
+            h.x = n;
+            return true;
+        }
+#else
+        using head = std::atomic<node *>;
+
+        static bool push( head & h, node * & expected, node * n ) noexcept
+        {
+            return h.compare_exchange_weak(expected, n, std::memory_order_release, std::memory_order_acquire);
+        }
+#endif
+
+        static head buckets_[BOOST_LEAF_CFG_DEMANGLE_CACHE];
+
+        static char const * find( node const * first, node const * last, std::type_info const * type ) noexcept
+        {
+            for( ; first != last; first = first->next )
+                if( first->type == type )
+                    return first->name;
+            return nullptr;
+        }
+
+    public:
+
+        // Returns the demangled name of type, or type.name() if it can not
+        // be demangled. The returned pointer is valid for the life of the
+        // process.
+        static char const * get( std::type_info const & type ) noexcept
+        {
+            std::type_info const * t = &type;
+            head & h = buckets_[(std::size_t(reinterpret_cast<std::uintptr_t>(t)) >> 4) % BOOST_LEAF_CFG_DEMANGLE_CACHE];
+#ifdef BOOST_LEAF_NO_THREADS
+            node * first = h.load();
+#else
+            node * first = h.load(std::memory_order_acquire);
+#endif
+            if( char const * name = find(first, nullptr, t) )
+                return name;
+
+            int status = 0;
+            char * demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+            node * n = static_cast<node *>(std::malloc(sizeof(node)));
+            if( !n )
+            {
+                std::free(demangled);
+                return type.name();
+            }
+            n->type = t;
+            n->name = demangled ? demangled : type.name();
+            n->next = first;
+            while( !push(h, n->next, n) )
+                if( char const * name = find(n->next, first, t) )
+                {
+                    std::free(demangled);
+                    std::free(n);
+                    return name;
+                }
+                else
+                    first = n->next;
+            return n->name;
+        }
+    };
+
+    template <int I>
+    typename demangle_cache<I>::head demangle_cache<I>::buckets_[BOOST_LEAF_CFG_DEMANGLE_CACHE];
+
+    class type_info_demangler
+    {
+        char const * name_;
+
+    public:
+
+        explicit type_info_demangler( std::type_info const & type ) noexcept:
+            name_(demangle_cache<>::get(type))
+        {
+        }
+
+        char const * get() const noexcept
+        {
+            return name_;
+        }
+    };
+
+#else // #if BOOST_LEAF_CFG_DEMANGLE_CACHE && defined(BOOST_LEAF_HAS_CXXABI_H)
+
+    class type_info_demangler
+    {
+        demangler d_;
+
+    public:
+
+        explicit type_info_demangler( std::type_info const & type ) noexcept:
+            d_(type.name())
+        {
+        }
+
+        char const * get() const noexcept
+        {
+            return d_.get();
+        }
+    };
+
+#endif // #else (#if BOOST_LEAF_CFG_DEMANGLE_CACHE && defined(BOOST_LEAF_HAS_CXXABI_H))
+} // namespace detail
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_NO_EXCEPTIONS
+
+#endif // #ifndef BOOST_LEAF_DETAIL_DEMANGLE_CACHE_HPP_INCLUDED
@@ -0,0 +1,179 @@
+#ifndef BOOST_LEAF_DETAIL_DYNAMIC_CAST_CACHE_HPP_INCLUDED
+#define BOOST_LEAF_DETAIL_DYNAMIC_CAST_CACHE_HPP_INCLUDED
+
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <typeinfo>
+
+#if BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE && !defined(BOOST_LEAF_NO_THREADS)
+#   include <atomic>
+#endif
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+#if BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE
+
+    template <class Ex>
+    std::ptrdiff_t dynamic_cast_offset( std::exception const & ex ) noexcept
+    {
+        if( Ex const * p = dynamic_cast<Ex const *>(&ex) )
+            return reinterpret_cast<char const *>(p) - reinterpret_cast<char const *>(&ex);
+        return PTRDIFF_MIN;
+    }
+
+    // For a given dynamic type, and a given std::exception subobject of it,
+    // the result of dynamic_cast to any other type is at a fixed offset (or
+    // it is always null). dynamic_cast_cache<Ex...> remembers these offsets
+    // for the most recently seen dynamic types, in a small direct-mapped
+    // table keyed on typeid(ex), so that after the first occurrence of a
+    // given dynamic type, casting to all of Ex... takes a single lookup.
+    //
+    // Entries are never invalidated. If a shared library is unloaded, and
+    // another is loaded at the same address, a std::type_info of the new
+    // library may have the address of one of the old library, and the cached
+    // offsets would be applied to an unrelated type. Comparing the cached
+    // std::type_info to typeid(ex) cannot detect this (they are the same
+    // object), therefore programs which unload libraries that throw exceptions
+    // must define BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE as 0.
+    //
+    // Entries are shared by all threads. Each entry is protected by a
+    // sequence counter: it is odd while the entry is being written; readers
+    // which observe a change of the counter treat the entry as a miss, and
+    // writers which find it odd do not update the cache.
+    template <class... Ex>
+    class dynamic_cast_cache
+    {
+        constexpr static std::size_t count = sizeof...(Ex);
+
+#ifdef BOOST_LEAF_NO_THREADS
+        template <class T>
+        struct cell
+        {
+            T x;
+            T load( int = 0 ) const noexcept { return x; }
+            void store( T v, int = 0 ) noexcept { x = v; }
+        };
+
+        static void fence_acquire() noexcept { }
+        static void fence_release() noexcept { }
+        enum { relaxed, acquire, release };
+#else
+        template <class T>
+        using cell = std::atomic<T>;
+
+        static void fence_acquire() noexcept { std::atomic_thread_fence(std::memory_order_acquire); }
+        static void fence_release() noexcept { std::atomic_thread_fence(std::memory_order_release); }
+        constexpr static std::memory_order relaxed = std::memory_order_relaxed;
+        constexpr static std::memory_order acquire = std::memory_order_acquire;
+        constexpr static std::memory_order release = std::memory_order_release;
+#endif
+
+        struct entry
+        {
+            cell<unsigned> seq;
+            cell<std::type_info const *> type;
+            cell<std::ptrdiff_t> top;
+            cell<std::ptrdiff_t> offset[count];
+        };
+
+        static entry entries_[BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE];
+
+        static bool load( entry const & e, std::type_info const * type, std::ptrdiff_t top, std::ptrdiff_t (&offset)[count] ) noexcept
+        {
+            unsigned const s = e.seq.load(acquire);
+            if( (s & 1) || e.type.load(relaxed) != type || e.top.load(relaxed) != top )
+                return false;
+            for( std::size_t i = 0; i != count; ++i )
+                offset[i] = e.offset[i].load(relaxed);
+            fence_acquire();
+            return e.seq.load(relaxed) == s;
+        }
+
+        static void store( entry & e, std::type_info const * type, std::ptrdiff_t top, std::ptrdiff_t const (&offset)[count] ) noexcept
+        {
+            unsigned const s = e.seq.load(relaxed);
+            if( s & 1 )
+                return;
+#ifdef BOOST_LEAF_NO_THREADS
+            e.seq.store(s + 1);
+#else
+            unsigned expected = s;
+            if( !e.seq.compare_exchange_strong(expected, s + 1, relaxed) )
+                return;
+#endif
+            fence_release();
+            e.type.store(type, relaxed);
+            e.top.store(top, relaxed);
+            for( std::size_t i = 0; i != count; ++i )
+                e.offset[i].store(offset[i], relaxed);
+            e.seq.store(s + 2, release);
+        }
+
+    public:
+
+        // Sets p[i] to the result of dynamic_cast to the i-th of Ex...
+        static void cast( std::exception const & ex, void const * (&p)[count] ) noexcept
+        {
+            std::type_info const * type = &typeid(ex);
+            char const * x = reinterpret_cast<char const *>(&ex);
+            std::ptrdiff_t const top = x - static_cast<char const *>(dynamic_cast<void const *>(&ex));
+            std::size_t const h = (std::size_t(reinterpret_cast<std::uintptr_t>(type)) >> 4) + std::size_t(top);
+            entry & e = entries_[h % BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE];
+            std::ptrdiff_t offset[count];
+            if( !load(e, type, top, offset) )
+            {
+                std::ptrdiff_t const computed[count] = { dynamic_cast_offset<Ex>(ex)... };
+                for( std::size_t i = 0; i != count; ++i )
+                    offset[i] = computed[i];
+                store(e, type, top, computed);
+            }
+            for( std::size_t i = 0; i != count; ++i )
+                p[i] = offset[i] == PTRDIFF_MIN ? nullptr : x + offset[i];
+        }
+    };
+
+    template <class... Ex>
+    typename dynamic_cast_cache<Ex...>::entry dynamic_cast_cache<Ex...>::entries_[BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE];
+
+#else // #if BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE
+
+    template <class... Ex>
+    class dynamic_cast_cache
+    {
+    public:
+
+        static void cast( std::exception const & ex, void const * (&p)[sizeof...(Ex)] ) noexcept
+        {
+            void const * const r[sizeof...(Ex)] = { static_cast<void const *>(dynamic_cast<Ex const *>(&ex))... };
+            for( std::size_t i = 0; i != sizeof...(Ex); ++i )
+                p[i] = r[i];
+        }
+    };
+
+#endif // #else (#if BOOST_LEAF_CFG_DYNAMIC_CAST_CACHE)
+
+    template <class Ex>
+    Ex const * cached_dynamic_cast( std::exception const & ex ) noexcept
+    {
+        void const * p[1];
+        dynamic_cast_cache<Ex>::cast(ex, p);
+        return static_cast<Ex const *>(p[0]);
+    }
+} // namespace detail
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_NO_EXCEPTIONS
+
+#endif // #ifndef BOOST_LEAF_DETAIL_DYNAMIC_CAST_CACHE_HPP_INCLUDED
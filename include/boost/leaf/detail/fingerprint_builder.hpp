@@ -0,0 +1,156 @@
+#ifndef BOOST_LEAF_DETAIL_FINGERPRINT_BUILDER_HPP_INCLUDED
+#define BOOST_LEAF_DETAIL_FINGERPRINT_BUILDER_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/detail/encoder.hpp>
+#include <boost/leaf/detail/type_name.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if BOOST_LEAF_CFG_STD_STRING
+#   include <string>
+#endif
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+#   include <exception>
+#   include <typeinfo>
+#endif
+
+namespace boost { namespace leaf {
+
+class error_id;
+
+namespace detail
+{
+    inline std::uint64_t fingerprint_mix( std::uint64_t x ) noexcept
+    {
+        // The splitmix64 finalizer.
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // 64-bit FNV-1a.
+    inline std::uint64_t fingerprint_hash( char const * s, std::size_t n ) noexcept
+    {
+        std::uint64_t h = 14695981039346656037ull;
+        for( std::size_t i = 0; i != n; ++i )
+        {
+            h ^= static_cast<unsigned char>(s[i]);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    inline std::uint64_t fingerprint_hash( char const * s ) noexcept
+    {
+        std::uint64_t h = 14695981039346656037ull;
+        for( ; s && *s; ++s )
+        {
+            h ^= static_cast<unsigned char>(*s);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    template <int N> struct fingerprint_rank: fingerprint_rank<N - 1> { };
+    template <> struct fingerprint_rank<0> { };
+
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, std::uint64_t>::type
+    fingerprint_key( T const & x, fingerprint_rank<2> ) noexcept
+    {
+        return static_cast<std::uint64_t>(x);
+    }
+
+    inline std::uint64_t fingerprint_key( char const * s, fingerprint_rank<2> ) noexcept
+    {
+        return fingerprint_hash(s);
+    }
+
+#if BOOST_LEAF_CFG_STD_STRING
+    inline std::uint64_t fingerprint_key( std::string const & s, fingerprint_rank<2> ) noexcept
+    {
+        return fingerprint_hash(s.data(), s.size());
+    }
+#endif
+
+    template <class T>
+    auto fingerprint_key( T const & x, fingerprint_rank<1> ) noexcept -> decltype(fingerprint_key(x.value, fingerprint_rank<2>()))
+    {
+        return fingerprint_key(x.value, fingerprint_rank<2>());
+    }
+
+    template <class T>
+    std::uint64_t fingerprint_key( T const &, fingerprint_rank<0> ) noexcept
+    {
+        return 0;
+    }
+
+    // An encoder which, rather than serializing error objects, combines the
+    // hashes of their type names (computed at compile time, see type_name),
+    // independently of the order in which they are visited. The value of the
+    // error object of the key type (if any) is hashed as well, if it (or its
+    // value member) is of integral, enum or string type.
+    class fingerprint_builder: public encoder
+    {
+        fingerprint_builder( fingerprint_builder const & ) = delete;
+        fingerprint_builder & operator=( fingerprint_builder const & ) = delete;
+
+        std::uint64_t types_;
+        std::uint64_t key_value_;
+        std::size_t const key_hash_;
+        bool const has_key_;
+
+    public:
+
+        template <class Key>
+        explicit fingerprint_builder( Key const * ) noexcept:
+            encoder(this),
+            types_(0),
+            key_value_(0),
+            key_hash_(get_type_name<Key>().hash),
+            has_key_(!std::is_void<Key>::value)
+        {
+        }
+
+        template <class T>
+        void add( T const & x ) noexcept
+        {
+            std::size_t const h = get_type_name<T>().hash;
+            types_ += fingerprint_mix(h);
+            if( has_key_ && h == key_hash_ )
+                key_value_ = fingerprint_mix(fingerprint_key(x, fingerprint_rank<2>()) + 1);
+        }
+
+        // Error ids differ between occurrences of the same error.
+        void add( error_id const & ) noexcept
+        {
+        }
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+        void add( std::exception const & ex ) noexcept
+        {
+            types_ += fingerprint_mix(fingerprint_hash(typeid(ex).name()));
+        }
+#endif
+
+        std::uint64_t value() const noexcept
+        {
+            return fingerprint_mix(types_ ^ fingerprint_mix(key_value_));
+        }
+    };
+} // namespace detail
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_DETAIL_FINGERPRINT_BUILDER_HPP_INCLUDED
@@ -0,0 +1,125 @@
+#ifndef BOOST_LEAF_DETAIL_MEMBER_NAMES_HPP_INCLUDED
+#define BOOST_LEAF_DETAIL_MEMBER_NAMES_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+    // 32-bit FNV-1a, written recursively so that it is constexpr in C++11.
+    constexpr std::uint32_t fnv1a_32( char const * s, std::size_t n, std::uint32_t h ) noexcept
+    {
+        return n ? fnv1a_32(s + 1, n - 1, (h ^ static_cast<std::uint32_t>(*s)) * 16777619u) : h;
+    }
+
+    constexpr std::uint32_t fnv1a_32( char const * s, std::uint32_t h ) noexcept
+    {
+        return *s ? fnv1a_32(s + 1, (h ^ static_cast<std::uint32_t>(*s)) * 16777619u) : h;
+    }
+} // namespace detail
+
+namespace serialization
+{
+    // The numeric id cbor_encoder writes in place of the name passed to
+    // output_at. This is the 32-bit FNV-1a hash of the name, which for error
+    // object types equals the low 32 bits of detail::type_name::hash.
+    constexpr std::uint32_t cbor_id( char const * name, std::size_t length ) noexcept
+    {
+        return detail::fnv1a_32(name, length, 2166136261u);
+    }
+
+    constexpr std::uint32_t cbor_id( char const * name ) noexcept
+    {
+        return detail::fnv1a_32(name, 2166136261u);
+    }
+
+    // A name passed to serialize or output_at, together with its cbor_id.
+    // LEAF passes the names of error types and of the members of its own
+    // error types as name_id objects, with the id computed at compile time;
+    // it converts to char const *, for encoders which only use the name.
+    struct name_id
+    {
+        char const * name;
+        std::uint32_t id;
+
+        constexpr explicit name_id( char const * n ) noexcept:
+            name(n),
+            id(cbor_id(n))
+        {
+        }
+
+        constexpr name_id( char const * n, std::uint32_t i ) noexcept:
+            name(n),
+            id(i)
+        {
+        }
+
+        constexpr operator char const *() const noexcept
+        {
+            return name;
+        }
+    };
+} // namespace serialization
+
+namespace detail
+{
+    // The names of the members of the error types LEAF serializes, used by
+    // their output functions and registered by cbor_names. New names must be
+    // added to all as well.
+    template <class = void>
+    struct member_names_
+    {
+        static constexpr serialization::name_id file{"file"};
+        static constexpr serialization::name_id line{"line"};
+        static constexpr serialization::name_id function{"function"};
+        static constexpr serialization::name_id errno_{"errno"};
+        static constexpr serialization::name_id strerror{"strerror"};
+        static constexpr serialization::name_id category{"category"};
+        static constexpr serialization::name_id value{"value"};
+        static constexpr serialization::name_id message{"message"};
+        static constexpr serialization::name_id dynamic_type{"dynamic_type"};
+        static constexpr serialization::name_id what{"what"};
+        static constexpr serialization::name_id dropped{"dropped"};
+        static constexpr serialization::name_id frames{"frames"};
+        static constexpr serialization::name_id address{"address"};
+        static constexpr serialization::name_id module{"module"};
+        static constexpr serialization::name_id module_offset{"module_offset"};
+
+        static constexpr serialization::name_id const * all[] =
+        {
+            &file, &line, &function, &errno_, &strerror, &category, &value, &message,
+            &dynamic_type, &what, &dropped, &frames, &address, &module, &module_offset
+        };
+    };
+
+    template <class T> constexpr serialization::name_id member_names_<T>::file;
+    template <class T> constexpr serialization::name_id member_names_<T>::line;
+    template <class T> constexpr serialization::name_id member_names_<T>::function;
+    template <class T> constexpr serialization::name_id member_names_<T>::errno_;
+    template <class T> constexpr serialization::name_id member_names_<T>::strerror;
+    template <class T> constexpr serialization::name_id member_names_<T>::category;
+    template <class T> constexpr serialization::name_id member_names_<T>::value;
+    template <class T> constexpr serialization::name_id member_names_<T>::message;
+    template <class T> constexpr serialization::name_id member_names_<T>::dynamic_type;
+    template <class T> constexpr serialization::name_id member_names_<T>::what;
+    template <class T> constexpr serialization::name_id member_names_<T>::dropped;
+    template <class T> constexpr serialization::name_id member_names_<T>::frames;
+    template <class T> constexpr serialization::name_id member_names_<T>::address;
+    template <class T> constexpr serialization::name_id member_names_<T>::module;
+    template <class T> constexpr serialization::name_id member_names_<T>::module_offset;
+    template <class T> constexpr serialization::name_id const * member_names_<T>::all[];
+
+    using member_names = member_names_<>;
+} // namespace detail
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_DETAIL_MEMBER_NAMES_HPP_INCLUDED
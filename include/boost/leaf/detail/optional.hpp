@@ -15,7 +15,7 @@ namespace detail
     template <class T>
     class optional
     {
-        int key_;
+        error_id_int key_;
         union { T value_; };
 
     public:
@@ -44,14 +44,14 @@ namespace detail
             }
         }
 
-        BOOST_LEAF_CONSTEXPR optional( int key, T const & v ):
+        BOOST_LEAF_CONSTEXPR optional( error_id_int key, T const & v ):
             key_(key),
             value_(v)
         {
             BOOST_LEAF_ASSERT(!empty());
         }
 
-        BOOST_LEAF_CONSTEXPR optional( int key, T && v ) noexcept:
+        BOOST_LEAF_CONSTEXPR optional( error_id_int key, T && v ) noexcept:
             key_(key),
             value_(std::move(v))
         {
@@ -61,7 +61,7 @@ namespace detail
         BOOST_LEAF_CONSTEXPR optional & operator=( optional const & x )
         {
             reset();
-            if( int key = x.key() )
+            if( error_id_int key = x.key() )
             {
                 load(key, x.value_);
                 key_ = key;
@@ -72,7 +72,7 @@ namespace detail
         BOOST_LEAF_CONSTEXPR optional & operator=( optional && x ) noexcept
         {
             reset();
-            if( int key = x.key() )
+            if( error_id_int key = x.key() )
             {
                 load(key, std::move(x.value_));
                 x.reset();
@@ -90,7 +90,7 @@ namespace detail
             return key_ == 0;
         }
 
-        BOOST_LEAF_CONSTEXPR int key() const noexcept
+        BOOST_LEAF_CONSTEXPR error_id_int key() const noexcept
         {
             return key_;
         }
@@ -104,7 +104,7 @@ namespace detail
             }
         }
 
-        BOOST_LEAF_CONSTEXPR T & load( int key )
+        BOOST_LEAF_CONSTEXPR T & load( error_id_int key )
         {
             BOOST_LEAF_ASSERT(key);
             reset();
@@ -113,7 +113,7 @@ namespace detail
             return value_;
         }
 
-        BOOST_LEAF_CONSTEXPR T & load( int key, T const & v )
+        BOOST_LEAF_CONSTEXPR T & load( error_id_int key, T const & v )
         {
             BOOST_LEAF_ASSERT(key);
             reset();
@@ -122,7 +122,7 @@ namespace detail
             return value_;
         }
 
-        BOOST_LEAF_CONSTEXPR T & load( int key, T && v ) noexcept
+        BOOST_LEAF_CONSTEXPR T & load( error_id_int key, T && v ) noexcept
         {
             BOOST_LEAF_ASSERT(key);
             reset();
@@ -131,40 +131,40 @@ namespace detail
             return value_;
         }
 
-        BOOST_LEAF_CONSTEXPR T const * has_value(int key) const noexcept
+        BOOST_LEAF_CONSTEXPR T const * has_value(error_id_int key) const noexcept
         {
             BOOST_LEAF_ASSERT(key);
             return key_ == key ? &value_ : nullptr;
         }
 
-        BOOST_LEAF_CONSTEXPR T * has_value(int key) noexcept
+        BOOST_LEAF_CONSTEXPR T * has_value(error_id_int key) noexcept
         {
             BOOST_LEAF_ASSERT(key);
             return key_ == key ? &value_ : nullptr;
         }
 
-        BOOST_LEAF_CONSTEXPR T const & value(int key) const & noexcept
+        BOOST_LEAF_CONSTEXPR T const & value(error_id_int key) const & noexcept
         {
             BOOST_LEAF_ASSERT(has_value(key) != 0);
             (void) key;
             return value_;
         }
 
-        BOOST_LEAF_CONSTEXPR T & value(int key) & noexcept
+        BOOST_LEAF_CONSTEXPR T & value(error_id_int key) & noexcept
         {
             BOOST_LEAF_ASSERT(has_value(key) != 0);
             (void) key;
             return value_;
         }
 
-        BOOST_LEAF_CONSTEXPR T const && value(int key) const && noexcept
+        BOOST_LEAF_CONSTEXPR T const && value(error_id_int key) const && noexcept
         {
             BOOST_LEAF_ASSERT(has_value(key) != 0);
             (void) key;
             return value_;
         }
 
-        BOOST_LEAF_CONSTEXPR T value(int key) && noexcept
+        BOOST_LEAF_CONSTEXPR T value(error_id_int key) && noexcept
         {
             BOOST_LEAF_ASSERT(has_value(key) != 0);
             (void) key;
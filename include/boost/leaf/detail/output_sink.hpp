@@ -0,0 +1,179 @@
+#ifndef BOOST_LEAF_DETAIL_OUTPUT_SINK_HPP_INCLUDED
+#define BOOST_LEAF_DETAIL_OUTPUT_SINK_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace boost { namespace leaf {
+
+namespace detail
+{
+    template <class T>
+    BOOST_LEAF_CONSTEXPR inline bool is_negative( T x, std::true_type ) noexcept
+    {
+        return x < 0;
+    }
+
+    template <class T>
+    BOOST_LEAF_CONSTEXPR inline bool is_negative( T, std::false_type ) noexcept
+    {
+        return false;
+    }
+
+    template <class T>
+    BOOST_LEAF_CONSTEXPR inline bool is_negative( T x ) noexcept
+    {
+        return is_negative(x, std::is_signed<T>());
+    }
+
+    // The absolute value of the integer x, as its unsigned type.
+    template <class T>
+    BOOST_LEAF_CONSTEXPR inline typename std::make_unsigned<T>::type magnitude( T x ) noexcept
+    {
+        using U = typename std::make_unsigned<T>::type;
+        return is_negative(x) ? U(U(0) - static_cast<U>(x)) : static_cast<U>(x);
+    }
+
+    // Detects std::string (and similar types) without including <string>, so
+    // that encoders write them as text regardless of BOOST_LEAF_CFG_STD_STRING.
+    template <class T, class = void>
+    struct is_char_string: std::false_type
+    {
+    };
+
+    template <class T>
+    struct is_char_string<T, typename std::enable_if<std::is_same<decltype(std::declval<T const &>().c_str()), char const *>::value>::type>: std::true_type
+    {
+    };
+
+    // The number of characters format_decimal may write for type T.
+    template <class T>
+    struct max_decimal_length: std::integral_constant<std::size_t, 3 * sizeof(T) + 1>
+    {
+    };
+
+    // Formats the integer x in decimal, into the max_decimal_length<T>
+    // characters before end. Returns a pointer to the first character.
+    template <class T>
+    char * format_decimal( char * end, T x ) noexcept
+    {
+        auto u = magnitude(x);
+        do
+            *--end = char('0' + u % 10);
+        while( u /= 10 );
+        if( is_negative(x) )
+            *--end = '-';
+        return end;
+    }
+
+    // The destination of streaming encoder output: either a caller-supplied
+    // buffer, or a user-supplied write function. Output which doesn't fit in
+    // the buffer is truncated, and size() keeps counting past the end, like
+    // snprintf. Text sinks keep the buffer zero-terminated; binary sinks use
+    // all of it.
+    class output_sink
+    {
+        output_sink( output_sink const & ) = delete;
+        output_sink & operator=( output_sink const & ) = delete;
+
+        char * const buf_;
+        std::size_t const capacity_;
+        bool const zero_terminate_;
+        void (* const write_)( void * state, char const * s, std::size_t n );
+        void * const state_;
+        std::size_t size_;
+
+    public:
+
+        output_sink() noexcept:
+            buf_(nullptr),
+            capacity_(0),
+            zero_terminate_(false),
+            write_(nullptr),
+            state_(nullptr),
+            size_(0)
+        {
+        }
+
+        output_sink( char * buf, std::size_t size, bool zero_terminate ) noexcept:
+            buf_(buf),
+            capacity_(size && zero_terminate ? size - 1 : size),
+            zero_terminate_(zero_terminate),
+            write_(nullptr),
+            state_(nullptr),
+            size_(0)
+        {
+            BOOST_LEAF_ASSERT(buf || !size);
+            if( size && zero_terminate )
+                *buf = 0;
+        }
+
+        output_sink( void (*write)( void * state, char const * s, std::size_t n ), void * state ) noexcept:
+            buf_(nullptr),
+            capacity_(0),
+            zero_terminate_(false),
+            write_(write),
+            state_(state),
+            size_(0)
+        {
+            BOOST_LEAF_ASSERT(write != nullptr);
+        }
+
+        static void write_file( void * f, char const * s, std::size_t n )
+        {
+            (void) std::fwrite(s, 1, n, static_cast<std::FILE *>(f));
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        void write( char const * s, std::size_t n )
+        {
+            if( write_ )
+                write_(state_, s, n);
+            else if( size_ < capacity_ )
+            {
+                std::size_t m = capacity_ - size_;
+                if( n < m )
+                    m = n;
+                std::memcpy(buf_ + size_, s, m);
+                if( zero_terminate_ )
+                    buf_[size_ + m] = 0;
+            }
+            size_ += n;
+        }
+
+        void write( char const * s )
+        {
+            write(s, std::strlen(s));
+        }
+
+        void put( char c )
+        {
+            write(&c, 1);
+        }
+
+        template <class T>
+        void write_decimal( T x )
+        {
+            char buf[max_decimal_length<T>::value];
+            char * p = format_decimal(buf + sizeof(buf), x);
+            write(p, static_cast<std::size_t>(buf + sizeof(buf) - p));
+        }
+    };
+} // namespace detail
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_DETAIL_OUTPUT_SINK_HPP_INCLUDED
@@ -44,12 +44,55 @@ namespace detail
         }
     };
 
+#if BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME
+
+    template <std::size_t N>
+    struct type_name_zstr
+    {
+        char data[N + 1];
+    };
+
+    template <std::size_t N>
+    constexpr type_name_zstr<N> make_type_name_zstr(char const * s) noexcept
+    {
+        type_name_zstr<N> z = { };
+        for( std::size_t i = 0; i != N; ++i )
+            z.data[i] = s[i];
+        return z;
+    }
+
+    // The name and hash of T are computed at compile time, and the name is
+    // stored in a zero-terminated static string.
+    template <class T>
+    struct type_name_constant
+    {
+        static constexpr n::r parsed = n::p<T>();
+        static constexpr type_name_zstr<parsed.length> zstr = make_type_name_zstr<parsed.length>(parsed.name_not_zero_terminated_at_length);
+        static constexpr type_name value = { zstr.data, parsed.length, parsed.hash };
+    };
+
+    template <class T>
+    constexpr type_name get_type_name() noexcept
+    {
+        return type_name_constant<T>::value;
+    }
+
+    template <class T>
+    constexpr char const * get_type_name_zstr() noexcept
+    {
+        return type_name_constant<T>::zstr.data;
+    }
+
+#else
+
     template <class T>
     type_name get_type_name()
     {
         n::r parsed = n::p<T>();
         return { parsed.name_not_zero_terminated_at_length, parsed.length, parsed.hash };
     }
+
+#endif
 } // namespace detail
 
 } } // namespace boost::leaf
@@ -44,6 +44,12 @@ public:
         serialize_to_(ea);
     }
 
+    friend void fingerprint_to_( detail::fingerprint_builder & fb, diagnostic_info const & x )
+    {
+        x.error_info::serialize_to_(fb);
+        x.serialize_to_(fb);
+    }
+
     template <class CharT, class Traits>
     friend std::ostream & operator<<( std::basic_ostream<CharT, Traits> & os, diagnostic_info const & x )
     {
@@ -55,6 +61,17 @@ public:
 #endif
         return os;
     }
+
+    friend std::size_t print_to( char * buf, std::size_t size, diagnostic_info const & x )
+    {
+        detail::buffer_writer w(buf, size, x.error(), x.source_location(), x.exception());
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+        x.serialize_to_(w);
+#else
+        w.stream() << "\nboost::leaf::diagnostic_info N/A due to BOOST_LEAF_CFG_DIAGNOSTICS=0";
+#endif
+        return w.finish();
+    }
 }; // class diagnostic_info
 
 namespace detail
@@ -117,6 +134,13 @@ public:
         serialize_to_(ea);
     }
 
+    friend void fingerprint_to_( detail::fingerprint_builder & fb, diagnostic_details const & x )
+    {
+        x.error_info::serialize_to_(fb);
+        x.diagnostic_info::serialize_to_(fb);
+        x.serialize_to_(fb);
+    }
+
     template <class CharT, class Traits>
     friend std::ostream & operator<<( std::basic_ostream<CharT, Traits> & os, diagnostic_details const & x )
     {
@@ -130,6 +154,19 @@ public:
 #endif
         return os;
     }
+
+    friend std::size_t print_to( char * buf, std::size_t size, diagnostic_details const & x )
+    {
+        detail::buffer_writer w(buf, size, x.error(), x.source_location(), x.exception());
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+        x.diagnostic_info::serialize_to_(w);
+        w.set_prefix("\nDiagnostic details:" BOOST_LEAF_CFG_DIAGNOSTICS_FIRST_DELIMITER);
+        x.serialize_to_(w);
+#else
+        w.stream() << "\nboost::leaf::diagnostic_details N/A due to BOOST_LEAF_CFG_DIAGNOSTICS=0";
+#endif
+        return w.finish();
+    }
 }; // class diagnostic_details
 
 namespace detail
@@ -191,6 +228,18 @@ public:
 #endif
         return os;
     }
+
+    friend std::size_t print_to( char * buf, std::size_t size, diagnostic_details const & x )
+    {
+        detail::buffer_writer w(buf, size, x.error(), x.source_location(), x.exception());
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+        x.diagnostic_info::serialize_to_(w);
+        w.stream() << "\nboost::leaf::diagnostic_details N/A due to BOOST_LEAF_CFG_CAPTURE=0";
+#else
+        w.stream() << "\nboost::leaf::diagnostic_details N/A due to BOOST_LEAF_CFG_DIAGNOSTICS=0";
+#endif
+        return w.finish();
+    }
 }; // class diagnostic_details
 
 namespace detail
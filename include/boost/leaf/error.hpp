@@ -10,6 +10,17 @@
 #include <boost/leaf/detail/function_traits.hpp>
 #include <boost/leaf/detail/capture_list.hpp>
 #include <boost/leaf/detail/diagnostics_writer.hpp>
+#include <boost/leaf/detail/buffer_writer.hpp>
+#include <boost/leaf/detail/fingerprint_builder.hpp>
+#include <boost/leaf/detail/member_names.hpp>
+
+#if BOOST_LEAF_CFG_CAPTURE
+#   include <chrono>
+#   include <cstdint>
+#   ifndef BOOST_LEAF_NO_THREADS
+#       include <atomic>
+#   endif
+#endif
 
 ////////////////////////////////////////
 
@@ -24,17 +35,17 @@ namespace serialization
     template <class Encoder>
     void output(Encoder & e, std::error_code const & x)
     {
-        output_at(e, x.category().name(), "category");
-        output_at(e, x.value(), "value");
-        output_at(e, x.message(), "message");
+        output_at(e, x.category().name(), detail::member_names::category);
+        output_at(e, x.value(), detail::member_names::value);
+        output_at(e, x.message(), detail::member_names::message);
     }
 
     template <class Encoder>
     void output(Encoder & e, std::error_condition const & x)
     {
-        output_at(e, x.category().name(), "category");
-        output_at(e, x.value(), "value");
-        output_at(e, x.message(), "message");
+        output_at(e, x.category().name(), detail::member_names::category);
+        output_at(e, x.value(), detail::member_names::value);
+        output_at(e, x.message(), detail::member_names::message);
     }
 }
 
@@ -100,12 +111,17 @@ struct e_source_location
         return os << x.file << '(' << x.line << ") in function " << x.function;
     }
 
+    friend detail::buffer_stream & operator<<(detail::buffer_stream & os, e_source_location const & x)
+    {
+        return os << x.file << '(' << x.line << ") in function " << x.function;
+    }
+
     template <class Encoder>
     friend void output( Encoder & e, e_source_location const & x )
     {
-        output_at(e, x.file, "file");
-        output_at(e, x.line, "line");
-        output_at(e, x.function, "function");
+        output_at(e, x.file, detail::member_names::file);
+        output_at(e, x.line, detail::member_names::line);
+        output_at(e, x.function, detail::member_names::function);
     }
 };
 
@@ -133,14 +149,33 @@ namespace detail
         e.write(x);
     }
 
+    template <class T>
+    void serialize_(buffer_writer & e, T const & x)
+    {
+        e.write(x);
+    }
+
+    template <class T>
+    void serialize_(fingerprint_builder & e, T const & x)
+    {
+        e.add(x);
+    }
+
     template <class T>
     void serialize_(encoder & e, T const & x)
     {
         using namespace serialization;
+#if BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME
+        serialize(e, x, name_id(get_type_name_zstr<T>(), static_cast<std::uint32_t>(get_type_name<T>().hash)));
+#else
         char zstr[1024];
-        serialize(e, x, to_zstr(zstr, get_type_name<T>()));
+        type_name const tn = get_type_name<T>();
+        serialize(e, x, name_id(to_zstr(zstr, tn), static_cast<std::uint32_t>(tn.hash)));
+#endif
         if( diagnostics_writer * dw = e.get<diagnostics_writer>() )
             dw->write(x);
+        else if( buffer_writer * bw = e.get<buffer_writer>() )
+            bw->write(x);
     }
 }
 
@@ -168,7 +203,7 @@ namespace detail
         }
 
         template <class T>
-        BOOST_LEAF_CONSTEXPR slot( int key, T && e ):
+        BOOST_LEAF_CONSTEXPR slot( error_id_int key, T && e ):
             optional<E>(key, std::forward<T>(e)),
             prev_(nullptr)
         {
@@ -198,13 +233,13 @@ namespace detail
             tls::write_ptr<slot<E>>(prev_);
         }
 
-        void unload( int err_id ) noexcept(!BOOST_LEAF_CFG_CAPTURE);
+        void unload( error_id_int err_id ) noexcept(!BOOST_LEAF_CFG_CAPTURE);
 
         template <class Encoder,class ErrorID>
         void serialize_to(Encoder & e, ErrorID id) const
         {
             static_assert(std::is_base_of<encoder, Encoder>::value, "Encoder must derive from detail::encoder");
-            if( int k = this->key() )
+            if( error_id_int k = this->key() )
             {
                 if( id && id.value() != k )
                     return;
@@ -222,132 +257,417 @@ namespace detail
 
 #if BOOST_LEAF_CFG_CAPTURE
 
+struct e_capture_overflow
+{
+    std::size_t value;
+};
+
+#if BOOST_LEAF_CFG_STD_PMR
+
+inline std::pmr::memory_resource * get_capture_resource() noexcept
+{
+    return tls::read_ptr<std::pmr::memory_resource>();
+}
+
+inline std::pmr::memory_resource * set_capture_resource( std::pmr::memory_resource * mr )
+{
+    std::pmr::memory_resource * prev = get_capture_resource();
+    tls::reserve_ptr<std::pmr::memory_resource>();
+    tls::write_ptr<std::pmr::memory_resource>(mr);
+    return prev;
+}
+
+#endif // #if BOOST_LEAF_CFG_STD_PMR
+
+namespace detail
+{
+#ifdef BOOST_LEAF_NO_THREADS
+    template <class T>
+    class sampling_counter
+    {
+        T x_;
+
+    public:
+
+        sampling_counter() noexcept: x_(0) { }
+        T load() const noexcept { return x_; }
+        void store( T v ) noexcept { x_ = v; }
+        T fetch_add( T v ) noexcept { T r = x_; x_ += v; return r; }
+        T exchange( T v ) noexcept { T r = x_; x_ = v; return r; }
+
+        bool compare_exchange( T & expected, T v ) noexcept
+        {
+            if( x_ != expected )
+            {
+                expected = x_;
+                return false;
+            }
+            x_ = v;
+            return true;
+        }
+    };
+#else
+    // The counters of capture_sampling_policy are approximate, so all
+    // accesses are relaxed.
+    template <class T>
+    class sampling_counter
+    {
+        std::atomic<T> x_;
+
+    public:
+
+        sampling_counter() noexcept: x_(0) { }
+        T load() const noexcept { return x_.load(std::memory_order_relaxed); }
+        void store( T v ) noexcept { x_.store(v, std::memory_order_relaxed); }
+        T fetch_add( T v ) noexcept { return x_.fetch_add(v, std::memory_order_relaxed); }
+        T exchange( T v ) noexcept { return x_.exchange(v, std::memory_order_relaxed); }
+        bool compare_exchange( T & expected, T v ) noexcept { return x_.compare_exchange_strong(expected, v, std::memory_order_relaxed); }
+    };
+#endif
+} // namespace detail
+
+// Decides which errors have their error objects captured for
+// diagnostic_details (see set_capture_sampling_policy): one in every
+// sample_rate errors, at most max_per_second errors per second, and none
+// while there are more than storm_threshold errors per second (or there were
+// during the previous second). A value of 0 disables the corresponding limit.
+// The same policy may be used by multiple threads.
+class capture_sampling_policy
+{
+    capture_sampling_policy( capture_sampling_policy const & ) = delete;
+    capture_sampling_policy & operator=( capture_sampling_policy const & ) = delete;
+
+    std::uint32_t const sample_rate_;
+    std::uint32_t const max_per_second_;
+    std::uint32_t const storm_threshold_;
+    detail::sampling_counter<std::uint64_t> errors_;
+    detail::sampling_counter<std::uint64_t> sampled_;
+    detail::sampling_counter<std::uint64_t> second_;
+    detail::sampling_counter<std::uint32_t> second_errors_;
+    detail::sampling_counter<std::uint32_t> second_captures_;
+    detail::sampling_counter<std::uint32_t> previous_second_errors_;
+
+    bool storm( std::uint32_t second_errors ) const noexcept
+    {
+        return storm_threshold_ && (second_errors > storm_threshold_ || previous_second_errors_.load() > storm_threshold_);
+    }
+
+    // Starts counting errors and captures for the current second, unless
+    // already counting for it. Returns true if started.
+    bool new_second() noexcept
+    {
+        std::uint64_t const t = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        std::uint64_t s = second_.load();
+        if( s == t || !second_.compare_exchange(s, t) )
+            return false;
+        std::uint32_t const e = second_errors_.exchange(0);
+        previous_second_errors_.store(s + 1 == t ? e : 0);
+        second_captures_.store(0);
+        return true;
+    }
+
+    bool sample_( bool sampled ) noexcept
+    {
+        if( !storm_threshold_ && (!sampled || !max_per_second_) )
+            return sampled;
+        // The clock is only checked if the counts would decline the error,
+        // since counts that span more than one second are within limits
+        // already.
+        std::uint32_t e = second_errors_.fetch_add(1) + 1;
+        if( (storm(e) || (sampled && max_per_second_ && second_captures_.load() >= max_per_second_)) && new_second() )
+            e = second_errors_.fetch_add(1) + 1;
+        if( !sampled || storm(e) )
+            return false;
+        return !max_per_second_ || second_captures_.fetch_add(1) < max_per_second_;
+    }
+
+public:
+
+    explicit capture_sampling_policy( std::uint32_t sample_rate = 1, std::uint32_t max_per_second = 0, std::uint32_t storm_threshold = 0 ) noexcept:
+        sample_rate_(sample_rate),
+        max_per_second_(max_per_second),
+        storm_threshold_(storm_threshold)
+    {
+    }
+
+    // Called once for each error which has error objects to capture.
+    bool sample() noexcept
+    {
+        std::uint64_t const n = errors_.fetch_add(1);
+        if( !sample_(sample_rate_ < 2 || n % sample_rate_ == 0) )
+            return false;
+        sampled_.fetch_add(1);
+        return true;
+    }
+
+    std::uint64_t sampled() const noexcept
+    {
+        return sampled_.load();
+    }
+
+    std::uint64_t declined() const noexcept
+    {
+        return errors_.load() - sampled_.load();
+    }
+}; // class capture_sampling_policy
+
+inline capture_sampling_policy * get_capture_sampling_policy() noexcept
+{
+    return tls::read_ptr<capture_sampling_policy>();
+}
+
+inline capture_sampling_policy * set_capture_sampling_policy( capture_sampling_policy * p )
+{
+    capture_sampling_policy * prev = get_capture_sampling_policy();
+    tls::reserve_ptr<capture_sampling_policy>();
+    tls::write_ptr<capture_sampling_policy>(p);
+    return prev;
+}
+
 namespace detail
 {
     template <class E>
-    struct capturing_slot_node_allocator;
+    struct capturing_slot_ops
+    {
+        static void unload( void * p, error_id_int err_id )
+        {
+            static_cast<slot<E> *>(p)->unload(err_id);
+        }
+
+        static void serialize_to( void const * p, encoder & e, error_id const & id )
+        {
+            static_cast<slot<E> const *>(p)->serialize_to(e, id);
+        }
+
+        static void fingerprint_to( void const * p, fingerprint_builder & fb, error_id const & id )
+        {
+            static_cast<slot<E> const *>(p)->serialize_to(fb, id);
+        }
+
+        static void deactivate( void const * p )
+        {
+            static_cast<slot<E> const *>(p)->deactivate();
+        }
+
+        static void destroy( void * p )
+        {
+            static_cast<slot<E> *>(p)->~slot<E>();
+        }
+
+        static void move( void * to, void * from )
+        {
+            (void) new (to) slot<E>(std::move(*static_cast<slot<E> *>(from)));
+            destroy(from);
+        }
+
+        static constexpr capture_entry_ops ops = { sizeof(slot<E>), alignof(slot<E>), &unload, &serialize_to, &fingerprint_to, &deactivate, &destroy, &move };
+    };
+
+    template <class E>
+    constexpr capture_entry_ops capturing_slot_ops<E>::ops;
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    struct captured_exception
+    {
+        std::exception_ptr ex;
+    };
+
+    template <class=void>
+    struct captured_exception_ops
+    {
+        static void unload( void * p, error_id_int )
+        {
+            std::rethrow_exception(static_cast<captured_exception *>(p)->ex);
+        }
+
+        static void serialize_to( void const *, encoder &, error_id const & )
+        {
+        }
+
+        static void fingerprint_to( void const *, fingerprint_builder &, error_id const & )
+        {
+        }
+
+        static void deactivate( void const * )
+        {
+            BOOST_LEAF_ASSERT(0);
+        }
+
+        static void destroy( void * p )
+        {
+            static_cast<captured_exception *>(p)->~captured_exception();
+        }
+
+        static void move( void * to, void * from )
+        {
+            (void) new (to) captured_exception{std::move(static_cast<captured_exception *>(from)->ex)};
+            destroy(from);
+        }
+
+        static constexpr capture_entry_ops ops = { sizeof(captured_exception), alignof(captured_exception), &unload, &serialize_to, &fingerprint_to, &deactivate, &destroy, &move };
+    };
 
+    template <class T>
+    constexpr capture_entry_ops captured_exception_ops<T>::ops;
+#endif // #ifndef BOOST_LEAF_NO_EXCEPTIONS
+
+#if BOOST_LEAF_CFG_CAPTURE_BUDGET
+
+    // Error objects captured while a try_capture_all is active are stored in
+    // the fixed-capacity buffer of the capture_list base (see
+    // BOOST_LEAF_CFG_CAPTURE_BUDGET). When the error is returned to the
+    // caller, the captured objects are moved into the result<T>. Objects that
+    // do not fit are dropped: alloc returns null, and the error object is
+    // discarded as if no handler needed it. Room for the current exception is
+    // always kept available, so it is never dropped in favor of an error
+    // object.
     class dynamic_allocator:
         capture_list
     {
         dynamic_allocator( dynamic_allocator const & ) = delete;
         dynamic_allocator & operator=( dynamic_allocator const & ) = delete;
 
-        template <class>
-        friend struct capturing_slot_node_allocator;
+#ifdef BOOST_LEAF_NO_EXCEPTIONS
+        static constexpr std::size_t headroom = 0;
+#else
+        static constexpr std::size_t headroom = max_entry_size(sizeof(captured_exception), alignof(captured_exception));
+#endif
+
+    public:
 
-        class capturing_node:
-            public capture_list::node
+        dynamic_allocator() noexcept
         {
-        protected:
-            BOOST_LEAF_CONSTEXPR explicit capturing_node( capture_list::node * * & last ) noexcept:
-                node(last)
-            {
-                BOOST_LEAF_ASSERT(last == &next_);
-                BOOST_LEAF_ASSERT(next_ == nullptr);
-            }
-        public:
-            virtual void deactivate() const noexcept = 0;
-        };
+        }
+
+        dynamic_allocator( dynamic_allocator && other ) noexcept:
+            capture_list(std::move(other))
+        {
+        }
 
         template <class E>
-        class capturing_slot_node final:
-            public slot<E>,
-            public capturing_node
-        {
-            using impl = slot<E>;
-            capturing_slot_node( capturing_slot_node const & ) = delete;
-            capturing_slot_node & operator=( capturing_slot_node const & ) = delete;
-            void deactivate() const noexcept override
-            {
-                impl::deactivate();
-            }
-            void unload( int err_id ) override
-            {
-                impl::unload(err_id);
-            }
-            void serialize_to_(encoder & e, error_id const & id) const override
-            {
-                impl::serialize_to(e, id);
-            }
-        public:
-            BOOST_LEAF_CONSTEXPR explicit capturing_slot_node( capture_list::node * * & last ):
-                capturing_node(last)
-            {
-                BOOST_LEAF_ASSERT(last == &next_);
-                BOOST_LEAF_ASSERT(next_ == nullptr);
-            }
-            template <class T>
-            BOOST_LEAF_CONSTEXPR capturing_slot_node( capture_list::node * * & last, int err_id, T && e ):
-                slot<E>(err_id, std::forward<T>(e)),
-                capturing_node(last)
-            {
-                BOOST_LEAF_ASSERT(last == &next_);
-                BOOST_LEAF_ASSERT(next_ == nullptr);
-            }
-        };
+        slot<E> * alloc() noexcept
+        {
+            BOOST_LEAF_ASSERT(tls::read_ptr<slot<E>>() == nullptr);
+            void * p = push(capturing_slot_ops<E>::ops, headroom);
+            if( !p )
+                return nullptr;
+            slot<E> * s = new (p) slot<E>();
+            s->activate();
+            return s;
+        }
 
+        template <class LeafResult>
+        LeafResult extract_capture_list(error_id_int err_id) noexcept
+        {
 #ifndef BOOST_LEAF_NO_EXCEPTIONS
-        class capturing_exception_node final:
-            public capturing_node
+            if( std::exception_ptr ex = std::current_exception() )
+                if( void * p = push(captured_exception_ops<>::ops) )
+                    (void) new (p) captured_exception{std::move(ex)};
+#endif
+            return { err_id, static_cast<capture_list &&>(*this) };
+        }
+
+#else // #if BOOST_LEAF_CFG_CAPTURE_BUDGET
+
+    // Error objects captured while a try_capture_all is active are stored in
+    // a list of capture_chunks, the first one allocated when the first error
+    // object is captured (see BOOST_LEAF_CFG_CAPTURE_CHUNK_SIZE). When the
+    // error is returned to the caller, the list is handed over to the result<T>
+    // as is, without moving the captured objects. Under BOOST_LEAF_CFG_STD_PMR,
+    // chunks are allocated from the memory_resource passed to try_capture_all,
+    // or else from the one installed by set_capture_resource.
+    class dynamic_allocator:
+        capture_list
+    {
+        dynamic_allocator( dynamic_allocator const & ) = delete;
+        dynamic_allocator & operator=( dynamic_allocator const & ) = delete;
+
+        capture_chunk * last_;
+#if BOOST_LEAF_CFG_STD_PMR
+        std::pmr::memory_resource * const mr_;
+
+        capture_chunk * new_chunk( std::size_t capacity ) const
         {
-            capturing_exception_node( capturing_exception_node const & ) = delete;
-            capturing_exception_node & operator=( capturing_exception_node const & ) = delete;
-            void deactivate() const noexcept override
-            {
-                BOOST_LEAF_ASSERT(0);
-            }
-            void unload( int ) override
-            {
-                std::rethrow_exception(ex_);
-            }
-            void serialize_to_(encoder &, error_id const &) const override
-            {
-            }
-            std::exception_ptr const ex_;
-        public:
-            capturing_exception_node( capture_list::node * * & last, std::exception_ptr && ex ) noexcept:
-                capturing_node(last),
-                ex_(std::move(ex))
-            {
-                BOOST_LEAF_ASSERT(last == &next_);
-                BOOST_LEAF_ASSERT(ex_);
-            }
-        };
-#endif // #ifndef BOOST_LEAF_NO_EXCEPTIONS
+            return capture_chunk::new_(capacity, mr_ ? mr_ : get_capture_resource());
+        }
+#else
+        static capture_chunk * new_chunk( std::size_t capacity )
+        {
+            return capture_chunk::new_(capacity);
+        }
+#endif
 
-        node * * last_;
+        void * push( capture_entry_ops const & ops )
+        {
+            if( last_ )
+                if( void * p = last_->push(ops) )
+                    return p;
+            std::size_t const min_capacity = last_ ? 2 * last_->capacity() : std::size_t(BOOST_LEAF_CFG_CAPTURE_CHUNK_SIZE);
+            std::size_t const entry_size = capture_chunk::max_entry_size(ops);
+            capture_chunk * c = new_chunk(entry_size > min_capacity ? entry_size : min_capacity);
+            (last_ ? last_->next_chunk : first_) = c;
+            last_ = c;
+            void * p = c->push(ops);
+            BOOST_LEAF_ASSERT(p != nullptr);
+            return p;
+        }
 
     public:
 
+#if BOOST_LEAF_CFG_STD_PMR
+        explicit dynamic_allocator( std::pmr::memory_resource * mr = nullptr ) noexcept:
+            capture_list(nullptr),
+            last_(nullptr),
+            mr_(mr)
+        {
+        }
+
+        dynamic_allocator( dynamic_allocator && other ) noexcept:
+            capture_list(std::move(other)),
+            last_(other.last_),
+            mr_(other.mr_)
+        {
+            other.last_ = nullptr;
+        }
+#else
         dynamic_allocator() noexcept:
             capture_list(nullptr),
-            last_(&first_)
+            last_(nullptr)
         {
-            BOOST_LEAF_ASSERT(first_ == nullptr);
         }
 
         dynamic_allocator( dynamic_allocator && other ) noexcept:
             capture_list(std::move(other)),
-            last_(other.last_ == &other.first_? &first_ : other.last_)
+            last_(other.last_)
         {
-            BOOST_LEAF_ASSERT(last_ != nullptr);
-            BOOST_LEAF_ASSERT(*last_ == nullptr);
-            BOOST_LEAF_ASSERT(other.first_ == nullptr);
-            other.last_ = &other.first_;
+            other.last_ = nullptr;
         }
+#endif
 
         template <class E>
         slot<E> * alloc()
         {
-            BOOST_LEAF_ASSERT(last_ != nullptr);
-            BOOST_LEAF_ASSERT(*last_ == nullptr);
             BOOST_LEAF_ASSERT(tls::read_ptr<slot<E>>() == nullptr);
-            capturing_slot_node<E> * csn = capturing_slot_node_allocator<E>::new_(last_);
-            csn->activate();
-            return csn;
+            slot<E> * s = new (push(capturing_slot_ops<E>::ops)) slot<E>();
+            s->activate();
+            return s;
+        }
+
+        template <class LeafResult>
+        LeafResult extract_capture_list(error_id_int err_id)
+        {
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+            if( std::exception_ptr ex = std::current_exception() )
+                (void) new (push(captured_exception_ops<>::ops)) captured_exception{std::move(ex)};
+#endif
+            capture_chunk * const f = first_;
+            first_ = nullptr;
+            last_ = nullptr;
+            return { err_id, capture_list(f) };
         }
 
+#endif // #else (#if BOOST_LEAF_CFG_CAPTURE_BUDGET)
+
         template <class E>
         slot<E> * reserve()
         {
@@ -360,44 +680,16 @@ namespace detail
         void deactivate() const noexcept
         {
             for_each(
-                []( capture_list::node const & n )
+                []( capture_entry_ops const & ops, void const * obj )
                 {
-                    static_cast<capturing_node const &>(n).deactivate();
+                    ops.deactivate(obj);
                 } );
         }
 
-        template <class LeafResult>
-        LeafResult extract_capture_list(int err_id)
-        {
-#ifndef BOOST_LEAF_NO_EXCEPTIONS
-            if( std::exception_ptr ex = std::current_exception() )
-                (void) new capturing_exception_node(last_, std::move(ex));
-#endif
-            detail::capture_list::node * const f = first_;
-            first_ = nullptr;
-            last_ = &first_;
-            return { err_id, capture_list(f) };
-        }
-
         using capture_list::unload;
         using capture_list::serialize_to;
     }; // class dynamic_allocator
 
-    template <class E>
-    struct capturing_slot_node_allocator
-    {
-        template <class... A>
-        static dynamic_allocator::capturing_slot_node<E> * new_( A && ... a )
-        {
-            return new dynamic_allocator::capturing_slot_node<E>(std::forward<A>(a)...);
-        }
-
-        static void delete_( dynamic_allocator::capturing_slot_node<E> * p ) noexcept
-        {
-            delete p;
-        }
-    };
-
     template <>
     class slot<dynamic_allocator>
     {
@@ -406,18 +698,51 @@ namespace detail
 
         dynamic_allocator da_;
         slot * prev_;
+        capture_sampling_policy * const policy_;
+        error_id_int sampled_id_;
+        bool sampled_;
 
     public:
 
+        // The slot of a context uses the capture_sampling_policy of the
+        // calling thread. try_capture_all passes a null policy, so that it
+        // captures all errors.
         slot() noexcept:
-            prev_(nullptr)
+            prev_(nullptr),
+            policy_(get_capture_sampling_policy()),
+            sampled_id_(0),
+            sampled_(false)
         {
             tls::reserve_ptr<slot<dynamic_allocator>>();
         }
 
+        explicit slot( capture_sampling_policy * policy ) noexcept:
+            prev_(nullptr),
+            policy_(policy),
+            sampled_id_(0),
+            sampled_(false)
+        {
+            tls::reserve_ptr<slot<dynamic_allocator>>();
+        }
+
+#if BOOST_LEAF_CFG_STD_PMR
+        slot( capture_sampling_policy * policy, std::pmr::memory_resource * mr ) noexcept:
+            da_(mr),
+            prev_(nullptr),
+            policy_(policy),
+            sampled_id_(0),
+            sampled_(false)
+        {
+            tls::reserve_ptr<slot<dynamic_allocator>>();
+        }
+#endif
+
         slot( slot && x ) noexcept:
             da_(std::move(x.da_)),
-            prev_(nullptr)
+            prev_(nullptr),
+            policy_(x.policy_),
+            sampled_id_(x.sampled_id_),
+            sampled_(x.sampled_)
         {
             BOOST_LEAF_ASSERT(x.prev_ == nullptr);
         }
@@ -437,6 +762,21 @@ namespace detail
             return da_;
         }
 
+        // Returns true if the error objects communicated with err_id are to
+        // be captured. The policy is consulted once per error, when its
+        // first error object needs to be captured.
+        bool sample( error_id_int err_id ) noexcept
+        {
+            if( !policy_ )
+                return true;
+            if( err_id != sampled_id_ )
+            {
+                sampled_id_ = err_id;
+                sampled_ = policy_->sample();
+            }
+            return sampled_;
+        }
+
         void activate() noexcept
         {
             prev_ = tls::read_ptr<slot<dynamic_allocator>>();
@@ -449,7 +789,7 @@ namespace detail
             tls::write_ptr<slot<dynamic_allocator>>(prev_);
         }
 
-        void unload( int err_id )
+        void unload( error_id_int err_id )
         {
             BOOST_LEAF_ASSERT(err_id);
             da_.unload(err_id);
@@ -469,68 +809,94 @@ namespace detail
 namespace detail
 {
 #if BOOST_LEAF_CFG_CAPTURE
-    inline dynamic_allocator * get_dynamic_allocator() noexcept
+    inline dynamic_allocator * get_dynamic_allocator( error_id_int err_id ) noexcept
     {
         if( slot<dynamic_allocator> * sl = tls::read_ptr<slot<dynamic_allocator>>() )
-            return &sl->get();
+            if( sl->sample(err_id) )
+                return &sl->get();
         return nullptr;
     }
 #endif
 
     template <class E>
-    inline slot<E> * get_slot() noexcept(!BOOST_LEAF_CFG_CAPTURE)
+    inline slot<E> * get_slot( error_id_int err_id ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
     {
         static_assert(!std::is_pointer<E>::value, "Error objects of pointer types are not allowed");
         static_assert(!std::is_same<E, error_id>::value, "Error objects of type error_id are not allowed");
         if( slot<E> * p = tls::read_ptr<slot<E>>() )
             return p;
 #if BOOST_LEAF_CFG_CAPTURE
-        if( dynamic_allocator * da = get_dynamic_allocator() )
+        if( dynamic_allocator * da = get_dynamic_allocator(err_id) )
             return da->alloc<E>();
+#else
+        (void) err_id;
 #endif
         return nullptr;
     }
 
     template <class E>
-    inline void slot<E>::unload( int err_id ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
+    inline void slot<E>::unload( error_id_int err_id ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
     {
         BOOST_LEAF_ASSERT(err_id);
         if( this->key() != err_id )
             return;
-        if( impl * p = get_slot<E>() )
+        if( impl * p = get_slot<E>(err_id) )
             if( !p->has_value(err_id) )
                 *p = std::move(*this);
     }
 
     template <class E>
-    BOOST_LEAF_CONSTEXPR inline int load_slot( int err_id, E && e ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
+    BOOST_LEAF_CONSTEXPR inline int load_slot( error_id_int err_id, E && e ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
     {
         using E_decayed = typename std::decay<E>::type;
         BOOST_LEAF_ASSERT((err_id&3) == 1);
-        if( slot<E_decayed> * p = get_slot<E_decayed>() )
+        if( slot<E_decayed> * p = get_slot<E_decayed>(err_id) )
             (void) p->load(err_id, std::forward<E>(e));
         return 0;
     }
 
+#if BOOST_LEAF_CFG_CAPTURE && BOOST_LEAF_CFG_CAPTURE_BUDGET
+    inline void load_capture_overflow( error_id_int err_id, std::size_t dropped )
+    {
+        if( slot<leaf::e_capture_overflow> * p = get_slot<leaf::e_capture_overflow>(err_id) )
+        {
+            if( leaf::e_capture_overflow * x = p->has_value(err_id) )
+                x->value += dropped;
+            else
+                (void) p->load(err_id, leaf::e_capture_overflow{dropped});
+        }
+    }
+
+    inline void serialize_capture_overflow( encoder & e, error_id const &, std::size_t dropped )
+    {
+        serialize_(e, leaf::e_capture_overflow{dropped});
+    }
+
+    inline void serialize_capture_overflow( fingerprint_builder & fb, error_id const &, std::size_t dropped )
+    {
+        serialize_(fb, leaf::e_capture_overflow{dropped});
+    }
+#endif
+
     template <class F>
-    BOOST_LEAF_CONSTEXPR inline int load_slot_deferred( int err_id, F && f )
+    BOOST_LEAF_CONSTEXPR inline int load_slot_deferred( error_id_int err_id, F && f )
     {
         using E = typename function_traits<F>::return_type;
         using E_decayed = typename std::decay<E>::type;
         BOOST_LEAF_ASSERT((err_id&3) == 1);
-        if( slot<E_decayed> * p = get_slot<E_decayed>() )
+        if( slot<E_decayed> * p = get_slot<E_decayed>(err_id) )
             (void) p->load(err_id, std::forward<F>(f)());
         return 0;
     }
 
     template <class F>
-    BOOST_LEAF_CONSTEXPR inline int load_slot_accumulate( int err_id, F && f )
+    BOOST_LEAF_CONSTEXPR inline int load_slot_accumulate( error_id_int err_id, F && f )
     {
         static_assert(function_traits<F>::arity == 1, "Lambdas passed to accumulate must take a single e-type argument by reference");
         using E = fn_arg_type<F,0>;
         using E_decayed = typename std::decay<E>::type;
         BOOST_LEAF_ASSERT((err_id&3) == 1);
-        if( slot<E_decayed> * p = get_slot<E_decayed>() )
+        if( slot<E_decayed> * p = get_slot<E_decayed>(err_id) )
             if( E_decayed * v = p->has_value(err_id) )
                 (void) std::forward<F>(f)(*v);
             else
@@ -552,7 +918,7 @@ namespace detail
     template <class E>
     struct load_item<E, -1>
     {
-        BOOST_LEAF_CONSTEXPR static int load_( int err_id, E && e )
+        BOOST_LEAF_CONSTEXPR static int load_( error_id_int err_id, E && e )
         {
             return load_slot(err_id, std::forward<E>(e));
         }
@@ -561,7 +927,7 @@ namespace detail
     template <class F>
     struct load_item<F, 0>
     {
-        BOOST_LEAF_CONSTEXPR static int load_( int err_id, F && f )
+        BOOST_LEAF_CONSTEXPR static int load_( error_id_int err_id, F && f )
         {
             return load_slot_deferred(err_id, std::forward<F>(f));
         }
@@ -570,7 +936,7 @@ namespace detail
     template <class F>
     struct load_item<F, 1>
     {
-        BOOST_LEAF_CONSTEXPR static int load_( int err_id, F && f )
+        BOOST_LEAF_CONSTEXPR static int load_( error_id_int err_id, F && f )
         {
             return load_slot_accumulate(err_id, std::forward<F>(f));
         }
@@ -581,21 +947,21 @@ namespace detail
 
 namespace detail
 {
-    inline int current_id() noexcept
+    inline error_id_int current_id() noexcept
     {
-        unsigned id = tls::read_current_error_id();
+        error_id_uint id = tls::read_current_error_id();
         BOOST_LEAF_ASSERT(id == 0 || (id&3) == 1);
-        return int(id);
+        return error_id_int(id);
     }
 
-    inline int new_id() noexcept
+    inline error_id_int new_id() noexcept
     {
-        unsigned id = tls::generate_next_error_id();
+        error_id_uint id = tls::generate_next_error_id();
         tls::write_current_error_id(id);
-        return int(id);
+        return error_id_int(id);
     }
 
-    inline int start_new_error() noexcept
+    inline error_id_int start_new_error() noexcept
     {
         return new_id();
     }
@@ -674,16 +1040,16 @@ inline bool is_error_id( std::error_code const & ec ) noexcept
 
 namespace detail
 {
-    BOOST_LEAF_CONSTEXPR error_id make_error_id(int) noexcept;
+    BOOST_LEAF_CONSTEXPR error_id make_error_id(error_id_int) noexcept;
 }
 
 class error_id
 {
-    friend error_id BOOST_LEAF_CONSTEXPR detail::make_error_id(int) noexcept;
+    friend error_id BOOST_LEAF_CONSTEXPR detail::make_error_id(detail::error_id_int) noexcept;
 
-    int value_;
+    detail::error_id_int value_;
 
-    BOOST_LEAF_CONSTEXPR explicit error_id( int value ) noexcept:
+    BOOST_LEAF_CONSTEXPR explicit error_id( detail::error_id_int value ) noexcept:
         value_(value)
     {
         BOOST_LEAF_ASSERT(value_ == 0 || ((value_&3) == 1));
@@ -724,7 +1090,7 @@ public:
     template <class Item>
     BOOST_LEAF_CONSTEXPR error_id load(Item && item) const
     {
-        if (int err_id = value())
+        if (detail::error_id_int err_id = value())
         {
             int const unused[] = { 42, detail::load_item<Item>::load_(err_id, std::forward<Item>(item)) };
             (void)unused;
@@ -735,7 +1101,7 @@ public:
     template <class... Item>
     BOOST_LEAF_CONSTEXPR error_id load( Item && ... item ) const
     {
-        if( int err_id = value() )
+        if( detail::error_id_int err_id = value() )
         {
             int const unused[] = { 42, detail::load_item<Item>::load_(err_id, std::forward<Item>(item))... };
             (void) unused;
@@ -743,7 +1109,7 @@ public:
         return *this;
     }
 
-    BOOST_LEAF_CONSTEXPR int value() const noexcept
+    BOOST_LEAF_CONSTEXPR detail::error_id_int value() const noexcept
     {
         BOOST_LEAF_ASSERT(value_ == 0 || ((value_&3) == 1));
         return value_;
@@ -775,6 +1141,11 @@ public:
         return os << (x.value_ / 4);
     }
 
+    friend detail::buffer_stream & operator<<( detail::buffer_stream & os, error_id x )
+    {
+        return os << (x.value_ / 4);
+    }
+
     template <class Encoder>
     friend void output( Encoder & e, error_id x )
     {
@@ -793,7 +1164,7 @@ public:
 
 namespace detail
 {
-    BOOST_LEAF_CONSTEXPR inline error_id make_error_id( int err_id ) noexcept
+    BOOST_LEAF_CONSTEXPR inline error_id make_error_id( error_id_int err_id ) noexcept
     {
         BOOST_LEAF_ASSERT(err_id == 0 || (err_id&3) == 1);
         return error_id((err_id&~3)|1);
@@ -8,6 +8,8 @@
 #include <boost/leaf/config.hpp>
 #include <boost/leaf/error.hpp>
 #include <boost/leaf/detail/exception_base.hpp>
+#include <boost/leaf/detail/demangle_cache.hpp>
+#include <boost/leaf/detail/dynamic_cast_cache.hpp>
 
 #ifndef BOOST_LEAF_NO_EXCEPTIONS
 #   include <typeinfo>
@@ -20,17 +22,15 @@ namespace serialization
     template <class Encoder>
     void output(Encoder & e, std::exception const & x)
     {
-        char const dynamic_type[] = "dynamic_type";
-        char const what[] = "what";
 #ifdef BOOST_LEAF_NO_EXCEPTIONS
-        output_at(e, "<<unknown>>", dynamic_type);
+        output_at(e, "<<unknown>>", detail::member_names::dynamic_type);
 #else
-        output_at(e, detail::demangler(typeid(x).name()).get(), dynamic_type);
+        output_at(e, detail::type_info_demangler(typeid(x)).get(), detail::member_names::dynamic_type);
 #endif
         if( char const * wh = x.what() )
-            output_at(e, wh, what);
+            output_at(e, wh, detail::member_names::what);
         else
-            output_at(e, "<<nullptr>>", what);
+            output_at(e, "<<nullptr>>", detail::member_names::what);
     }
 
     template <class Encoder>
@@ -52,11 +52,11 @@ namespace serialization
             {
             }
 #endif
-            output_at(e, "<<unknown>>", "dynamic_type");
+            output_at(e, "<<unknown>>", detail::member_names::dynamic_type);
         }
         else
-            output_at(e, "<<empty>>", "dynamic_type");
-        output_at(e, "N/A", "what");
+            output_at(e, "<<empty>>", detail::member_names::dynamic_type);
+        output_at(e, "N/A", detail::member_names::what);
     }
 }
 
@@ -101,7 +101,7 @@ namespace detail
 
         bool is_current_exception() const noexcept
         {
-            return tls::read_current_error_id() == unsigned(error_id::value());
+            return tls::read_current_error_id() == detail::error_id_uint(error_id::value());
         }
 
         error_id get_error_id() const noexcept override
@@ -240,18 +240,32 @@ template <class... E>
 
 namespace detail
 {
-    inline error_id catch_exceptions_helper( std::exception const &, leaf_detail_mp11::mp_list<> )
+    template <std::size_t N>
+    inline error_id catch_exceptions_helper( void const * const (&)[N], leaf_detail_mp11::mp_list<> )
     {
         return leaf::new_error(std::current_exception());
     }
 
-    template <class Ex1, class... Ex>
-    inline error_id catch_exceptions_helper( std::exception const & ex, leaf_detail_mp11::mp_list<Ex1,Ex...> )
+    template <std::size_t N, class Ex1, class... Ex>
+    inline error_id catch_exceptions_helper( void const * const (&p)[N], leaf_detail_mp11::mp_list<Ex1,Ex...> )
     {
-        if( Ex1 const * p = dynamic_cast<Ex1 const *>(&ex) )
-            return catch_exceptions_helper(ex, leaf_detail_mp11::mp_list<Ex...>{ }).load(*p);
+        if( Ex1 const * p1 = static_cast<Ex1 const *>(p[N - 1 - sizeof...(Ex)]) )
+            return catch_exceptions_helper(p, leaf_detail_mp11::mp_list<Ex...>{ }).load(*p1);
         else
-            return catch_exceptions_helper(ex, leaf_detail_mp11::mp_list<Ex...>{ });
+            return catch_exceptions_helper(p, leaf_detail_mp11::mp_list<Ex...>{ });
+    }
+
+    inline error_id catch_exceptions( std::exception const &, leaf_detail_mp11::mp_list<> )
+    {
+        return leaf::new_error(std::current_exception());
+    }
+
+    template <class... Ex>
+    inline error_id catch_exceptions( std::exception const & ex, leaf_detail_mp11::mp_list<Ex...> )
+    {
+        void const * p[sizeof...(Ex)];
+        dynamic_cast_cache<Ex...>::cast(ex, p);
+        return catch_exceptions_helper(p, leaf_detail_mp11::mp_list<Ex...>{ });
     }
 
     template <class T>
@@ -281,7 +295,7 @@ exception_to_result( F && f ) noexcept(!BOOST_LEAF_CFG_CAPTURE)
     }
     catch( std::exception const & ex )
     {
-        return detail::catch_exceptions_helper(ex, leaf_detail_mp11::mp_list<Ex...>());
+        return detail::catch_exceptions(ex, leaf_detail_mp11::mp_list<Ex...>());
     }
     catch(...)
     {
@@ -0,0 +1,271 @@
+#ifndef BOOST_LEAF_FINGERPRINT_HPP_INCLUDED
+#define BOOST_LEAF_FINGERPRINT_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/diagnostics.hpp>
+#include <boost/leaf/detail/fingerprint_builder.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#ifndef BOOST_LEAF_NO_THREADS
+#   include <atomic>
+#endif
+
+namespace boost { namespace leaf {
+
+// Returns a 64-bit hash of the set of the types of the error objects
+// communicated by x (and of the dynamic type of the caught exception, if
+// any), of the source location where the error was reported, and of the
+// value of the error object of type Key, if specified. Nothing is formatted:
+// the type names and their hashes are computed at compile time.
+template <class Key = void, class ErrorInfo>
+typename std::enable_if<std::is_base_of<error_info, ErrorInfo>::value, std::uint64_t>::type
+fingerprint( ErrorInfo const & x )
+{
+    detail::fingerprint_builder fb(static_cast<Key const *>(nullptr));
+    fingerprint_to_(fb, x);
+    std::uint64_t h = fb.value();
+    if( e_source_location const * loc = x.source_location() )
+        h = detail::fingerprint_mix(h ^ detail::fingerprint_mix(
+            detail::fingerprint_hash(loc->file) ^
+            detail::fingerprint_mix(detail::fingerprint_hash(loc->function) + static_cast<unsigned>(loc->line))));
+    return h;
+}
+
+////////////////////////////////////////
+
+// Counts occurrences of errors by fingerprint, and keeps the diagnostic
+// message of the first occurrence of each, so that a periodic summary can be
+// reported instead of each occurrence. The table has a fixed capacity;
+// recording an error takes no locks, and does not allocate memory.
+class error_aggregator
+{
+    error_aggregator( error_aggregator const & ) = delete;
+    error_aggregator & operator=( error_aggregator const & ) = delete;
+
+#ifdef BOOST_LEAF_NO_THREADS
+    template <class T>
+    struct cell
+    {
+        T x;
+        T load( int = 0 ) const noexcept { return x; }
+        void store( T v, int = 0 ) noexcept { x = v; }
+        T fetch_add( T v, int = 0 ) noexcept { T r = x; x += v; return r; }
+        bool compare_exchange_strong( T & expected, T v, int = 0 ) noexcept
+        {
+            if( x != expected )
+            {
+                expected = x;
+                return false;
+            }
+            x = v;
+            return true;
+        }
+    };
+
+    enum { relaxed, acquire, release, acq_rel };
+#else
+    template <class T>
+    using cell = std::atomic<T>;
+
+    constexpr static std::memory_order relaxed = std::memory_order_relaxed;
+    constexpr static std::memory_order acquire = std::memory_order_acquire;
+    constexpr static std::memory_order release = std::memory_order_release;
+    constexpr static std::memory_order acq_rel = std::memory_order_acq_rel;
+#endif
+
+    // An entry is claimed by the thread which stores its fingerprint; that
+    // thread formats the exemplar, then sets ready. The exemplar is not
+    // modified until the entry is reclaimed by summarize, which happens if the
+    // error did not occur since the previous call to summarize.
+    //
+    // The low 48 bits of state hold the count. The high bits are incremented
+    // each time the entry is reclaimed, so that a thread which read the
+    // fingerprint before the entry was reclaimed fails to update its count.
+    // To reclaim an entry, its count is set to reclaiming, its fingerprint to
+    // fp_reclaimed, its count to 0 and finally its fingerprint to fp_free, so
+    // that the old fingerprint is never seen together with a valid count.
+    struct entry
+    {
+        cell<std::uint64_t> fingerprint;
+        cell<std::uint64_t> state;
+        cell<bool> ready;
+    };
+
+    constexpr static std::size_t max_probes = 32;
+    constexpr static std::uint64_t fp_free = 0;
+    constexpr static std::uint64_t fp_reclaimed = 1;
+    constexpr static std::uint64_t count_mask = (std::uint64_t(1) << 48) - 1;
+    constexpr static std::uint64_t reclaiming = count_mask;
+
+    static std::size_t round_up_pow2( std::size_t n ) noexcept
+    {
+        std::size_t r = 2;
+        while( r < n )
+            r <<= 1;
+        return r;
+    }
+
+    std::size_t const mask_;
+    std::size_t const exemplar_size_;
+    std::unique_ptr<entry[]> entries_;
+    std::unique_ptr<char[]> exemplars_;
+    cell<std::uint64_t> dropped_;
+
+    char * exemplar( std::size_t i ) const noexcept
+    {
+        return &exemplars_[i * exemplar_size_];
+    }
+
+    // Increments the count of e if its fingerprint is fp; returns false if it
+    // isn't, or if e is being reclaimed.
+    static bool increment( entry & e, std::uint64_t fp ) noexcept
+    {
+        for(;;)
+        {
+            std::uint64_t s = e.state.load(acquire);
+            if( e.fingerprint.load(acquire) != fp || (s & count_mask) == reclaiming )
+                return false;
+            if( e.state.compare_exchange_strong(s, s + 1, relaxed) )
+                return true;
+        }
+    }
+
+    // Called by summarize when the error did not occur since the previous
+    // call. s is the state of e, with a count of 0.
+    static bool reclaim( entry & e, std::uint64_t s ) noexcept
+    {
+        std::uint64_t const next = (s & ~count_mask) + count_mask + 1;
+        if( !e.state.compare_exchange_strong(s, next | reclaiming, relaxed) )
+            return false;
+        e.ready.store(false, relaxed);
+        e.fingerprint.store(fp_reclaimed, relaxed);
+        e.state.store(next, release);
+        e.fingerprint.store(fp_free, release);
+        return true;
+    }
+
+public:
+
+    // Allocates a table of capacity entries (rounded up to a power of 2),
+    // each keeping an exemplar of up to exemplar_size - 1 characters.
+    explicit error_aggregator( std::size_t capacity = 256, std::size_t exemplar_size = 1024 ):
+        mask_(round_up_pow2(capacity) - 1),
+        exemplar_size_(exemplar_size),
+        entries_(new entry[mask_ + 1]()),
+        exemplars_(new char[(mask_ + 1) * exemplar_size]),
+        dropped_()
+    {
+        BOOST_LEAF_ASSERT(exemplar_size > 0);
+        dropped_.store(0, relaxed);
+    }
+
+    // Counts an occurrence of the error with fingerprint fp (the values 0 and
+    // 1 are reserved, and are counted as 2 and 3). If this is the first
+    // occurrence, x (error_info, diagnostic_info or diagnostic_details) is
+    // formatted as the exemplar, the same way as by print_to. Returns false
+    // if none of the entries probed for fp is free, in which case the
+    // occurrence is counted in dropped().
+    template <class ErrorInfo>
+    bool record( std::uint64_t fp, ErrorInfo const & x )
+    {
+        if( fp < 2 )
+            fp += 2;
+        std::size_t const probes = mask_ + 1 < max_probes ? mask_ + 1 : max_probes;
+        for(;;)
+        {
+            // Reclaimed entries leave holes, so look at all probed entries
+            // before claiming the first free one.
+            std::size_t k_free = mask_ + 1;
+            for( std::size_t i = 0; i != probes; ++i )
+            {
+                std::size_t const k = (static_cast<std::size_t>(fp) + i) & mask_;
+                entry & e = entries_[k];
+                if( increment(e, fp) )
+                    return true;
+                if( k_free > mask_ && e.fingerprint.load(relaxed) == fp_free )
+                    k_free = k;
+            }
+            if( k_free > mask_ )
+                break;
+            entry & e = entries_[k_free];
+            std::uint64_t f = fp_free;
+            if( e.fingerprint.compare_exchange_strong(f, fp, acq_rel) )
+            {
+                struct set_ready
+                {
+                    entry & e;
+                    ~set_ready() { e.ready.store(true, release); }
+                };
+                set_ready r { e };
+                bool counted = increment(e, fp);
+                BOOST_LEAF_ASSERT(counted);
+                (void) counted;
+                *exemplar(k_free) = 0;
+                (void) print_to(exemplar(k_free), exemplar_size_, x);
+                return true;
+            }
+            // Another thread claimed the entry, possibly for fp; try again.
+        }
+        dropped_.fetch_add(1, relaxed);
+        return false;
+    }
+
+    // Same as record(fingerprint(x), x).
+    template <class ErrorInfo>
+    bool record( ErrorInfo const & x )
+    {
+        return record(fingerprint(x), x);
+    }
+
+    // Calls f(fingerprint, count, exemplar) for each error which occurred
+    // since the previous call to summarize, where count is the number of
+    // occurrences since then, and exemplar is the zero-terminated diagnostic
+    // message of the first occurrence. Entries of errors which did not occur
+    // since the previous call are reclaimed. Must not be called concurrently
+    // with itself.
+    template <class F>
+    void summarize( F && f )
+    {
+        for( std::size_t k = 0; k <= mask_; ++k )
+        {
+            entry & e = entries_[k];
+            if( !e.ready.load(acquire) )
+                continue;
+            std::uint64_t s = e.state.load(relaxed);
+            for(;;)
+            {
+                if( std::uint64_t const count = s & count_mask )
+                {
+                    if( e.state.compare_exchange_strong(s, s & ~count_mask, relaxed) )
+                    {
+                        f(e.fingerprint.load(relaxed), count, static_cast<char const *>(exemplar(k)));
+                        break;
+                    }
+                }
+                else if( reclaim(e, s) )
+                    break;
+                else
+                    s = e.state.load(relaxed);
+            }
+        }
+    }
+
+    // The number of occurrences which were not counted because no entry
+    // was free.
+    std::uint64_t dropped() const noexcept
+    {
+        return dropped_.load(relaxed);
+    }
+}; // class error_aggregator
+
+} } // namespace boost::leaf
+
+#endif // #ifndef BOOST_LEAF_FINGERPRINT_HPP_INCLUDED
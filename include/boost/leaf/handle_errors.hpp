@@ -8,6 +8,9 @@
 #include <boost/leaf/config.hpp>
 #include <boost/leaf/context.hpp>
 #include <boost/leaf/detail/diagnostics_writer.hpp>
+#include <boost/leaf/detail/dynamic_cast_cache.hpp>
+
+#include <climits>
 
 namespace boost { namespace leaf {
 
@@ -19,10 +22,12 @@ namespace detail
 {
     inline error_id unpack_error_id(std::exception const & ex) noexcept
     {
-        if( detail::exception_base const * eb = dynamic_cast<detail::exception_base const *>(&ex) )
-            return eb->get_error_id();
-        if( error_id const * err_id = dynamic_cast<error_id const *>(&ex) )
-            return *err_id;
+        void const * p[2];
+        dynamic_cast_cache<exception_base, error_id>::cast(ex, p);
+        if( p[0] )
+            return static_cast<exception_base const *>(p[0])->get_error_id();
+        if( p[1] )
+            return *static_cast<error_id const *>(p[1]);
         return current_error();
     }
 }
@@ -94,12 +99,23 @@ public:
         serialize_to_(ea);
     }
 
+    friend void fingerprint_to_( detail::fingerprint_builder & fb, error_info const & x )
+    {
+        x.serialize_to_(fb);
+    }
+
     template <class CharT, class Traits>
     friend std::ostream & operator<<(std::basic_ostream<CharT, Traits> & os, error_info const & x)
     {
         detail::diagnostics_writer w(os, x.error(), x.source_location(), x.exception());
         return os;
     }
+
+    friend std::size_t print_to(char * buf, std::size_t size, error_info const & x)
+    {
+        detail::buffer_writer w(buf, size, x.error(), x.source_location(), x.exception());
+        return w.finish();
+    }
 }; // class error_info
 
 namespace detail
@@ -173,12 +189,14 @@ namespace detail
         static std::error_code const * peek( error_info const & ei ) noexcept
         {
             auto const ex = ei.exception();
-            if( std::system_error * se = dynamic_cast<std::system_error *>(ex) )
-                return &se->code();
-            else if( std::error_code * ec = dynamic_cast<std::error_code *>(ex) )
-                return ec;
-            else
+            if( !ex )
                 return nullptr;
+            void const * p[2];
+            dynamic_cast_cache<std::system_error, std::error_code>::cast(*ex, p);
+            if( p[0] )
+                return &static_cast<std::system_error const *>(p[0])->code();
+            else
+                return static_cast<std::error_code const *>(p[1]);
         }
     };
 
@@ -188,12 +206,14 @@ namespace detail
         static std::error_code * peek( error_info const & ei ) noexcept
         {
             auto const ex = ei.exception();
-            if( std::system_error * se = dynamic_cast<std::system_error *>(ex) )
-                return const_cast<std::error_code *>(&se->code());
-            else if( std::error_code * ec = dynamic_cast<std::error_code *>(ex) )
-                return ec;
-            else
+            if( !ex )
                 return nullptr;
+            void const * p[2];
+            dynamic_cast_cache<std::system_error, std::error_code>::cast(*ex, p);
+            if( p[0] )
+                return const_cast<std::error_code *>(&static_cast<std::system_error const *>(p[0])->code());
+            else
+                return const_cast<std::error_code *>(static_cast<std::error_code const *>(p[1]));
         }
     };
 #endif // #if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
@@ -203,7 +223,9 @@ namespace detail
     {
         static E * peek( error_info const & ei ) noexcept
         {
-            return dynamic_cast<E *>(ei.exception());
+            if( std::exception * ex = ei.exception() )
+                return const_cast<E *>(cached_dynamic_cast<typename std::remove_const<E>::type>(*ex));
+            return nullptr;
         }
     };
 
@@ -321,13 +343,116 @@ namespace detail
         return ei.exception();
     }
 
+    template <class E>
+    BOOST_LEAF_CONSTEXPR inline bool slot_holds( slot<E> const & s, error_id_int err_id ) noexcept
+    {
+        return s.has_value(err_id) != nullptr;
+    }
+
+#if BOOST_LEAF_CFG_CAPTURE
+    BOOST_LEAF_CONSTEXPR inline bool slot_holds( slot<dynamic_allocator> const &, error_id_int ) noexcept
+    {
+        return false;
+    }
+#endif
+
+    // Bit I of a slot_mask is set if the I-th slot in the context tuple holds
+    // an error object for the error being handled. It is computed once per
+    // handle_error, so that selecting among many handlers which take the same
+    // error types does not probe the same slots over and over.
+    template <class Tup, std::size_t N = std::tuple_size<Tup>::value>
+    class slot_mask
+    {
+        using word = unsigned long long;
+        constexpr static std::size_t word_bits = sizeof(word) * CHAR_BIT;
+
+        word w_[N ? (N + word_bits - 1) / word_bits : 1];
+
+        BOOST_LEAF_CONSTEXPR void set_( Tup const &, error_id_int, std::integral_constant<std::size_t, N> ) noexcept
+        {
+        }
+
+        template <std::size_t I>
+        BOOST_LEAF_CONSTEXPR void set_( Tup const & tup, error_id_int err_id, std::integral_constant<std::size_t, I> ) noexcept
+        {
+            if( slot_holds(std::get<I>(tup), err_id) )
+                w_[I / word_bits] |= word(1) << (I % word_bits);
+            set_(tup, err_id, std::integral_constant<std::size_t, I + 1>{ });
+        }
+
+    public:
+
+        BOOST_LEAF_CONSTEXPR slot_mask( Tup const & tup, error_info const & ei ) noexcept:
+            w_()
+        {
+            if( error_id err = ei.error() )
+                set_(tup, err.value(), std::integral_constant<std::size_t, 0>{ });
+        }
+
+        template <std::size_t I>
+        BOOST_LEAF_CONSTEXPR bool test() const noexcept
+        {
+            static_assert(I < N, "Bug in LEAF: slot index out of range");
+            return (w_[I / word_bits] >> (I % word_bits)) & 1;
+        }
+    }; // template slot_mask
+
+    // Handler arguments which (directly, or through a predicate) require an
+    // error object stored in a slot. These are checked against the slot_mask
+    // rather than by probing the slot. If there is no such error object, the
+    // argument may still be matched by the current exception.
+    template <class A, class E = typename std::decay<A>::type, bool IsPredicate = is_predicate<E>::value, bool = std::is_void<E>::value || does_not_participate_in_context_deduction<E>::value>
+    struct handler_argument_uses_slot
+    {
+        using error_type = E;
+        constexpr static bool value = std::is_base_of<handler_argument_traits_defaults<A>, handler_argument_traits<A>>::value;
+    };
+
+    template <class A, class Pred>
+    struct handler_argument_uses_slot<A, Pred, true, false>: handler_argument_uses_slot<typename Pred::error_type>
+    {
+    };
+
+    template <class A, class E, bool IsPredicate>
+    struct handler_argument_uses_slot<A, E, IsPredicate, true>
+    {
+        constexpr static bool value = false;
+    };
+
+    template <class Tup, class A, bool = handler_argument_uses_slot<A>::value>
+    struct check_argument
+    {
+        template <class Mask>
+        BOOST_LEAF_CONSTEXPR static bool check( Tup & tup, error_info const & ei, Mask const & ) noexcept
+        {
+            return handler_argument_traits<A>::check(tup, ei);
+        }
+    };
+
+    template <class Tup, class A>
+    struct check_argument<Tup, A, true>
+    {
+        using error_type = typename handler_argument_uses_slot<A>::error_type;
+        constexpr static int slot_index = tuple_type_index<slot<error_type>, typename std::remove_const<Tup>::type>::value;
+
+        template <class Mask>
+        BOOST_LEAF_CONSTEXPR static bool check( Tup & tup, error_info const & ei, Mask const & m ) noexcept
+        {
+            if( m.template test<slot_index>() )
+                return !is_predicate<typename std::decay<A>::type>::value || handler_argument_traits<A>::check(tup, ei);
+            else
+                return ei.exception() && handler_argument_traits<A>::check(tup, ei);
+        }
+    };
+
     template <class Tup, class... List>
     struct check_arguments;
 
     template <class Tup>
     struct check_arguments<Tup>
     {
-        BOOST_LEAF_CONSTEXPR static bool check( Tup const &, error_info const & )
+        template <class Mask>
+        BOOST_LEAF_CONSTEXPR static bool check( Tup const &, error_info const &, Mask const & )
         {
             return true;
         }
@@ -336,9 +461,10 @@ namespace detail
     template <class Tup, class Car, class... Cdr>
     struct check_arguments<Tup, Car, Cdr...>
     {
-        BOOST_LEAF_CONSTEXPR static bool check( Tup & tup, error_info const & ei ) noexcept
+        template <class Mask>
+        BOOST_LEAF_CONSTEXPR static bool check( Tup & tup, error_info const & ei, Mask const & m ) noexcept
         {
-            return handler_argument_traits<Car>::check(tup, ei) && check_arguments<Tup, Cdr...>::check(tup, ei);
+            return check_argument<Tup, Car>::check(tup, ei, m) && check_arguments<Tup, Cdr...>::check(tup, ei, m);
         }
     };
 } // namespace detail
@@ -368,10 +494,10 @@ namespace detail
 
 namespace detail
 {
-    template <class Tup, class... A>
-    BOOST_LEAF_CONSTEXPR inline bool check_handler_( Tup & tup, error_info const & ei, leaf_detail_mp11::mp_list<A...> ) noexcept
+    template <class Tup, class Mask, class... A>
+    BOOST_LEAF_CONSTEXPR inline bool check_handler_( Tup & tup, error_info const & ei, Mask const & m, leaf_detail_mp11::mp_list<A...> ) noexcept
     {
-        return check_arguments<Tup, A...>::check(tup, ei);
+        return check_arguments<Tup, A...>::check(tup, ei, m);
     }
 
     template <class R, class F, bool IsResult = is_result_type<R>::value, class FReturnType = fn_return_type<F>>
@@ -406,66 +532,327 @@ namespace detail
     template <class... T>
     struct is_tuple<std::tuple<T...> &>: std::true_type { };
 
-    template <class R, class Context, class H>
+    ////////////////////////////////////////
+
+    // Specialized (see pred.hpp) for predicates which compare a key, taken
+    // from the error object, to a list of integral or enum constants. A run of
+    // two or more consecutive handlers which take a single such predicate with
+    // the same key_source is dispatched through a sorted table of constants,
+    // rather than by evaluating each predicate in turn. Specializations
+    // define:
+    //
+    // - error_type: the type of the error object;
+    // - key_type: the integral or enum type of the key;
+    // - key_source: two predicates with the same key_source obtain the key
+    //   from the same error object, in the same way;
+    // - values: key_values<key_type, V...>, the constants;
+    // - key(e): returns the key for the error object e.
+    template <class Pred>
+    struct predicate_key
+    {
+        constexpr static bool value = false;
+        using key_source = void;
+    };
+
+#if __cplusplus >= 201703L
+    template <class K, auto... V>
+    struct key_values
+    {
+    };
+#else
+    template <class K, K... V>
+    struct key_values
+    {
+    };
+#endif
+
+    template <class K, bool = std::is_enum<K>::value>
+    struct key_int
+    {
+        using type = K;
+    };
+
+    template <class K>
+    struct key_int<K, true>
+    {
+        using type = typename std::underlying_type<K>::type;
+    };
+
+    template <class I, I Key, int Handler>
+    struct key_entry
+    {
+        constexpr static I key = Key;
+        constexpr static int handler = Handler;
+    };
+
+    template <int Handler, class Values>
+    struct key_entries;
+
+#if __cplusplus >= 201703L
+    template <int Handler, class K, auto... V>
+    struct key_entries<Handler, key_values<K, V...>>
+#else
+    template <int Handler, class K, K... V>
+    struct key_entries<Handler, key_values<K, V...>>
+#endif
+    {
+        using I = typename key_int<K>::type;
+        using type = leaf_detail_mp11::mp_list<key_entry<I, static_cast<I>(V), Handler>...>;
+    };
+
+    template <class Entries>
+    struct key_table_data;
+
+    template <class... Entry>
+    struct key_table_data<leaf_detail_mp11::mp_list<Entry...>>
+    {
+        using I = typename std::common_type<typename std::remove_const<decltype(Entry::key)>::type...>::type;
+        constexpr static std::size_t size = sizeof...(Entry);
+        static constexpr I keys_[size] = { Entry::key... };
+        static constexpr int handlers_[size] = { Entry::handler... };
+
+        // The position of the i-th entry in the sorted table. Entries with
+        // equal keys remain in handler order.
+        constexpr static std::size_t rank( std::size_t i, std::size_t j = 0 ) noexcept
+        {
+            return j == size ? 0 : std::size_t(keys_[j] < keys_[i] || (keys_[j] == keys_[i] && j < i)) + rank(i, j + 1);
+        }
+    };
+
+    template <class Entries, class Seq = leaf_detail_mp11::make_index_sequence<key_table_data<Entries>::size>>
+    struct key_table_ranks;
+
+    template <class Entries, std::size_t... S>
+    struct key_table_ranks<Entries, leaf_detail_mp11::index_sequence<S...>>
+    {
+        using data = key_table_data<Entries>;
+        static constexpr std::size_t ranks_[sizeof...(S)] = { data::rank(S)... };
+
+        constexpr static std::size_t at_rank( std::size_t r, std::size_t i = 0 ) noexcept
+        {
+            return ranks_[i] == r ? i : at_rank(r, i + 1);
+        }
+    };
+
+    template <class Entries, class Seq = leaf_detail_mp11::make_index_sequence<key_table_data<Entries>::size>>
+    struct key_table;
+
+    // Keys in ascending order, each with the index of the handler it selects.
+    template <class Entries, std::size_t... S>
+    struct key_table<Entries, leaf_detail_mp11::index_sequence<S...>>
+    {
+        using data = key_table_data<Entries>;
+        using ranks = key_table_ranks<Entries>;
+        using I = typename data::I;
+        constexpr static std::size_t size = sizeof...(S);
+        static constexpr I keys_[size] = { data::keys_[ranks::at_rank(S)]... };
+        static constexpr int handlers_[size] = { data::handlers_[ranks::at_rank(S)]... };
+
+        // Returns the index of the first handler in the run which matches k,
+        // or -1.
+        static int find( I k ) noexcept
+        {
+            std::size_t lo = 0, hi = size;
+            while( lo < hi )
+            {
+                std::size_t mid = lo + (hi - lo) / 2;
+                if( keys_[mid] < k )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo < size && keys_[lo] == k ? handlers_[lo] : -1;
+        }
+    };
+
+#if __cplusplus < 201703L
+    template <class... Entry>
+    constexpr typename key_table_data<leaf_detail_mp11::mp_list<Entry...>>::I key_table_data<leaf_detail_mp11::mp_list<Entry...>>::keys_[];
+
+    template <class... Entry>
+    constexpr int key_table_data<leaf_detail_mp11::mp_list<Entry...>>::handlers_[];
+
+    template <class Entries, std::size_t... S>
+    constexpr std::size_t key_table_ranks<Entries, leaf_detail_mp11::index_sequence<S...>>::ranks_[];
+
+    template <class Entries, std::size_t... S>
+    constexpr typename key_table<Entries, leaf_detail_mp11::index_sequence<S...>>::I key_table<Entries, leaf_detail_mp11::index_sequence<S...>>::keys_[];
+
+    template <class Entries, std::size_t... S>
+    constexpr int key_table<Entries, leaf_detail_mp11::index_sequence<S...>>::handlers_[];
+#endif
+
+    template <class H, bool = function_traits<H>::arity == 1>
+    struct handler_predicate_key
+    {
+        constexpr static bool value = false;
+        using key_source = void;
+    };
+
+    template <class H>
+    struct handler_predicate_key<H, true>: predicate_key<typename std::decay<fn_arg_type<H, 0>>::type>
+    {
+    };
+
+    template <class H, class Source, bool = handler_predicate_key<H>::value>
+    struct handler_key_source_is: std::false_type
+    {
+    };
+
+    template <class H, class Source>
+    struct handler_key_source_is<H, Source, true>: std::is_same<typename handler_predicate_key<H>::key_source, Source>
+    {
+    };
+
+    // The leading run of handlers in H... which take a single predicate with
+    // the given key_source. The last handler is never part of a run.
+    template <int I, class Source, bool InRun, class... H>
+    struct key_run_
+    {
+        constexpr static int length = I;
+        using entries = leaf_detail_mp11::mp_list<>;
+    };
+
+    template <int I, class Source, class Car, class Second, class... Cdr>
+    struct key_run_<I, Source, true, Car, Second, Cdr...>
+    {
+        using next = key_run_<I + 1, Source, sizeof...(Cdr) != 0 && handler_key_source_is<Second, Source>::value, Second, Cdr...>;
+        constexpr static int length = next::length;
+        using entries = leaf_detail_mp11::mp_append<typename key_entries<I, typename handler_predicate_key<Car>::values>::type, typename next::entries>;
+    };
+
+    template <class Car, class... Cdr>
+    struct key_run:
+        key_run_<0, typename handler_predicate_key<Car>::key_source, sizeof...(Cdr) != 0 && handler_predicate_key<Car>::value, Car, Cdr...>
+    {
+        template <class Tup>
+        static int find( Tup & tup, error_info const & ei ) noexcept
+        {
+            using pk = handler_predicate_key<Car>;
+            using table = key_table<typename key_run::entries>;
+            if( typename pk::error_type const * e = handler_argument_traits<typename pk::error_type>::check(tup, ei) )
+                return table::find(static_cast<typename table::I>(pk::key(*e)));
+            return -1;
+        }
+    };
+
+    template <class T>
+    using forwarded_type = typename std::conditional<std::is_lvalue_reference<T>::value, T, typename std::remove_reference<T>::type>::type;
+
+    template <class R, int I, class Context, class HTup>
+    BOOST_LEAF_CONSTEXPR inline
+    typename std::enable_if<I == 0, R>::type
+    call_handler_at_( Context & ctx, error_info const & ei, int, HTup & htup )
+    {
+        using F = forwarded_type<typename std::tuple_element<0, HTup>::type>;
+        return handler_caller<R, F>::call( ctx, ei, std::forward<F>(std::get<0>(htup)), fn_mp_args<F>{ } );
+    }
+
+    template <class R, int I, class Context, class HTup>
+    BOOST_LEAF_CONSTEXPR inline
+    typename std::enable_if<I != 0, R>::type
+    call_handler_at_( Context & ctx, error_info const & ei, int h, HTup & htup )
+    {
+        using F = forwarded_type<typename std::tuple_element<I, HTup>::type>;
+        if( h == I )
+            return handler_caller<R, F>::call( ctx, ei, std::forward<F>(std::get<I>(htup)), fn_mp_args<F>{ } );
+        else
+            return call_handler_at_<R, I - 1>(ctx, ei, h, htup);
+    }
+
+    template <std::size_t Offset, std::size_t... I>
+    leaf_detail_mp11::index_sequence<(Offset + I)...> offset_index_sequence( leaf_detail_mp11::index_sequence<I...> );
+
+    ////////////////////////////////////////
+
+    template <class R, class Context, class Mask, class H>
     BOOST_LEAF_CONSTEXPR inline
     typename std::enable_if<!is_tuple<typename std::decay<H>::type>::value, R>::type
-    handle_error_( Context & ctx, error_info const & ei, H && h )
+    select_handler_( Context & ctx, error_info const & ei, Mask const &, H && h )
     {
         static_assert( handler_matches_any_error<fn_mp_args<H>>::value, "The last handler passed to handle_all must match any error." );
         return handler_caller<R, H>::call( ctx, ei, std::forward<H>(h), fn_mp_args<H>{ } );
     }
 
-    template <class R, class Context, class Car, class... Cdr>
+    template <class R, class Context, class Mask, class Car, class... Cdr>
     BOOST_LEAF_CONSTEXPR inline
-    typename std::enable_if<!is_tuple<typename std::decay<Car>::type>::value, R>::type
-    handle_error_( Context & ctx, error_info const & ei, Car && car, Cdr && ... cdr )
+    typename std::enable_if<!is_tuple<typename std::decay<Car>::type>::value && key_run<Car, Cdr...>::length < 2, R>::type
+    select_handler_( Context & ctx, error_info const & ei, Mask const & m, Car && car, Cdr && ... cdr )
     {
-        if( handler_matches_any_error<fn_mp_args<Car>>::value || check_handler_( ctx.tup(), ei, fn_mp_args<Car>{ } ) )
+        if( handler_matches_any_error<fn_mp_args<Car>>::value || check_handler_( ctx.tup(), ei, m, fn_mp_args<Car>{ } ) )
             return handler_caller<R, Car>::call( ctx, ei, std::forward<Car>(car), fn_mp_args<Car>{ } );
         else
-            return handle_error_<R>( ctx, ei, std::forward<Cdr>(cdr)...);
+            return select_handler_<R>( ctx, ei, m, std::forward<Cdr>(cdr)...);
     }
 
-    template <class R, class Context, class HTup, size_t ... I>
+    template <class R, class Context, class Mask, class HTup, size_t ... I>
     BOOST_LEAF_CONSTEXPR inline
     R
-    handle_error_tuple_( Context & ctx, error_info const & ei, leaf_detail_mp11::index_sequence<I...>, HTup && htup )
+    select_handler_tuple_( Context & ctx, error_info const & ei, Mask const & m, leaf_detail_mp11::index_sequence<I...>, HTup && htup )
     {
-        return handle_error_<R>(ctx, ei, std::get<I>(std::forward<HTup>(htup))...);
+        return select_handler_<R>(ctx, ei, m, std::get<I>(std::forward<HTup>(htup))...);
     }
 
-    template <class R, class Context, class HTup, class... Cdr, size_t ... I>
+    template <class R, class Context, class Mask, class HTup, class... Cdr, size_t ... I>
     BOOST_LEAF_CONSTEXPR inline
     R
-    handle_error_tuple_( Context & ctx, error_info const & ei, leaf_detail_mp11::index_sequence<I...>, HTup && htup, Cdr && ... cdr )
+    select_handler_tuple_( Context & ctx, error_info const & ei, Mask const & m, leaf_detail_mp11::index_sequence<I...>, HTup && htup, Cdr && ... cdr )
+    {
+        return select_handler_<R>(ctx, ei, m, std::get<I>(std::forward<HTup>(htup))..., std::forward<Cdr>(cdr)...);
+    }
+
+    template <class R, class Context, class Mask, class Car, class... Cdr>
+    BOOST_LEAF_CONSTEXPR inline
+    typename std::enable_if<!is_tuple<typename std::decay<Car>::type>::value && key_run<Car, Cdr...>::length >= 2, R>::type
+    select_handler_( Context & ctx, error_info const & ei, Mask const & m, Car && car, Cdr && ... cdr )
     {
-        return handle_error_<R>(ctx, ei, std::get<I>(std::forward<HTup>(htup))..., std::forward<Cdr>(cdr)...);
+        using run = key_run<Car, Cdr...>;
+        auto htup = std::forward_as_tuple(std::forward<Car>(car), std::forward<Cdr>(cdr)...);
+        int const h = run::find(ctx.tup(), ei);
+        if( h >= 0 )
+            return call_handler_at_<R, run::length - 1>(ctx, ei, h, htup);
+        else
+            return select_handler_tuple_<R>(ctx, ei, m,
+                decltype(offset_index_sequence<run::length>(leaf_detail_mp11::make_index_sequence<1 + sizeof...(Cdr) - run::length>())){ },
+                std::move(htup));
     }
 
-    template <class R, class Context, class H>
+    template <class R, class Context, class Mask, class H>
     BOOST_LEAF_CONSTEXPR inline
     typename std::enable_if<is_tuple<typename std::decay<H>::type>::value, R>::type
-    handle_error_( Context & ctx, error_info const & ei, H && h )
+    select_handler_( Context & ctx, error_info const & ei, Mask const & m, H && h )
     {
-        return handle_error_tuple_<R>(
+        return select_handler_tuple_<R>(
             ctx,
             ei,
+            m,
             leaf_detail_mp11::make_index_sequence<std::tuple_size<typename std::decay<H>::type>::value>(),
             std::forward<H>(h));
     }
 
-    template <class R, class Context, class Car, class... Cdr>
+    template <class R, class Context, class Mask, class Car, class... Cdr>
     BOOST_LEAF_CONSTEXPR inline
     typename std::enable_if<is_tuple<typename std::decay<Car>::type>::value, R>::type
-    handle_error_( Context & ctx, error_info const & ei, Car && car, Cdr && ... cdr )
+    select_handler_( Context & ctx, error_info const & ei, Mask const & m, Car && car, Cdr && ... cdr )
     {
-        return handle_error_tuple_<R>(
+        return select_handler_tuple_<R>(
             ctx,
             ei,
+            m,
             leaf_detail_mp11::make_index_sequence<std::tuple_size<typename std::decay<Car>::type>::value>(),
             std::forward<Car>(car),
             std::forward<Cdr>(cdr)...);
     }
+
+    template <class R, class Context, class... H>
+    BOOST_LEAF_CONSTEXPR inline
+    R
+    handle_error_( Context & ctx, error_info const & ei, H && ... h )
+    {
+        using Tup = typename std::decay<decltype(ctx.tup())>::type;
+        slot_mask<Tup> const m(ctx.tup(), ei);
+        return select_handler_<R>(ctx, ei, m, std::forward<H>(h)...);
+    }
 } // namespace detail
 
 ////////////////////////////////////////
@@ -706,13 +1093,13 @@ namespace detail
     {
         using leaf_result = LeafResult;
 
-        template <class TryBlock>
+        template <class TryBlock, class... A>
         inline
         static
         leaf_result
-        try_capture_all_( TryBlock && try_block )
+        try_capture_all_( TryBlock && try_block, A... a )
         {
-            detail::slot<detail::dynamic_allocator> sl;
+            detail::slot<detail::dynamic_allocator> sl(nullptr, a...);
             sl.activate();
 #ifndef BOOST_LEAF_NO_EXCEPTIONS
             try
@@ -726,7 +1113,7 @@ namespace detail
                 else
                 {
                     sl.deactivate();
-                    int const err_id = error_id(r.error()).value();
+                    error_id_int const err_id = error_id(r.error()).value();
                     return leaf_result(sl.get().template extract_capture_list<leaf_result>(err_id));
                 }
             }
@@ -734,13 +1121,13 @@ namespace detail
             catch( std::exception & ex )
             {
                 sl.deactivate();
-                int err_id = unpack_error_id(ex).value();
+                error_id_int err_id = unpack_error_id(ex).value();
                 return sl.get().template extract_capture_list<leaf_result>(err_id);
             }
             catch(...)
             {
                 sl.deactivate();
-                int err_id = current_error().value();
+                error_id_int err_id = current_error().value();
                 return sl.get().template extract_capture_list<leaf_result>(err_id);
             }
 #endif // #ifndef BOOST_LEAF_NO_EXCEPTIONS
@@ -767,13 +1154,13 @@ namespace detail
     {
         using leaf_result = ::boost::leaf::result<R>;
 
-        template <class TryBlock>
+        template <class TryBlock, class... A>
         inline
         static
         leaf_result
-        try_capture_all_( TryBlock && try_block )
+        try_capture_all_( TryBlock && try_block, A... a )
         {
-            detail::slot<detail::dynamic_allocator> sl;
+            detail::slot<detail::dynamic_allocator> sl(nullptr, a...);
             sl.activate();
 #ifndef BOOST_LEAF_NO_EXCEPTIONS
             try
@@ -786,13 +1173,13 @@ namespace detail
             catch( std::exception & ex )
             {
                 sl.deactivate();
-                int err_id = unpack_error_id(ex).value();
+                error_id_int err_id = unpack_error_id(ex).value();
                 return sl.get().template extract_capture_list<leaf_result>(err_id);
             }
             catch(...)
             {
                 sl.deactivate();
-                int err_id = current_error().value();
+                error_id_int err_id = current_error().value();
                 return sl.get().template extract_capture_list<leaf_result>(err_id);
             }
 #endif // #ifndef BOOST_LEAF_NO_EXCEPTIONS
@@ -808,6 +1195,16 @@ try_capture_all( TryBlock && try_block ) noexcept
     return detail::try_capture_all_dispatch<decltype(std::declval<TryBlock>()())>::try_capture_all_(std::forward<TryBlock>(try_block));
 }
 
+#if BOOST_LEAF_CFG_STD_PMR
+template <class TryBlock>
+inline
+typename detail::try_capture_all_dispatch<decltype(std::declval<TryBlock>()())>::leaf_result
+try_capture_all( std::pmr::memory_resource & mr, TryBlock && try_block ) noexcept
+{
+    return detail::try_capture_all_dispatch<decltype(std::declval<TryBlock>()())>::try_capture_all_(std::forward<TryBlock>(try_block), &mr);
+}
+#endif
+
 #endif // #if BOOST_LEAF_CFG_CAPTURE
 
 } } // namespace boost::leaf
@@ -8,33 +8,38 @@
 #include <boost/leaf/config.hpp>
 #include <boost/leaf/error.hpp>
 
+#define BOOST_LEAF_TRACE(Trace) auto BOOST_LEAF_TOKEN_PASTE2(boost_leaf_trace_, __LINE__) = ::boost::leaf::on_error([]( Trace & tr ) noexcept { tr.push(__FILE__, __LINE__); })
+
 namespace boost { namespace leaf {
 
+// Under BOOST_LEAF_CFG_MONITOR_EXCEPTIONS=0 (or BOOST_LEAF_NO_EXCEPTIONS), the
+// only state is the current error id at the time of construction, so that
+// checking for an error takes a single TLS load and a compare.
 class error_monitor
 {
-#if !defined(BOOST_LEAF_NO_EXCEPTIONS) && BOOST_LEAF_STD_UNCAUGHT_EXCEPTIONS
+#if !defined(BOOST_LEAF_NO_EXCEPTIONS) && BOOST_LEAF_CFG_MONITOR_EXCEPTIONS && BOOST_LEAF_STD_UNCAUGHT_EXCEPTIONS
     int const uncaught_exceptions_;
 #endif
-    int const err_id_;
+    detail::error_id_int const err_id_;
 
 public:
 
     error_monitor() noexcept:
-#if !defined(BOOST_LEAF_NO_EXCEPTIONS) && BOOST_LEAF_STD_UNCAUGHT_EXCEPTIONS
+#if !defined(BOOST_LEAF_NO_EXCEPTIONS) && BOOST_LEAF_CFG_MONITOR_EXCEPTIONS && BOOST_LEAF_STD_UNCAUGHT_EXCEPTIONS
         uncaught_exceptions_(std::uncaught_exceptions()),
 #endif
         err_id_(detail::current_id())
     {
     }
 
-    int check_id() const noexcept
+    detail::error_id_int check_id() const noexcept
     {
-        int err_id = detail::current_id();
+        detail::error_id_int err_id = detail::current_id();
         if( err_id != err_id_ )
             return err_id;
         else
         {
-#ifndef BOOST_LEAF_NO_EXCEPTIONS
+#if !defined(BOOST_LEAF_NO_EXCEPTIONS) && BOOST_LEAF_CFG_MONITOR_EXCEPTIONS
 #   if BOOST_LEAF_STD_UNCAUGHT_EXCEPTIONS
             if( std::uncaught_exceptions() > uncaught_exceptions_ )
 #   else
@@ -46,9 +51,9 @@ public:
         }
     }
 
-    int get_id() const noexcept
+    detail::error_id_int get_id() const noexcept
     {
-        int err_id = detail::current_id();
+        detail::error_id_int err_id = detail::current_id();
         if( err_id != err_id_ )
             return err_id;
         else
@@ -73,7 +78,7 @@ namespace detail
     template <int I, class Tup>
     struct tuple_for_each_preload
     {
-        BOOST_LEAF_CONSTEXPR static void trigger( Tup & tup, int err_id ) noexcept
+        BOOST_LEAF_CONSTEXPR static void trigger( Tup & tup, error_id_int err_id ) noexcept
         {
             BOOST_LEAF_ASSERT((err_id&3) == 1);
             tuple_for_each_preload<I-1,Tup>::trigger(tup,err_id);
@@ -92,7 +97,7 @@ namespace detail
     template <class Tup>
     struct tuple_for_each_preload<0, Tup>
     {
-        BOOST_LEAF_CONSTEXPR static void trigger( Tup const &, int ) noexcept { }
+        BOOST_LEAF_CONSTEXPR static void trigger( Tup const &, error_id_int ) noexcept { }
 
 #if BOOST_LEAF_CFG_CAPTURE
         static void reserve( Tup const &, dynamic_allocator & ) { }
@@ -112,7 +117,7 @@ namespace detail
         {
         }
 
-        BOOST_LEAF_CONSTEXPR void trigger( int err_id ) noexcept
+        BOOST_LEAF_CONSTEXPR void trigger( error_id_int err_id ) noexcept
         {
             if( slot<E_decayed> * p = tls::read_ptr<slot<E_decayed>>() )
                 if( !p->has_value(err_id) )
@@ -140,7 +145,7 @@ namespace detail
         {
         }
 
-        void trigger( int err_id ) noexcept
+        void trigger( error_id_int err_id ) noexcept
         {
             if( slot<E_decayed> * p = tls::read_ptr<slot<E_decayed>>() )
                 if( !p->has_value(err_id) )
@@ -179,7 +184,7 @@ namespace detail
         {
         }
 
-        void trigger( int ) noexcept
+        void trigger( error_id_int ) noexcept
         {
 #ifndef BOOST_LEAF_NO_EXCEPTIONS
             try
@@ -217,7 +222,7 @@ namespace detail
         {
         }
 
-        void trigger( int err_id ) noexcept
+        void trigger( error_id_int err_id ) noexcept
         {
             if( slot<E_decayed> * p = tls::read_ptr<slot<E_decayed>>() )
             {
@@ -280,10 +285,10 @@ namespace detail
             if( moved_ )
                 return;
 #endif
-            if( int const err_id = id_.check_id() )
+            if( error_id_int const err_id = id_.check_id() )
             {
 #if BOOST_LEAF_CFG_CAPTURE
-                if( dynamic_allocator * da = get_dynamic_allocator() )
+                if( dynamic_allocator * da = get_dynamic_allocator(err_id) )
 #   ifndef BOOST_LEAF_NO_EXCEPTIONS
                     try
                     {
@@ -188,6 +188,98 @@ struct is_predicate<match_value<E, V1, V...>>: std::true_type
 
 ////////////////////////////////////////
 
+namespace detail
+{
+    template <class E, class K, bool IsMatchValue>
+    struct match_key_source
+    {
+    };
+
+    template <class T, class K>
+    struct is_key_of_type: std::integral_constant<bool, std::is_same<typename std::remove_cv<T>::type, K>::value>
+    {
+    };
+
+#if __cplusplus >= 201703L
+    template <class K, auto... V>
+    struct all_keys_of_type: std::true_type
+    {
+    };
+
+    template <class K, auto V1, auto... V>
+    struct all_keys_of_type<K, V1, V...>: std::integral_constant<bool, is_key_of_type<decltype(V1), K>::value && all_keys_of_type<K, V...>::value>
+    {
+    };
+#else
+    template <class K, K... V>
+    struct all_keys_of_type: std::true_type
+    {
+    };
+#endif
+
+    template <class E, class K, bool IsMatchValue, bool KeyTypeOK>
+    struct match_predicate_key_impl
+    {
+        constexpr static bool value = false;
+        using key_source = void;
+    };
+
+    template <class E, class K, bool IsMatchValue>
+    struct match_predicate_key_impl<E, K, IsMatchValue, true>
+    {
+        constexpr static bool value = true;
+        using error_type = E;
+        using key_type = K;
+        using key_source = match_key_source<E, K, IsMatchValue>;
+    };
+
+    template <class E, class K, bool IsMatchValue, class Key, bool ValuesOK>
+    using match_predicate_key_base = match_predicate_key_impl<E, K, IsMatchValue,
+        (std::is_integral<K>::value || std::is_enum<K>::value) && ValuesOK && is_key_of_type<Key, K>::value>;
+
+    template <class E, BOOST_LEAF_MATCH_ARGS(match_enum_type<E>, V1, V)>
+    struct predicate_key<match<E, V1, V...>>:
+        match_predicate_key_base<E, typename match_enum_type<E>::type, false, E, all_keys_of_type<typename match_enum_type<E>::type, V1, V...>::value>
+    {
+        using values = key_values<typename match_enum_type<E>::type, V1, V...>;
+
+        BOOST_LEAF_CONSTEXPR static E key( E const & e ) noexcept
+        {
+            return e;
+        }
+    };
+
+    template <class E, BOOST_LEAF_MATCH_ARGS(match_value_enum_type<E>, V1, V)>
+    struct predicate_key<match_value<E, V1, V...>>:
+        match_predicate_key_base<E, typename match_value_enum_type<E>::type, true, decltype(std::declval<E>().value), all_keys_of_type<typename match_value_enum_type<E>::type, V1, V...>::value>
+    {
+        using values = key_values<typename match_value_enum_type<E>::type, V1, V...>;
+
+        BOOST_LEAF_CONSTEXPR static auto key( E const & e ) noexcept -> decltype(e.value)
+        {
+            return e.value;
+        }
+    };
+
+#if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
+    template <class Enum, BOOST_LEAF_MATCH_ARGS(BOOST_LEAF_ESC(match_enum_type<condition<Enum, Enum>>), V1, V)>
+    struct predicate_key<match<condition<Enum, Enum>, V1, V...>>
+    {
+        constexpr static bool value = false;
+        using key_source = void;
+    };
+
+    template <class E, class Enum, BOOST_LEAF_MATCH_ARGS(BOOST_LEAF_ESC(match_value_enum_type<condition<E, Enum>>), V1, V)>
+    struct predicate_key<match_value<condition<E, Enum>, V1, V...>>
+    {
+        constexpr static bool value = false;
+        using key_source = void;
+    };
+#endif // #if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
+} // namespace detail
+
+////////////////////////////////////////
+
 #if __cplusplus >= 201703L
 template <auto, auto, auto...>
 struct match_member;
@@ -237,19 +329,18 @@ struct is_predicate<if_not<P>>: std::true_type
 
 namespace detail
 {
-    template <class Ex>
-    BOOST_LEAF_CONSTEXPR inline bool check_exception_pack( std::exception const & ex, Ex const * ) noexcept
-    {
-        return dynamic_cast<Ex const *>(&ex) != nullptr;
-    }
-
-    template <class Ex, class... ExRest>
-    BOOST_LEAF_CONSTEXPR inline bool check_exception_pack( std::exception const & ex, Ex const *, ExRest const * ... ex_rest ) noexcept
+    template <class... Ex>
+    inline bool check_exception_pack( std::exception const & ex, leaf_detail_mp11::mp_list<Ex...> ) noexcept
     {
-        return dynamic_cast<Ex const *>(&ex) != nullptr || check_exception_pack(ex, ex_rest...);
+        void const * p[sizeof...(Ex)];
+        dynamic_cast_cache<Ex...>::cast(ex, p);
+        for( void const * x : p )
+            if( x )
+                return true;
+        return false;
     }
 
-    BOOST_LEAF_CONSTEXPR inline bool check_exception_pack( std::exception const & ) noexcept
+    inline bool check_exception_pack( std::exception const &, leaf_detail_mp11::mp_list<> ) noexcept
     {
         return true;
     }
@@ -261,9 +352,9 @@ struct catch_
     using error_type = void;
     std::exception const & matched;
 
-    BOOST_LEAF_CONSTEXPR static bool evaluate(std::exception const & ex) noexcept
+    static bool evaluate(std::exception const & ex) noexcept
     {
-        return detail::check_exception_pack(ex, static_cast<Ex const *>(nullptr)...);
+        return detail::check_exception_pack(ex, leaf_detail_mp11::mp_list<Ex...>{ });
     }
 };
 
@@ -273,13 +364,13 @@ struct catch_<Ex>
     using error_type = void;
     Ex const & matched;
 
-    BOOST_LEAF_CONSTEXPR static Ex const * evaluate(std::exception const & ex) noexcept
+    static Ex const * evaluate(std::exception const & ex) noexcept
     {
-        return dynamic_cast<Ex const *>(&ex);
+        return detail::cached_dynamic_cast<Ex>(ex);
     }
 
     explicit catch_( std::exception const & ex ):
-        matched(*dynamic_cast<Ex const *>(&ex))
+        matched(*detail::cached_dynamic_cast<Ex>(ex))
     {
     }
 };
@@ -11,6 +11,8 @@
 #include <boost/leaf/detail/capture_list.hpp>
 
 #include <functional>
+#include <climits>
+#include <cstdint>
 
 namespace boost { namespace leaf {
 
@@ -27,6 +29,20 @@ class bad_result:
 
 ////////////////////////////////////////
 
+// Specialize to opt into storing the error state of result<T> in otherwise
+// invalid values of T, so that sizeof(result<T>) == sizeof(T). Supported for
+// pointers to (complete) object types with alignment of at least 4, and for
+// enums with a fixed underlying type at least as wide as the error id, whose
+// valid values do not have the most significant bit set. The specialization
+// must be visible wherever result<T> is used. It has no effect under
+// BOOST_LEAF_CFG_CAPTURE.
+template <class T>
+struct is_result_niche: std::false_type
+{
+};
+
+////////////////////////////////////////
+
 namespace detail
 {
     template <class T>
@@ -75,7 +91,7 @@ namespace detail
 
     class result_discriminant
     {
-        int state_;
+        error_id_int state_;
 
     public:
 
@@ -95,7 +111,7 @@ namespace detail
         }
 
 #if BOOST_LEAF_CFG_CAPTURE
-        explicit result_discriminant( int err_id, detail::capture_list const & ) noexcept:
+        explicit result_discriminant( error_id_int err_id, detail::capture_list const & ) noexcept:
             state_((err_id&~3) | 2)
         {
             BOOST_LEAF_ASSERT((err_id&3) == 1);
@@ -119,22 +135,349 @@ namespace detail
         error_id get_error_id() const noexcept
         {
             BOOST_LEAF_ASSERT(kind() == err_id_zero || kind() == err_id || kind() == err_id_capture_list);
-            return make_error_id(int((state_&~3)|1));
+            return make_error_id((state_&~3)|1);
         }
     }; // class result_discriminant
+
+    ////////////////////////////////////////
+
+    // Niche policies: encode an error id in an otherwise invalid value of T.
+    template <class T, bool = is_result_niche<T>::value, class = void>
+    struct result_niche
+    {
+        static constexpr bool value = false;
+    };
+
+    // Pointers: error ids have their two low bits set to 01, which is never
+    // the case for a pointer to a type with alignment of 4 or more.
+    template <class T>
+    struct result_niche<T *, true, typename std::enable_if<std::is_object<T>::value>::type>
+    {
+        static constexpr bool value =
+            alignof(T) >= 4 &&
+            sizeof(T *) == sizeof(std::uintptr_t) &&
+            sizeof(std::uintptr_t) >= sizeof(error_id_int);
+
+        static bool has_value( T * p ) noexcept
+        {
+            return (reinterpret_cast<std::uintptr_t>(p) & 3) == 0;
+        }
+
+        static T * encode( error_id_int err_id ) noexcept
+        {
+            return reinterpret_cast<T *>(std::uintptr_t(error_id_uint(err_id)) | 1);
+        }
+
+        static error_id_int decode( T * p ) noexcept
+        {
+            BOOST_LEAF_ASSERT(!has_value(p));
+            return error_id_int(error_id_uint(reinterpret_cast<std::uintptr_t>(p)));
+        }
+    };
+
+    // Enums: error ids are stored with the most significant bit set, with the
+    // two (constant) low bits of the error id dropped.
+    template <class E>
+    struct result_niche<E, true, typename std::enable_if<std::is_enum<E>::value>::type>
+    {
+        using uint = typename std::make_unsigned<typename std::underlying_type<E>::type>::type;
+        static constexpr uint msb = uint(uint(1) << (sizeof(uint) * CHAR_BIT - 1));
+
+        static constexpr bool value = sizeof(uint) >= sizeof(error_id_int);
+
+        static bool has_value( E e ) noexcept
+        {
+            return (uint(e) & msb) == 0;
+        }
+
+        static E encode( error_id_int err_id ) noexcept
+        {
+            return E(msb | uint(error_id_uint(err_id) >> 2));
+        }
+
+        static error_id_int decode( E e ) noexcept
+        {
+            BOOST_LEAF_ASSERT(!has_value(e));
+            return error_id_int((error_id_uint(uint(e) & ~msb) << 2) | 1);
+        }
+    };
+
+    ////////////////////////////////////////
+
+    enum class result_layout
+    {
+        general,
+        trivial,
+        niche
+    };
+
+    // Storage for result<T>: either a value of type T, or an error id,
+    // optionally with a capture_list. If no capture_list can be stored (that
+    // is, under BOOST_LEAF_CFG_CAPTURE=0) and T is trivially copyable,
+    // result<T> is trivially copyable as well, so that the Itanium C++ ABI
+    // passes and returns it in registers. If in addition T opts into
+    // is_result_niche, the error id is stored in T itself.
+    template <class T, result_layout =
+        BOOST_LEAF_CFG_CAPTURE ? result_layout::general :
+        result_niche<T>::value ? result_layout::niche :
+        std::is_trivially_copyable<T>::value ? result_layout::trivial :
+        result_layout::general>
+    class result_storage
+    {
+        template <class U, result_layout>
+        friend class result_storage;
+
+    protected:
+
+        union
+        {
+            T stored_;
+#if BOOST_LEAF_CFG_CAPTURE
+            mutable capture_list cap_;
+#endif
+        };
+
+        result_discriminant what_;
+
+        result_discriminant what() const noexcept
+        {
+            return what_;
+        }
+
+        void destroy() const noexcept
+        {
+            switch(auto k = this->what_.kind())
+            {
+            default:
+                BOOST_LEAF_ASSERT(k == result_discriminant::err_id);
+                (void) k;
+            case result_discriminant::err_id_zero:
+                break;
+            case result_discriminant::err_id_capture_list:
+#if BOOST_LEAF_CFG_CAPTURE
+                cap_.~capture_list();
+#else
+                BOOST_LEAF_ASSERT(0); // Possible ODR violation.
+#endif
+                break;
+            case result_discriminant::val:
+                stored_.~T();
+            }
+        }
+
+        template <class U, result_layout L>
+        result_discriminant move_from( result_storage<U, L> && x ) noexcept
+        {
+            auto x_what = x.what();
+            switch(auto k = x_what.kind())
+            {
+            default:
+                BOOST_LEAF_ASSERT(k == result_discriminant::err_id);
+                (void) k;
+            case result_discriminant::err_id_zero:
+                break;
+            case result_discriminant::err_id_capture_list:
+#if BOOST_LEAF_CFG_CAPTURE
+                (void) new(&cap_) capture_list(std::move(x.cap_));
+#else
+                BOOST_LEAF_ASSERT(0); // Possible ODR violation.
+#endif
+                break;
+            case result_discriminant::val:
+                (void) new(&stored_) T(std::move(x.stored_));
+            }
+            return x_what;
+        }
+
+        template <class U, result_layout L>
+        void move_assign( result_storage<U, L> && x ) noexcept
+        {
+            destroy();
+            what_ = move_from(std::move(x));
+        }
+
+        template <class... A>
+        explicit result_storage( result_discriminant::kind_val k, A && ... a ):
+            stored_(std::forward<A>(a)...),
+            what_(k)
+        {
+        }
+
+        explicit result_storage( error_id err ) noexcept:
+            what_(err)
+        {
+        }
+
+#if BOOST_LEAF_CFG_CAPTURE
+        result_storage( error_id_int err_id, capture_list && cap ) noexcept:
+            cap_(std::move(cap)),
+            what_(err_id, cap)
+        {
+        }
+#endif
+
+        template <class U, result_layout L>
+        explicit result_storage( result_storage<U, L> && x ) noexcept:
+            what_(move_from(std::move(x)))
+        {
+        }
+
+        result_storage( result_storage && x ) noexcept:
+            what_(move_from(std::move(x)))
+        {
+        }
+
+        ~result_storage() noexcept
+        {
+            destroy();
+        }
+
+        result_storage & operator=( result_storage && x ) noexcept
+        {
+            move_assign(std::move(x));
+            return *this;
+        }
+    }; // template result_storage
+
+    template <class T>
+    class result_storage<T, result_layout::trivial>
+    {
+        template <class U, result_layout>
+        friend class result_storage;
+
+    protected:
+
+        union
+        {
+            T stored_;
+        };
+
+        result_discriminant what_;
+
+        result_discriminant what() const noexcept
+        {
+            return what_;
+        }
+
+        template <class U, result_layout L>
+        result_discriminant move_from( result_storage<U, L> && x ) noexcept
+        {
+            auto x_what = x.what();
+            BOOST_LEAF_ASSERT(x_what.kind() != result_discriminant::err_id_capture_list);
+            if( x_what.kind() == result_discriminant::val )
+                (void) new(&stored_) T(std::move(x.stored_));
+            return x_what;
+        }
+
+        template <class U, result_layout L>
+        void move_assign( result_storage<U, L> && x ) noexcept
+        {
+            what_ = move_from(std::move(x));
+        }
+
+        template <class... A>
+        explicit result_storage( result_discriminant::kind_val k, A && ... a ):
+            stored_(std::forward<A>(a)...),
+            what_(k)
+        {
+        }
+
+        explicit result_storage( error_id err ) noexcept:
+            what_(err)
+        {
+        }
+
+        template <class U, result_layout L>
+        explicit result_storage( result_storage<U, L> && x ) noexcept:
+            what_(move_from(std::move(x)))
+        {
+        }
+
+        result_storage( result_storage && ) = default;
+        result_storage & operator=( result_storage && ) = default;
+    }; // template result_storage (trivial)
+
+    template <class T>
+    class result_storage<T, result_layout::niche>
+    {
+        template <class U, result_layout>
+        friend class result_storage;
+
+        using niche = result_niche<T>;
+
+    protected:
+
+        // Always holds a T: either a value, or an error id encoded by niche.
+        T stored_;
+
+        result_discriminant what() const noexcept
+        {
+            if( niche::has_value(stored_) )
+                return result_discriminant(result_discriminant::kind_val{});
+            else
+                return result_discriminant(make_error_id(niche::decode(stored_)));
+        }
+
+        template <class U, result_layout L>
+        static T move_from( result_storage<U, L> && x ) noexcept
+        {
+            auto x_what = x.what();
+            BOOST_LEAF_ASSERT(x_what.kind() != result_discriminant::err_id_capture_list);
+            if( x_what.kind() == result_discriminant::val )
+            {
+                T v(std::move(x.stored_));
+                BOOST_LEAF_ASSERT(niche::has_value(v));
+                return v;
+            }
+            return niche::encode(x_what.get_error_id().value());
+        }
+
+        template <class U, result_layout L>
+        void move_assign( result_storage<U, L> && x ) noexcept
+        {
+            stored_ = move_from(std::move(x));
+        }
+
+        template <class... A>
+        explicit result_storage( result_discriminant::kind_val, A && ... a ):
+            stored_(std::forward<A>(a)...)
+        {
+            BOOST_LEAF_ASSERT(niche::has_value(stored_));
+        }
+
+        explicit result_storage( error_id err ) noexcept:
+            stored_(niche::encode(err.value()))
+        {
+        }
+
+        template <class U, result_layout L>
+        explicit result_storage( result_storage<U, L> && x ) noexcept:
+            stored_(move_from(std::move(x)))
+        {
+        }
+
+        result_storage( result_storage && ) = default;
+        result_storage & operator=( result_storage && ) = default;
+    }; // template result_storage (niche)
 } // namespace detail
 
 ////////////////////////////////////////
 
 template <class T>
-class BOOST_LEAF_ATTRIBUTE_NODISCARD result
+class BOOST_LEAF_ATTRIBUTE_NODISCARD result:
+    detail::result_storage<typename detail::stored<T>::type>
 {
     template <class U>
     friend class result;
 
+    using storage = detail::result_storage<typename detail::stored<T>::type>;
+    using storage::stored_;
+    using storage::what;
+
 #if BOOST_LEAF_CFG_CAPTURE
     friend class detail::dynamic_allocator;
     using capture_list = detail::capture_list;
+    using storage::cap_;
 #endif
 
     using result_discriminant = detail::result_discriminant;
@@ -146,16 +489,6 @@ class BOOST_LEAF_ATTRIBUTE_NODISCARD result
     using value_rv_ref = typename detail::stored<T>::value_rv_ref;
     using value_rv_cref = typename detail::stored<T>::value_rv_cref;
 
-    union
-    {
-        stored_type stored_;
-#if BOOST_LEAF_CFG_CAPTURE
-        mutable capture_list cap_;
-#endif
-    };
-
-    result_discriminant what_;
-
     struct error_result
     {
         error_result( error_result && ) = default;
@@ -172,7 +505,7 @@ class BOOST_LEAF_ATTRIBUTE_NODISCARD result
         template <class U>
         operator result<U>() noexcept
         {
-            result_discriminant const what = r_.what_;
+            result_discriminant const what = r_.what();
             switch(auto k = what.kind())
             {
                 case result_discriminant::val:
@@ -193,62 +526,17 @@ class BOOST_LEAF_ATTRIBUTE_NODISCARD result
 
         operator error_id() const noexcept
         {
-            result_discriminant const what = r_.what_;
+            result_discriminant const what = r_.what();
             return what.kind() == result_discriminant::val?
                 error_id() :
                 what.get_error_id();
         }
     };
 
-    void destroy() const noexcept
-    {
-        switch(auto k = this->what_.kind())
-        {
-        default:
-            BOOST_LEAF_ASSERT(k == result_discriminant::err_id);
-            (void) k;
-        case result_discriminant::err_id_zero:
-            break;
-        case result_discriminant::err_id_capture_list:
-#if BOOST_LEAF_CFG_CAPTURE
-            cap_.~capture_list();
-#else
-            BOOST_LEAF_ASSERT(0); // Possible ODR violation.
-#endif
-            break;
-        case result_discriminant::val:
-            stored_.~stored_type();
-        }
-    }
-
-    template <class U>
-    result_discriminant move_from( result<U> && x ) noexcept
-    {
-        auto x_what = x.what_;
-        switch(auto k = x_what.kind())
-        {
-        default:
-            BOOST_LEAF_ASSERT(k == result_discriminant::err_id);
-            (void) k;
-        case result_discriminant::err_id_zero:
-            break;
-        case result_discriminant::err_id_capture_list:
-#if BOOST_LEAF_CFG_CAPTURE
-            (void) new(&cap_) capture_list(std::move(x.cap_));
-#else
-            BOOST_LEAF_ASSERT(0); // Possible ODR violation.
-#endif
-            break;
-        case result_discriminant::val:
-            (void) new(&stored_) stored_type(std::move(x.stored_));
-        }
-        return x_what;
-    }
-
     error_id get_error_id() const noexcept
     {
-        BOOST_LEAF_ASSERT(what_.kind() != result_discriminant::val);
-        return what_.get_error_id();
+        BOOST_LEAF_ASSERT(what().kind() != result_discriminant::val);
+        return what().get_error_id();
     }
 
     stored_type const * get() const noexcept
@@ -264,20 +552,19 @@ class BOOST_LEAF_ATTRIBUTE_NODISCARD result
 protected:
 
 #if BOOST_LEAF_CFG_CAPTURE
-    result( int err_id, detail::capture_list && cap ) noexcept:
-        cap_(std::move(cap)),
-        what_(err_id, cap)
+    result( detail::error_id_int err_id, detail::capture_list && cap ) noexcept:
+        storage(err_id, std::move(cap))
     {
     }
 #endif
 
     void enforce_value_state() const
     {
-        switch( what_.kind() )
+        switch( what().kind() )
         {
         case result_discriminant::err_id_capture_list:
 #if BOOST_LEAF_CFG_CAPTURE
-            cap_.unload(what_.get_error_id().value());
+            cap_.unload(what().get_error_id().value());
 #else
             BOOST_LEAF_ASSERT(0); // Possible ODR violation.
 #endif
@@ -289,18 +576,13 @@ protected:
         }
     }
 
-    template <class U>
-    void move_assign( result<U> && x ) noexcept
-    {
-        destroy();
-        what_ = move_from(std::move(x));
-    }
+    using storage::move_assign;
 
     template <class Encoder>
     error_id output_error_to(Encoder & e) const
     {
         static_assert(std::is_base_of<detail::encoder, Encoder>::value, "Encoder must derive from detail::encoder");
-        result_discriminant const what = what_;
+        result_discriminant const what = this->what();
         BOOST_LEAF_ASSERT(what.kind() != result_discriminant::val);
         error_id const err_id = what.get_error_id();
         detail::serialize_(e, err_id);
@@ -311,7 +593,7 @@ protected:
     void output_capture_to(Encoder & e, error_id err_id) const
     {
         static_assert(std::is_base_of<detail::encoder, Encoder>::value, "Encoder must derive from detail::encoder");
-        if( what_.kind() == result_discriminant::err_id_capture_list )
+        if( what().kind() == result_discriminant::err_id_capture_list )
         {
 #if BOOST_LEAF_CFG_CAPTURE
             cap_.serialize_to(e, err_id);
@@ -335,46 +617,38 @@ public:
 
     using value_type = T;
 
-    // NOTE: Copy constructor implicitly deleted.
-
-    result( result && x ) noexcept:
-        what_(move_from(std::move(x)))
-    {
-    }
+    // NOTE: Copy constructor implicitly deleted, move constructor and
+    // destructor implicitly defined (trivial if result_storage is trivial).
 
     template <class U, class = typename std::enable_if<std::is_convertible<U, T>::value>::type>
     result( result<U> && x ) noexcept:
-        what_(move_from(std::move(x)))
+        storage(static_cast<typename result<U>::storage &&>(x))
     {
     }
 
     result():
-        stored_(stored_type()),
-        what_(result_discriminant::kind_val{})
+        storage(result_discriminant::kind_val{})
     {
     }
 
     result( value_no_ref && v ) noexcept:
-        stored_(std::forward<value_no_ref>(v)),
-        what_(result_discriminant::kind_val{})
+        storage(result_discriminant::kind_val{}, std::forward<value_no_ref>(v))
     {
     }
 
     result( value_no_ref const & v ):
-        stored_(v),
-        what_(result_discriminant::kind_val{})
+        storage(result_discriminant::kind_val{}, v)
     {
     }
 
     template<class... A, class = typename std::enable_if<std::is_constructible<T, A...>::value && sizeof...(A) >= 2>::type>
     result( A && ... a ) noexcept:
-        stored_(std::forward<A>(a)...),
-        what_(result_discriminant::kind_val{})
+        storage(result_discriminant::kind_val{}, std::forward<A>(a)...)
     {
     }
 
     result( error_id err ) noexcept:
-        what_(err)
+        storage(err)
     {
     }
 
@@ -388,8 +662,7 @@ public:
     // SFINAE: T can be initialized with an A, e.g. result<std::string>("literal").
     template<class A, class = typename std::enable_if<std::is_constructible<T, A>::value && std::is_convertible<A, T>::value>::type>
     result( A && a ) noexcept:
-        stored_(std::forward<A>(a)),
-        what_(result_discriminant::kind_val{})
+        storage(result_discriminant::kind_val{}, std::forward<A>(a))
     {
     }
 
@@ -402,8 +675,7 @@ public:
     // SFINAE: T can be initialized with an A, e.g. result<std::string>("literal").
     template <class A>
     result( A && a, decltype(init_T_with_A(std::forward<A>(a))) * = nullptr ):
-        stored_(std::forward<A>(a)),
-        what_(result_discriminant::kind_val{})
+        storage(result_discriminant::kind_val{}, std::forward<A>(a))
     {
     }
 
@@ -411,40 +683,30 @@ public:
 
 #if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
     result( std::error_code const & ec ) noexcept(!BOOST_LEAF_CFG_CAPTURE):
-        what_(error_id(ec))
+        storage(error_id(ec))
     {
     }
 
     template <class Enum, class = typename std::enable_if<std::is_error_code_enum<Enum>::value, int>::type>
     result( Enum e ) noexcept(!BOOST_LEAF_CFG_CAPTURE):
-        what_(error_id(e))
+        storage(error_id(e))
     {
     }
 #endif // #if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
 
-    ~result() noexcept
-    {
-        destroy();
-    }
-
-    // NOTE: Assignment operator implicitly deleted.
-
-    result & operator=( result && x ) noexcept
-    {
-        move_assign(std::move(x));
-        return *this;
-    }
+    // NOTE: Copy assignment implicitly deleted, move assignment implicitly
+    // defined.
 
     template <class U, class = typename std::enable_if<std::is_convertible<U, T>::value>::type>
     result & operator=( result<U> && x ) noexcept
     {
-        move_assign(std::move(x));
+        move_assign(static_cast<typename result<U>::storage &&>(x));
         return *this;
     }
 
     bool has_value() const noexcept
     {
-        return what_.kind() == result_discriminant::val;
+        return what().kind() == result_discriminant::val;
     }
 
     bool has_error() const noexcept
@@ -571,8 +833,8 @@ public:
     void unload()
     {
 #if BOOST_LEAF_CFG_CAPTURE
-        if( what_.kind() == result_discriminant::err_id_capture_list )
-            cap_.unload(what_.get_error_id().value());
+        if( what().kind() == result_discriminant::err_id_capture_list )
+            cap_.unload(what().get_error_id().value());
 #endif
     }
 
@@ -580,7 +842,7 @@ public:
     void serialize_to(Encoder & e) const
     {
         detail::encoder_adaptor<Encoder> ea(e);
-        if( what_.kind() == result_discriminant::val )
+        if( what().kind() == result_discriminant::val )
             detail::serialize_(ea, value());
         else
             output_capture_to(ea, output_error_to(ea));
@@ -626,7 +888,7 @@ class BOOST_LEAF_ATTRIBUTE_NODISCARD result<void>:
 #if BOOST_LEAF_CFG_CAPTURE
     friend class detail::dynamic_allocator;
 
-    result( int err_id, detail::capture_list && cap ) noexcept:
+    result( detail::error_id_int err_id, detail::capture_list && cap ) noexcept:
         base(err_id, std::move(cap))
     {
     }
@@ -636,11 +898,8 @@ public:
 
     using value_type = void;
 
-    // NOTE: Copy constructor implicitly deleted.
-    result( result && x ) noexcept:
-        base(std::move(x))
-    {
-    }
+    // NOTE: Copy constructor implicitly deleted, move constructor and
+    // destructor implicitly defined.
 
     result() noexcept
     {
@@ -664,16 +923,8 @@ public:
     }
 #endif // #if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
 
-    ~result() noexcept
-    {
-    }
-
-    // NOTE: Assignment operator implicitly deleted.
-    result & operator=( result && x ) noexcept
-    {
-        base::move_assign(std::move(x));
-        return *this;
-    }
+    // NOTE: Copy assignment implicitly deleted, move assignment implicitly
+    // defined.
 
     void value() const
     {
@@ -0,0 +1,326 @@
+#ifndef BOOST_LEAF_SERIALIZATION_CBOR_DECODER_HPP_INCLUDED
+#define BOOST_LEAF_SERIALIZATION_CBOR_DECODER_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/common.hpp>
+#include <boost/leaf/error.hpp>
+#include <boost/leaf/serialization/cbor_encoder.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#if (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)) && defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+namespace boost { namespace leaf {
+
+namespace serialization
+{
+    // Maps the numeric ids written by cbor_encoder back to names. The
+    // default constructor registers the names of the error types and members
+    // LEAF itself serializes; use add to register the names of user-defined
+    // error types and their members.
+    class cbor_names
+    {
+        std::unordered_map<std::uint32_t, std::string> names_;
+
+    public:
+
+        cbor_names()
+        {
+            add<error_id>();
+            add<e_source_location>();
+            add<std::exception>();
+            add<e_api_function>();
+            add<e_file_name>();
+            add<e_errno>();
+            add<e_type_info_name>();
+            add<e_at_line>();
+            add<windows::e_LastError>();
+#if BOOST_LEAF_CFG_CAPTURE
+            add<e_capture_overflow>();
+#endif
+#if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
+            add<std::error_code>();
+            add<std::error_condition>();
+#endif
+            for( name_id const * n: detail::member_names::all )
+                add(n->name);
+        }
+
+        void add( char const * name, std::size_t length )
+        {
+            names_[cbor_id(name, length)].assign(name, length);
+        }
+
+        void add( char const * name )
+        {
+            add(name, std::strlen(name));
+        }
+
+        template <class T>
+        void add()
+        {
+            detail::type_name tn = detail::get_type_name<T>();
+            add(tn.name_not_zero_terminated_at_length, tn.length);
+        }
+
+        std::string const * find( std::uint32_t id ) const
+        {
+            auto it = names_.find(id);
+            return it == names_.end() ? nullptr : &it->second;
+        }
+    };
+
+} // namespace serialization
+
+namespace detail
+{
+    class cbor_to_json_
+    {
+        cbor_to_json_( cbor_to_json_ const & ) = delete;
+        cbor_to_json_ & operator=( cbor_to_json_ const & ) = delete;
+
+        unsigned char const * p_;
+        unsigned char const * const end_;
+        std::ostream & os_;
+        serialization::cbor_names const & names_;
+
+        static constexpr int max_depth = 64;
+
+        bool read_head( unsigned & major, unsigned & info, std::uint64_t & x )
+        {
+            if( p_ == end_ )
+                return false;
+            major = *p_ >> 5;
+            info = *p_ & 31;
+            ++p_;
+            x = info;
+            if( info < 24 || info == 31 )
+                return true;
+            if( info > 27 )
+                return false;
+            std::size_t n = std::size_t(1) << (info - 24);
+            if( static_cast<std::size_t>(end_ - p_) < n )
+                return false;
+            x = 0;
+            for( ; n; --n )
+                x = (x << 8) | *p_++;
+            return true;
+        }
+
+        bool at_break()
+        {
+            if( p_ != end_ && *p_ == 0xFF )
+            {
+                ++p_;
+                return true;
+            }
+            return false;
+        }
+
+        void write_string( char const * s, std::size_t n )
+        {
+            os_ << '"';
+            for( char const * end = s + n; s != end; ++s )
+                switch( unsigned char c = static_cast<unsigned char>(*s) )
+                {
+                    case '"': os_ << "\\\""; break;
+                    case '\\': os_ << "\\\\"; break;
+                    case '\b': os_ << "\\b"; break;
+                    case '\f': os_ << "\\f"; break;
+                    case '\n': os_ << "\\n"; break;
+                    case '\r': os_ << "\\r"; break;
+                    case '\t': os_ << "\\t"; break;
+                    default:
+                        if( c >= 0x20 )
+                            os_ << *s;
+                        else
+                            os_ << "\\u00" << "0123456789abcdef"[c >> 4] << "0123456789abcdef"[c & 15];
+                }
+            os_ << '"';
+        }
+
+        template <class T>
+        void write_number( T x )
+        {
+            if( !std::isfinite(x) )
+            {
+                os_ << "null";
+                return;
+            }
+            char buf[64];
+#ifdef __cpp_lib_to_chars
+            std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), x);
+            os_.write(buf, r.ptr - buf);
+#else
+            int n = std::snprintf(buf, sizeof(buf), sizeof(T) == 4 ? "%.9g" : "%.17g", static_cast<double>(x));
+            if( n > 0 )
+                os_.write(buf, n < int(sizeof(buf)) ? n : int(sizeof(buf)) - 1);
+#endif
+        }
+
+        bool text( std::uint64_t n )
+        {
+            if( static_cast<std::uint64_t>(end_ - p_) < n )
+                return false;
+            write_string(reinterpret_cast<char const *>(p_), static_cast<std::size_t>(n));
+            p_ += n;
+            return true;
+        }
+
+        bool key()
+        {
+            unsigned major, info;
+            std::uint64_t x;
+            if( !read_head(major, info, x) || info == 31 )
+                return false;
+            switch( major )
+            {
+                case 0:
+                    if( std::string const * name = x > 0xFFFFFFFF ? nullptr : names_.find(static_cast<std::uint32_t>(x)) )
+                        write_string(name->data(), name->size());
+                    else
+                    {
+                        char buf[24];
+                        (void) std::snprintf(buf, sizeof(buf), "#%08llx", static_cast<unsigned long long>(x));
+                        os_ << '"' << buf << '"';
+                    }
+                    break;
+                case 1:
+                    os_ << '"' << x << '"';
+                    break;
+                case 3:
+                    if( !text(x) )
+                        return false;
+                    break;
+                default:
+                    return false;
+            }
+            os_ << ':';
+            return true;
+        }
+
+        bool item( int depth )
+        {
+            if( depth == max_depth )
+                return false;
+            unsigned major, info;
+            std::uint64_t x;
+            if( !read_head(major, info, x) )
+                return false;
+            switch( major )
+            {
+                case 0:
+                    os_ << x;
+                    return info != 31;
+                case 1:
+                    if( info == 31 )
+                        return false;
+                    if( x == std::uint64_t(-1) )
+                        os_ << "-18446744073709551616";
+                    else
+                        os_ << '-' << (x + 1);
+                    return true;
+                case 3:
+                    return info != 31 && text(x);
+                case 4:
+                    os_ << '[';
+                    for( std::uint64_t i = 0; info == 31 ? !at_break() : i != x; ++i )
+                    {
+                        if( i )
+                            os_ << ',';
+                        if( !item(depth + 1) )
+                            return false;
+                    }
+                    os_ << ']';
+                    return true;
+                case 5:
+                    os_ << '{';
+                    for( std::uint64_t i = 0; info == 31 ? !at_break() : i != x; ++i )
+                    {
+                        if( i )
+                            os_ << ',';
+                        if( !key() || !item(depth + 1) )
+                            return false;
+                    }
+                    os_ << '}';
+                    return true;
+                case 6:
+                    return info != 31 && item(depth + 1);
+                case 7:
+                    switch( info )
+                    {
+                        case 20: os_ << "false"; return true;
+                        case 21: os_ << "true"; return true;
+                        case 22: case 23: os_ << "null"; return true;
+                        case 26:
+                        {
+                            std::uint32_t bits = static_cast<std::uint32_t>(x);
+                            float f;
+                            std::memcpy(&f, &bits, sizeof(f));
+                            write_number(f);
+                            return true;
+                        }
+                        case 27:
+                        {
+                            double d;
+                            std::memcpy(&d, &x, sizeof(d));
+                            write_number(d);
+                            return true;
+                        }
+                        default:
+                            return false;
+                    }
+                default:
+                    return false;
+            }
+        }
+
+    public:
+
+        cbor_to_json_( unsigned char const * data, std::size_t size, std::ostream & os, serialization::cbor_names const & names ) noexcept:
+            p_(data),
+            end_(data + size),
+            os_(os),
+            names_(names)
+        {
+        }
+
+        bool operator()()
+        {
+            return item(0) && p_ == end_;
+        }
+    };
+} // namespace detail
+
+namespace serialization
+{
+    // Writes CBOR produced by cbor_encoder to os as JSON text, replacing
+    // numeric member ids with the names registered in names. Ids which are
+    // not registered are written as "#" followed by the id in hex. Returns
+    // false if the input is malformed or truncated, in which case the output
+    // is incomplete.
+    inline bool cbor_to_json( unsigned char const * data, std::size_t size, std::ostream & os, cbor_names const & names = cbor_names() )
+    {
+        return detail::cbor_to_json_(data, size, os, names)();
+    }
+}
+
+} }
+
+#endif // #ifndef BOOST_LEAF_SERIALIZATION_CBOR_DECODER_HPP_INCLUDED
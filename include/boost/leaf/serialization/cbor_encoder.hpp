@@ -0,0 +1,306 @@
+#ifndef BOOST_LEAF_SERIALIZATION_CBOR_ENCODER_HPP_INCLUDED
+#define BOOST_LEAF_SERIALIZATION_CBOR_ENCODER_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/detail/member_names.hpp>
+#include <boost/leaf/detail/output_sink.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace boost { namespace leaf {
+
+namespace serialization
+{
+    // Writes CBOR (RFC 8949) directly to an output_sink. Each output_at call
+    // emits a member of the enclosing map, which is opened on the first call
+    // and closed when the encoder is destroyed (or, for the top-level
+    // encoder, by finish()). Member names are replaced by their cbor_id,
+    // which is taken from name_id arguments as is, and only computed at run
+    // time for char const * names. Names which are decimal numbers
+    // (array-like members, e.g. e_trace frames) are written as negative
+    // integers: name n is encoded as the CBOR negative integer -1-n.
+    class cbor_encoder
+    {
+        cbor_encoder( cbor_encoder const & ) = delete;
+        cbor_encoder & operator=( cbor_encoder const & ) = delete;
+
+        enum class state: char { empty, object, value, closed };
+
+        enum: unsigned char
+        {
+            major_unsigned = 0 << 5,
+            major_negative = 1 << 5,
+            major_text = 3 << 5,
+            major_array = 4 << 5,
+            major_map = 5 << 5,
+            indefinite = 31,
+            cbor_false = 0xF4,
+            cbor_true = 0xF5,
+            cbor_null = 0xF6,
+            cbor_float32 = 0xFA,
+            cbor_float64 = 0xFB,
+            cbor_break = 0xFF
+        };
+
+        detail::output_sink sink_;
+        detail::output_sink & out_;
+        state state_;
+        bool const nested_;
+
+        struct nested_tag { };
+
+        cbor_encoder( cbor_encoder & parent, nested_tag ) noexcept:
+            out_(parent.out_),
+            state_(state::empty),
+            nested_(true)
+        {
+        }
+
+        void put( unsigned char c )
+        {
+            out_.put(static_cast<char>(c));
+        }
+
+        template <class U>
+        void write_big_endian( U x, int bytes )
+        {
+            char buf[8];
+            for( int i = bytes; i--; x >>= 8 )
+                buf[i] = static_cast<char>(x & 0xFF);
+            out_.write(buf, static_cast<std::size_t>(bytes));
+        }
+
+        void write_head( unsigned char major, std::uint64_t x )
+        {
+            if( x < 24 )
+                put(static_cast<unsigned char>(major | x));
+            else if( x <= 0xFF )
+            {
+                put(major | 24);
+                write_big_endian(x, 1);
+            }
+            else if( x <= 0xFFFF )
+            {
+                put(major | 25);
+                write_big_endian(x, 2);
+            }
+            else if( x <= 0xFFFFFFFF )
+            {
+                put(major | 26);
+                write_big_endian(x, 4);
+            }
+            else
+            {
+                put(major | 27);
+                write_big_endian(x, 8);
+            }
+        }
+
+        void begin_value() noexcept
+        {
+            BOOST_LEAF_ASSERT(state_ == state::empty);
+            state_ = state::value;
+        }
+
+        void begin_member( unsigned char major, std::uint32_t key )
+        {
+            BOOST_LEAF_ASSERT(state_ == state::empty || state_ == state::object);
+            if( state_ == state::empty )
+                put(major_map | indefinite);
+            state_ = state::object;
+            write_head(major, key);
+        }
+
+        void begin_member( char const * name )
+        {
+            std::uint32_t index = 0;
+            char const * p = name;
+            for( ; *p >= '0' && *p <= '9' && p - name < 9; ++p )
+                index = index * 10 + static_cast<std::uint32_t>(*p - '0');
+            if( p != name && !*p )
+                begin_member(major_negative, index);
+            else
+                begin_member(major_unsigned, cbor_id(name));
+        }
+
+        void close()
+        {
+            switch( state_ )
+            {
+                case state::empty:
+                    put(nested_ ? cbor_null : major_map);
+                    break;
+                case state::object:
+                    put(cbor_break);
+                    break;
+                default:
+                    break;
+            }
+            state_ = state::closed;
+        }
+
+        void value( bool x )
+        {
+            begin_value();
+            put(x ? cbor_true : cbor_false);
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value>::type
+        value( T x )
+        {
+            begin_value();
+            std::uint64_t const m = detail::magnitude(x);
+            if( detail::is_negative(x) )
+                write_head(major_negative, m - 1);
+            else
+                write_head(major_unsigned, m);
+        }
+
+        void value( float x )
+        {
+            begin_value();
+            static_assert(sizeof(float) == 4, "cbor_encoder requires 32-bit float");
+            std::uint32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            put(cbor_float32);
+            write_big_endian(bits, 4);
+        }
+
+        void value( double x )
+        {
+            begin_value();
+            static_assert(sizeof(double) == 8, "cbor_encoder requires 64-bit double");
+            std::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            put(cbor_float64);
+            write_big_endian(bits, 8);
+        }
+
+        void value( long double x )
+        {
+            value(static_cast<double>(x));
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_enum<T>::value>::type
+        value( T x )
+        {
+            value(static_cast<typename std::underlying_type<T>::type>(x));
+        }
+
+        void write_text( char const * s, std::size_t n )
+        {
+            write_head(major_text, n);
+            out_.write(s, n);
+        }
+
+        void value( char const * s )
+        {
+            begin_value();
+            if( s )
+                write_text(s, std::strlen(s));
+            else
+                put(cbor_null);
+        }
+
+        template <class T>
+        typename std::enable_if<detail::is_char_string<T>::value>::type
+        value( T const & s )
+        {
+            begin_value();
+            write_text(s.c_str(), s.size());
+        }
+
+        template <class T>
+        auto value( T const & x ) -> decltype(std::begin(x), std::end(x), typename std::enable_if<!detail::is_char_string<T>::value>::type())
+        {
+            begin_value();
+            put(major_array | indefinite);
+            for( auto const & v : x )
+            {
+                cbor_encoder nested(*this, nested_tag{});
+                output(nested, v);
+            }
+            put(cbor_break);
+        }
+
+    public:
+
+        cbor_encoder( unsigned char * buf, std::size_t size ) noexcept:
+            sink_(reinterpret_cast<char *>(buf), size, false),
+            out_(sink_),
+            state_(state::empty),
+            nested_(false)
+        {
+        }
+
+        explicit cbor_encoder( std::FILE * f ) noexcept:
+            sink_(&detail::output_sink::write_file, f),
+            out_(sink_),
+            state_(state::empty),
+            nested_(false)
+        {
+            BOOST_LEAF_ASSERT(f != nullptr);
+        }
+
+        cbor_encoder( void (*write)( void * state, char const * s, std::size_t n ), void * state ) noexcept:
+            sink_(write, state),
+            out_(sink_),
+            state_(state::empty),
+            nested_(false)
+        {
+        }
+
+        ~cbor_encoder()
+        {
+            close();
+        }
+
+        // Closes the top-level map, and returns the total number of bytes
+        // written. When writing to a buffer, this may be greater than its
+        // size, in which case the output was truncated.
+        std::size_t finish()
+        {
+            close();
+            return out_.size();
+        }
+
+        template <class Encoder, class T, class... Deprioritize>
+        friend typename std::enable_if<std::is_same<Encoder, cbor_encoder>::value>::type
+        output( Encoder & e, T const & x, Deprioritize... )
+        {
+            e.value(x);
+        }
+
+        template <class T>
+        friend void output_at( cbor_encoder & e, T const & x, char const * name )
+        {
+            e.begin_member(name);
+            cbor_encoder nested(e, nested_tag{});
+            output(nested, x);
+        }
+
+        template <class T>
+        friend void output_at( cbor_encoder & e, T const & x, name_id const & name )
+        {
+            e.begin_member(major_unsigned, name.id);
+            cbor_encoder nested(e, nested_tag{});
+            output(nested, x);
+        }
+    }; // class cbor_encoder
+}
+
+} }
+
+#endif // #ifndef BOOST_LEAF_SERIALIZATION_CBOR_ENCODER_HPP_INCLUDED
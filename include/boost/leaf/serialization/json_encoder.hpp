@@ -0,0 +1,254 @@
+#ifndef BOOST_LEAF_SERIALIZATION_JSON_ENCODER_HPP_INCLUDED
+#define BOOST_LEAF_SERIALIZATION_JSON_ENCODER_HPP_INCLUDED
+
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+#include <boost/leaf/detail/output_sink.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)) && defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+namespace boost { namespace leaf {
+
+namespace serialization
+{
+    // Writes JSON text directly to an output_sink, without building a DOM.
+    // Each output_at call emits a member of the enclosing object, which is
+    // opened on the first call and closed when the encoder is destroyed (or,
+    // for the top-level encoder, by finish()).
+    class json_encoder
+    {
+        json_encoder( json_encoder const & ) = delete;
+        json_encoder & operator=( json_encoder const & ) = delete;
+
+        enum class state: char { empty, object, value, closed };
+
+        detail::output_sink sink_;
+        detail::output_sink & out_;
+        state state_;
+        bool const nested_;
+
+        struct nested_tag { };
+
+        json_encoder( json_encoder & parent, nested_tag ) noexcept:
+            out_(parent.out_),
+            state_(state::empty),
+            nested_(true)
+        {
+        }
+
+        void begin_value() noexcept
+        {
+            BOOST_LEAF_ASSERT(state_ == state::empty);
+            state_ = state::value;
+        }
+
+        void begin_member( char const * name )
+        {
+            BOOST_LEAF_ASSERT(state_ == state::empty || state_ == state::object);
+            out_.put(state_ == state::object ? ',' : '{');
+            state_ = state::object;
+            write_string(name, std::strlen(name));
+            out_.put(':');
+        }
+
+        void close()
+        {
+            switch( state_ )
+            {
+                case state::empty:
+                    out_.write(nested_ ? "null" : "{}");
+                    break;
+                case state::object:
+                    out_.put('}');
+                    break;
+                default:
+                    break;
+            }
+            state_ = state::closed;
+        }
+
+        void write_string( char const * s, std::size_t n )
+        {
+            out_.put('"');
+            char const * run = s;
+            for( char const * end = s + n; s != end; ++s )
+            {
+                char esc[7] = { '\\', 0, 0, 0, 0, 0, 0 };
+                switch( unsigned char c = static_cast<unsigned char>(*s) )
+                {
+                    case '"': esc[1] = '"'; break;
+                    case '\\': esc[1] = '\\'; break;
+                    case '\b': esc[1] = 'b'; break;
+                    case '\f': esc[1] = 'f'; break;
+                    case '\n': esc[1] = 'n'; break;
+                    case '\r': esc[1] = 'r'; break;
+                    case '\t': esc[1] = 't'; break;
+                    default:
+                        if( c >= 0x20 )
+                            continue;
+                        esc[1] = 'u';
+                        esc[2] = '0';
+                        esc[3] = '0';
+                        esc[4] = "0123456789abcdef"[c >> 4];
+                        esc[5] = "0123456789abcdef"[c & 15];
+                }
+                out_.write(run, static_cast<std::size_t>(s - run));
+                out_.write(esc);
+                run = s + 1;
+            }
+            out_.write(run, static_cast<std::size_t>(s - run));
+            out_.put('"');
+        }
+
+        void value( bool x )
+        {
+            begin_value();
+            out_.write(x ? "true" : "false");
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value>::type
+        value( T x )
+        {
+            begin_value();
+            out_.write_decimal(x);
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type
+        value( T x )
+        {
+            begin_value();
+            if( !std::isfinite(x) )
+            {
+                out_.write("null");
+                return;
+            }
+            char buf[64];
+#ifdef __cpp_lib_to_chars
+            std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), x);
+            out_.write(buf, static_cast<std::size_t>(r.ptr - buf));
+#else
+            int n = std::snprintf(buf, sizeof(buf), "%.17g", static_cast<double>(x));
+            if( n > 0 )
+                out_.write(buf, static_cast<std::size_t>(n) < sizeof(buf) ? static_cast<std::size_t>(n) : sizeof(buf) - 1);
+#endif
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_enum<T>::value>::type
+        value( T x )
+        {
+            value(static_cast<typename std::underlying_type<T>::type>(x));
+        }
+
+        void value( char const * s )
+        {
+            begin_value();
+            if( s )
+                write_string(s, std::strlen(s));
+            else
+                out_.write("null");
+        }
+
+        template <class T>
+        typename std::enable_if<detail::is_char_string<T>::value>::type
+        value( T const & s )
+        {
+            begin_value();
+            write_string(s.c_str(), s.size());
+        }
+
+        template <class T>
+        auto value( T const & x ) -> decltype(std::begin(x), std::end(x), typename std::enable_if<!detail::is_char_string<T>::value>::type())
+        {
+            begin_value();
+            out_.put('[');
+            bool first = true;
+            for( auto const & v : x )
+            {
+                if( !first )
+                    out_.put(',');
+                first = false;
+                json_encoder nested(*this, nested_tag{});
+                output(nested, v);
+            }
+            out_.put(']');
+        }
+
+    public:
+
+        json_encoder( char * buf, std::size_t size ) noexcept:
+            sink_(buf, size, true),
+            out_(sink_),
+            state_(state::empty),
+            nested_(false)
+        {
+        }
+
+        explicit json_encoder( std::FILE * f ) noexcept:
+            sink_(&detail::output_sink::write_file, f),
+            out_(sink_),
+            state_(state::empty),
+            nested_(false)
+        {
+            BOOST_LEAF_ASSERT(f != nullptr);
+        }
+
+        json_encoder( void (*write)( void * state, char const * s, std::size_t n ), void * state ) noexcept:
+            sink_(write, state),
+            out_(sink_),
+            state_(state::empty),
+            nested_(false)
+        {
+        }
+
+        ~json_encoder()
+        {
+            close();
+        }
+
+        // Closes the top-level object, and returns the total number of
+        // characters written. When writing to a buffer, this may be greater
+        // than its size, in which case the output was truncated.
+        std::size_t finish()
+        {
+            close();
+            return out_.size();
+        }
+
+        template <class Encoder, class T, class... Deprioritize>
+        friend typename std::enable_if<std::is_same<Encoder, json_encoder>::value>::type
+        output( Encoder & e, T const & x, Deprioritize... )
+        {
+            e.value(x);
+        }
+
+        template <class T>
+        friend void output_at( json_encoder & e, T const & x, char const * name )
+        {
+            e.begin_member(name);
+            json_encoder nested(e, nested_tag{});
+            output(nested, x);
+        }
+    }; // class json_encoder
+}
+
+} }
+
+#endif // #ifndef BOOST_LEAF_SERIALIZATION_JSON_ENCODER_HPP_INCLUDED
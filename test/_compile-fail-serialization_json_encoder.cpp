@@ -0,0 +1,17 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/serialization/json_encoder.hpp>
+
+struct no_output {};
+
+struct e_no_output
+{
+    no_output value;
+};
+
+char buf[64];
+boost::leaf::serialization::json_encoder w(buf, sizeof(buf));
+e_no_output e;
+auto x = (output(w, e), 0);
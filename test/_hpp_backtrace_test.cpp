@@ -0,0 +1,7 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/backtrace.hpp>
+#include <boost/leaf/backtrace.hpp>
+int main() { return 0; }
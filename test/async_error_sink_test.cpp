@@ -0,0 +1,200 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#ifdef BOOST_LEAF_NO_THREADS
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include <boost/leaf/async_error_sink.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lightweight_test.hpp"
+
+namespace leaf = boost::leaf;
+
+struct info { int value; };
+
+leaf::result<void> fail( int thread, int i )
+{
+    return BOOST_LEAF_NEW_ERROR(info{thread * 1000 + i});
+}
+
+struct output
+{
+    std::string text;
+    int writes = 0;
+    std::atomic<bool> blocked { false };
+};
+
+void write( void * state, char const * s, std::size_t n )
+{
+    output & out = *static_cast<output *>(state);
+    while( out.blocked.load() )
+        std::this_thread::yield();
+    out.text.append(s, n);
+    ++out.writes;
+}
+
+template <class Handler>
+void handle( int thread, int i, Handler && h )
+{
+    leaf::try_handle_all(
+        [&]
+        {
+            return fail(thread, i);
+        },
+        std::forward<Handler>(h) );
+}
+
+int count( std::string const & s, char const * what )
+{
+    int n = 0;
+    for( std::size_t p = s.find(what); p != s.npos; p = s.find(what, p + 1) )
+        ++n;
+    return n;
+}
+
+int main()
+{
+    {
+        // Messages from concurrent threads, each written in one piece, in
+        // the same format as print_to.
+        output out;
+        std::string expected;
+        {
+            leaf::async_error_sink sink(&write, &out);
+            handle(0, 0,
+                [&]( leaf::diagnostic_details const & dd )
+                {
+                    char buf[1024];
+                    BOOST_TEST_LT(print_to(buf, sizeof(buf), dd), sizeof(buf));
+                    expected = buf;
+                    BOOST_TEST(sink.push(dd));
+                } );
+            sink.flush();
+            BOOST_TEST_EQ(out.text, expected);
+
+            std::vector<std::thread> threads;
+            for( int t = 1; t != 5; ++t )
+                threads.emplace_back(
+                    [&sink, t]
+                    {
+                        for( int i = 0; i != 100; ++i )
+                            handle(t, i,
+                                [&]( leaf::diagnostic_details const & dd )
+                                {
+                                    BOOST_TEST(sink.push(dd));
+                                } );
+                    } );
+            for( auto & t : threads )
+                t.join();
+            BOOST_TEST_EQ(sink.dropped(), 0u);
+            BOOST_TEST_EQ(sink.truncated(), 0u);
+        }
+        BOOST_TEST_EQ(count(out.text, "Error with serial #"), 401);
+        BOOST_TEST_EQ(count(out.text, "\n"), 401 * count(expected, "\n"));
+#if BOOST_LEAF_CFG_DIAGNOSTICS && BOOST_LEAF_CFG_CAPTURE
+        for( int t = 1; t != 5; ++t )
+            for( int i = 0; i != 100; ++i )
+            {
+                char s[32];
+                (void) std::snprintf(s, sizeof(s), "info: %d\n", t * 1000 + i);
+                BOOST_TEST_EQ(count(out.text, s), 1);
+            }
+#endif
+        BOOST_TEST_LT(out.writes, 401);
+    }
+
+    {
+        // Overflow is counted rather than blocking.
+        output out;
+        out.blocked = true;
+        int pushed = 0;
+        {
+            leaf::async_error_sink sink(&write, &out, 4);
+            for( int i = 0; i != 20; ++i )
+                handle(0, i,
+                    [&]( leaf::error_info const & ei )
+                    {
+                        pushed += sink.push(ei);
+                    } );
+            BOOST_TEST_LE(pushed, 8);
+            BOOST_TEST_EQ(sink.dropped(), 20u - unsigned(pushed));
+            out.blocked = false;
+            sink.flush();
+            BOOST_TEST_EQ(count(out.text, "Error with serial #"), pushed);
+            handle(0, 0,
+                [&]( leaf::error_info const & ei )
+                {
+                    BOOST_TEST(sink.push(ei));
+                } );
+            BOOST_TEST_EQ(sink.dropped(), 20u - unsigned(pushed));
+        }
+        BOOST_TEST_EQ(count(out.text, "Error with serial #"), pushed + 1);
+    }
+
+    {
+        // Truncated messages are counted, and still end with a new line.
+        output out;
+        {
+            leaf::async_error_sink sink(&write, &out, 16, 16);
+            handle(0, 0,
+                [&]( leaf::diagnostic_details const & dd )
+                {
+                    BOOST_TEST(sink.push(dd));
+                } );
+            BOOST_TEST_EQ(sink.truncated(), 1u);
+        }
+        BOOST_TEST_EQ(out.text.size(), 16u);
+        BOOST_TEST_EQ(out.text.back(), '\n');
+    }
+
+    if( std::FILE * f = std::tmpfile() )
+    {
+        {
+            leaf::async_error_sink sink(f);
+            handle(0, 42,
+                [&]( leaf::diagnostic_info const & di )
+                {
+                    BOOST_TEST(sink.push(di));
+                } );
+        }
+        std::rewind(f);
+        char buf[1024] = { };
+        std::size_t n = std::fread(buf, 1, sizeof(buf) - 1, f);
+        std::fclose(f);
+        std::cout << buf;
+        BOOST_TEST_GT(n, 0u);
+        BOOST_TEST_EQ(count(buf, "Error with serial #"), 1);
+    }
+
+    return boost::report_errors();
+}
+
+#endif // #ifdef BOOST_LEAF_NO_THREADS
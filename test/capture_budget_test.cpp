@@ -0,0 +1,291 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_LEAF_CFG_CAPTURE_BUDGET 256
+#define BOOST_LEAF_CFG_STD_PMR 0
+
+#include <boost/leaf/config.hpp>
+
+#if !BOOST_LEAF_CFG_CAPTURE
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/exception.hpp>
+#   include <boost/leaf/diagnostics.hpp>
+#endif
+
+#if BOOST_LEAF_CFG_STD_STRING
+#   include <sstream>
+#   include <iostream>
+#endif
+
+#include "lightweight_test.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int allocations = 0;
+}
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+    void * p = std::malloc(size ? size : 1);
+    if( !p )
+        std::abort();
+    return p;
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free(p);
+}
+
+void operator delete( void * p, std::size_t ) noexcept
+{
+    std::free(p);
+}
+
+template <int>
+struct info
+{
+    int value;
+};
+
+// Never fits in the budget.
+template <int>
+struct big_info
+{
+    int value;
+    char buf[BOOST_LEAF_CFG_CAPTURE_BUDGET];
+};
+
+struct alignas(64) over_aligned_info
+{
+    int value;
+};
+
+struct counted_info
+{
+    static int count;
+    int value;
+    explicit counted_info( int v ) noexcept: value(v) { ++count; }
+    counted_info( counted_info const & x ) noexcept: value(x.value) { ++count; }
+    ~counted_info() noexcept { --count; }
+};
+
+int counted_info::count = 0;
+
+struct my_exception: std::exception
+{
+};
+
+// info<1..3> and counted_info fit in the budget; everything after them is
+// dropped.
+leaf::result<int> fail( int x )
+{
+    if( x )
+        return leaf::new_error(
+            info<1>{x}, info<2>{x + 1}, info<3>{x + 2}, counted_info{x + 3},
+            big_info<1>{1, {}}, big_info<2>{2, {}}, over_aligned_info{3});
+    return x;
+}
+
+int main()
+{
+    int const a = allocations;
+
+    {
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return fail(0);
+            } );
+        BOOST_TEST(r);
+    }
+
+    {
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return fail(1);
+            } );
+        BOOST_TEST(!r);
+        BOOST_TEST_EQ(counted_info::count, 1);
+        leaf::result<int> moved = std::move(r);
+        BOOST_TEST_EQ(counted_info::count, 1);
+        int v = leaf::try_handle_all(
+            [&]
+            {
+                return std::move(moved);
+            },
+            []( big_info<1> const & )
+            {
+                return -2;
+            },
+            []( info<1> const & i1, info<2> const & i2, info<3> const & i3, counted_info const & c, leaf::e_capture_overflow const & ov )
+            {
+                BOOST_TEST_EQ(ov.value, 3);
+                return i1.value * 1000 + i2.value * 100 + i3.value * 10 + c.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 1234);
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+
+    {
+        // Captured but not handled.
+        {
+            leaf::result<int> r = leaf::try_capture_all(
+                []
+                {
+                    return fail(1);
+                } );
+            BOOST_TEST(!r);
+            BOOST_TEST_EQ(counted_info::count, 1);
+        }
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+
+    {
+        // Recaptured by an outer try_capture_all, along with the drop count.
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return leaf::try_handle_some(
+                    []
+                    {
+                        return leaf::try_capture_all(
+                            []
+                            {
+                                return fail(1);
+                            } );
+                    },
+                    []( info<9> const & ) -> leaf::result<int>
+                    {
+                        return 0;
+                    } );
+            } );
+        BOOST_TEST(!r);
+        int v = leaf::try_handle_all(
+            [&]
+            {
+                return std::move(r);
+            },
+            []( info<1> const &, leaf::e_capture_overflow const & ov )
+            {
+                return int(ov.value);
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 3);
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+
+    {
+        // on_error reserves its objects in the budget as well.
+        leaf::result<int> r = leaf::try_capture_all(
+            []() -> leaf::result<int>
+            {
+                auto load = leaf::on_error(info<4>{42}, big_info<1>{1, {}});
+                return leaf::new_error(info<1>{1});
+            } );
+        BOOST_TEST(!r);
+        int v = leaf::try_handle_all(
+            [&]
+            {
+                return std::move(r);
+            },
+            []( big_info<1> const & )
+            {
+                return -2;
+            },
+            []( info<4> const & i4, info<1> const &, leaf::e_capture_overflow const & ov )
+            {
+                BOOST_TEST_EQ(ov.value, 1);
+                return i4.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 42);
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+
+    BOOST_TEST_EQ(allocations, a);
+
+#if BOOST_LEAF_CFG_DIAGNOSTICS && BOOST_LEAF_CFG_STD_STRING
+    {
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return fail(1);
+            } );
+        BOOST_TEST(!r);
+        std::ostringstream st;
+        st << r;
+        std::string s = st.str();
+        std::cout << s << std::endl;
+        BOOST_TEST_NE(s.find("e_capture_overflow"), s.npos);
+    }
+#endif
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        // The exception is never dropped.
+        leaf::result<int> r = leaf::try_capture_all(
+            []() -> int
+            {
+                leaf::throw_exception(my_exception{},
+                    info<1>{1}, info<2>{2}, info<3>{3}, counted_info{4},
+                    big_info<1>{1, {}}, big_info<2>{2, {}}, big_info<3>{3, {}});
+            } );
+        BOOST_TEST(!r);
+        BOOST_TEST_EQ(counted_info::count, 1);
+        int v = leaf::try_catch(
+            [&]
+            {
+                return r.value();
+            },
+            []( my_exception const &, info<1> const & i1, counted_info const & c, leaf::e_capture_overflow const & ov )
+            {
+                BOOST_TEST_EQ(ov.value, 3);
+                return i1.value * 10 + c.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 14);
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+#endif
+
+    return boost::report_errors();
+}
+
+#endif
@@ -0,0 +1,211 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#if !BOOST_LEAF_CFG_CAPTURE || BOOST_LEAF_CFG_CAPTURE_BUDGET
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int allocations = 0;
+}
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+    void * p = std::malloc(size ? size : 1);
+    if( !p )
+        std::abort();
+    return p;
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free(p);
+}
+
+void operator delete( void * p, std::size_t ) noexcept
+{
+    std::free(p);
+}
+
+template <int>
+struct info
+{
+    int value;
+};
+
+template <int>
+struct big_info
+{
+    int value;
+    char buf[100];
+};
+
+struct alignas(64) over_aligned_info
+{
+    int value;
+};
+
+struct counted_info
+{
+    static int count;
+    int value;
+    explicit counted_info( int v ) noexcept: value(v) { ++count; }
+    counted_info( counted_info const & x ) noexcept: value(x.value) { ++count; }
+    ~counted_info() noexcept { --count; }
+};
+
+int counted_info::count = 0;
+
+leaf::result<int> fail_small( int x )
+{
+    if( x )
+        return leaf::new_error(info<1>{x}, info<2>{x + 1}, info<3>{x + 2});
+    return x;
+}
+
+leaf::result<int> fail_big()
+{
+    return leaf::new_error(
+        big_info<1>{1, {}}, big_info<2>{2, {}}, big_info<3>{3, {}}, big_info<4>{4, {}},
+        over_aligned_info{5}, counted_info{6});
+}
+
+int main()
+{
+    {
+        int a = allocations;
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return fail_small(0);
+            } );
+        BOOST_TEST_EQ(allocations, a);
+        BOOST_TEST(r);
+    }
+
+    {
+        int a = allocations;
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return fail_small(1);
+            } );
+#if BOOST_LEAF_CFG_CAPTURE_CHUNK_SIZE >= 256
+        BOOST_TEST_EQ(allocations, a + 1);
+#endif
+        BOOST_TEST(!r);
+        int v = leaf::try_handle_all(
+            [&]
+            {
+                return std::move(r);
+            },
+            []( info<1> const & i1, info<2> const & i2, info<3> const & i3 )
+            {
+                return i1.value * 100 + i2.value * 10 + i3.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 123);
+    }
+
+    {
+        // Requires more than one chunk.
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return fail_big();
+            } );
+        BOOST_TEST(!r);
+        BOOST_TEST_EQ(counted_info::count, 1);
+        int v = leaf::try_handle_all(
+            [&]
+            {
+                return std::move(r);
+            },
+            []( big_info<1> const & b1, big_info<2> const & b2, big_info<3> const & b3, big_info<4> const & b4, over_aligned_info const & oa, counted_info const & c )
+            {
+                BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(&oa) % 64, 0);
+                return b1.value + b2.value + b3.value + b4.value + oa.value + c.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 21);
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+
+    {
+        // Captured but not handled.
+        {
+            leaf::result<int> r = leaf::try_capture_all(
+                []
+                {
+                    return fail_big();
+                } );
+            BOOST_TEST(!r);
+            BOOST_TEST_EQ(counted_info::count, 1);
+        }
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        leaf::result<int> r = leaf::try_capture_all(
+            []() -> int
+            {
+                leaf::throw_exception(info<1>{1}, counted_info{2});
+            } );
+        BOOST_TEST(!r);
+        BOOST_TEST_EQ(counted_info::count, 1);
+        int v = leaf::try_catch(
+            [&]
+            {
+                return r.value();
+            },
+            []( info<1> const & i1, counted_info const & c )
+            {
+                return i1.value * 10 + c.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 12);
+        BOOST_TEST_EQ(counted_info::count, 0);
+    }
+#endif
+
+    return boost::report_errors();
+}
+
+#endif // #if !BOOST_LEAF_CFG_CAPTURE
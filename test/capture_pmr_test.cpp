@@ -0,0 +1,219 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#if !BOOST_LEAF_CFG_CAPTURE || !BOOST_LEAF_CFG_STD_PMR
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int global_allocations = 0;
+}
+
+void * operator new( std::size_t size )
+{
+    ++global_allocations;
+    void * p = std::malloc(size ? size : 1);
+    if( !p )
+        std::abort();
+    return p;
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free(p);
+}
+
+void operator delete( void * p, std::size_t ) noexcept
+{
+    std::free(p);
+}
+
+class counting_resource:
+    public std::pmr::memory_resource
+{
+    std::pmr::memory_resource * upstream_;
+
+    void * do_allocate( std::size_t size, std::size_t align ) override
+    {
+        ++allocations;
+        ++outstanding;
+        return upstream_->allocate(size, align);
+    }
+
+    void do_deallocate( void * p, std::size_t size, std::size_t align ) override
+    {
+        --outstanding;
+        upstream_->deallocate(p, size, align);
+    }
+
+    bool do_is_equal( std::pmr::memory_resource const & other ) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+
+    int allocations = 0;
+    int outstanding = 0;
+
+    explicit counting_resource( std::pmr::memory_resource * upstream = std::pmr::new_delete_resource() ) noexcept:
+        upstream_(upstream)
+    {
+    }
+};
+
+template <int>
+struct info
+{
+    int value;
+};
+
+leaf::result<int> f( int x )
+{
+    if( x )
+        return leaf::new_error(info<1>{x}, info<2>{x + 1});
+    return x;
+}
+
+int handle( leaf::result<int> && r )
+{
+    return leaf::try_handle_all(
+        [&]
+        {
+            return std::move(r);
+        },
+        []( info<1> const & i1, info<2> const & i2 )
+        {
+            return i1.value * 10 + i2.value;
+        },
+        []
+        {
+            return -1;
+        } );
+}
+
+int main()
+{
+    BOOST_TEST_EQ(leaf::get_capture_resource(), nullptr);
+
+    // Explicit memory resource.
+    {
+        counting_resource mr;
+        int g = global_allocations;
+        leaf::result<int> r = leaf::try_capture_all(mr,
+            []
+            {
+                return f(1);
+            } );
+        BOOST_TEST_EQ(global_allocations, g);
+        BOOST_TEST_EQ(mr.allocations, 1);
+        BOOST_TEST_EQ(mr.outstanding, 1);
+        BOOST_TEST_EQ(handle(std::move(r)), 12);
+        BOOST_TEST_EQ(mr.outstanding, 0);
+    }
+
+    // Thread-default memory resource.
+    {
+        counting_resource mr;
+        BOOST_TEST_EQ(leaf::set_capture_resource(&mr), nullptr);
+        BOOST_TEST_EQ(leaf::get_capture_resource(), &mr);
+        int g = global_allocations;
+        leaf::result<int> r = leaf::try_capture_all(
+            []
+            {
+                return f(1);
+            } );
+        BOOST_TEST_EQ(global_allocations, g);
+        BOOST_TEST_EQ(mr.allocations, 1);
+        BOOST_TEST_EQ(handle(std::move(r)), 12);
+        BOOST_TEST_EQ(mr.outstanding, 0);
+
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+        // diagnostic_details captures unhandled error objects using the
+        // thread-default memory resource, too.
+        int a = mr.allocations;
+        int v = leaf::try_handle_all(
+            []() -> leaf::result<int>
+            {
+                return f(1);
+            },
+            []( leaf::diagnostic_details const & )
+            {
+                return 42;
+            } );
+        BOOST_TEST_EQ(v, 42);
+        BOOST_TEST_EQ(global_allocations, g);
+        BOOST_TEST_GT(mr.allocations, a);
+        BOOST_TEST_EQ(mr.outstanding, 0);
+#endif
+
+        BOOST_TEST_EQ(leaf::set_capture_resource(nullptr), &mr);
+    }
+
+    // Per-request arena, released in bulk.
+    {
+        counting_resource upstream;
+        {
+            std::pmr::monotonic_buffer_resource arena(&upstream);
+            std::pmr::vector<leaf::result<int>> results(&arena);
+            for( int i = 0; i != 100; ++i )
+                results.push_back(leaf::try_capture_all(arena,
+                    [i]
+                    {
+                        return f(i & 1);
+                    } ));
+            int sum = 0;
+            for( auto & r : results )
+                sum += handle(std::move(r));
+            BOOST_TEST_EQ(sum, 50 * 12);
+        }
+        BOOST_TEST_EQ(upstream.outstanding, 0);
+    }
+
+    // Steady state with a recycling resource: no allocations.
+    {
+        counting_resource upstream;
+        std::pmr::unsynchronized_pool_resource pool(&upstream);
+        leaf::set_capture_resource(&pool);
+        BOOST_TEST_EQ(handle(leaf::try_capture_all([]{ return f(1); })), 12);
+        int g = global_allocations;
+        int u = upstream.allocations;
+        for( int i = 0; i != 1000; ++i )
+            BOOST_TEST_EQ(handle(leaf::try_capture_all([]{ return f(1); })), 12);
+        BOOST_TEST_EQ(global_allocations, g);
+        BOOST_TEST_EQ(upstream.allocations, u);
+        leaf::set_capture_resource(nullptr);
+    }
+
+    return boost::report_errors();
+}
+
+#endif // #if !BOOST_LEAF_CFG_CAPTURE || !BOOST_LEAF_CFG_STD_PMR
@@ -0,0 +1,220 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#if !BOOST_LEAF_CFG_CAPTURE
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace leaf = boost::leaf;
+
+namespace
+{
+    int global_allocations = 0;
+}
+
+void * operator new( std::size_t size )
+{
+    ++global_allocations;
+    void * p = std::malloc(size ? size : 1);
+    if( !p )
+        std::abort();
+    return p;
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free(p);
+}
+
+void operator delete( void * p, std::size_t ) noexcept
+{
+    std::free(p);
+}
+
+struct e_handled { int value; };
+struct e_unhandled { int value; };
+struct e_preloaded { int value; };
+
+leaf::result<void> f()
+{
+    auto load = leaf::on_error(e_preloaded{4242});
+    return leaf::new_error(e_handled{1}, e_unhandled{1234});
+}
+
+// Returns true if diagnostic_details had the unhandled error objects.
+bool handle( int & allocations )
+{
+    bool details = false;
+    int const a = global_allocations;
+#if !BOOST_LEAF_CFG_DIAGNOSTICS
+    leaf::capture_sampling_policy const * p = leaf::get_capture_sampling_policy();
+    unsigned long long const sampled = p ? p->sampled() : 0;
+#endif
+    leaf::try_handle_all(
+        []
+        {
+            return f();
+        },
+        [&]( e_handled, leaf::diagnostic_details const & dd )
+        {
+            allocations = global_allocations - a;
+            char buf[1024];
+            (void) print_to(buf, sizeof(buf), dd);
+            BOOST_TEST(std::strstr(buf, "Error with serial #") == buf);
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+            details = std::strstr(buf, "1234") != nullptr;
+            BOOST_TEST_EQ(details, std::strstr(buf, "4242") != nullptr);
+#else
+            // Without diagnostics, only the policy tells.
+            details = !p || p->sampled() != sampled;
+#endif
+        },
+        []
+        {
+            BOOST_TEST(false);
+        } );
+    return details;
+}
+
+bool handle()
+{
+    int allocations;
+    return handle(allocations);
+}
+
+int main()
+{
+    BOOST_TEST(leaf::get_capture_sampling_policy() == nullptr);
+    BOOST_TEST(handle());
+
+    {
+        // One in three errors.
+        leaf::capture_sampling_policy p(3);
+        BOOST_TEST(leaf::set_capture_sampling_policy(&p) == nullptr);
+        BOOST_TEST(leaf::get_capture_sampling_policy() == &p);
+        int n = 0;
+        for( int i = 0; i != 9; ++i )
+        {
+            int allocations = 0;
+            if( handle(allocations) )
+                ++n;
+#if !BOOST_LEAF_CFG_CAPTURE_BUDGET
+            else
+                BOOST_TEST_EQ(allocations, 0);
+#endif
+        }
+        BOOST_TEST_EQ(n, 3);
+        BOOST_TEST_EQ(p.sampled(), 3u);
+        BOOST_TEST_EQ(p.declined(), 6u);
+
+        // Errors which have no error objects to capture do not count.
+        leaf::try_handle_all(
+            []() -> leaf::result<void>
+            {
+                return leaf::new_error(e_handled{1});
+            },
+            []( e_handled, leaf::diagnostic_details const & )
+            {
+            },
+            []
+            {
+                BOOST_TEST(false);
+            } );
+        BOOST_TEST_EQ(p.sampled() + p.declined(), 9u);
+
+        BOOST_TEST(leaf::set_capture_sampling_policy(nullptr) == &p);
+    }
+
+    {
+        // At most 2 errors per second (the first error may be counted in a
+        // different second than the last one).
+        leaf::capture_sampling_policy p(1, 2);
+        leaf::set_capture_sampling_policy(&p);
+        int n = 0;
+        for( int i = 0; i != 20; ++i )
+            n += handle();
+        BOOST_TEST_GE(n, 2);
+        BOOST_TEST_LE(n, 4);
+        BOOST_TEST_EQ(p.sampled(), unsigned(n));
+        BOOST_TEST_EQ(p.declined(), 20u - n);
+        leaf::set_capture_sampling_policy(nullptr);
+    }
+
+    {
+        // Nothing is captured while there are more than 5 errors per second.
+        leaf::capture_sampling_policy p(1, 0, 5);
+        leaf::set_capture_sampling_policy(&p);
+        int n = 0;
+        for( int i = 0; i != 20; ++i )
+            n += handle();
+        BOOST_TEST_GE(n, 5);
+        BOOST_TEST_LE(n, 10);
+        int m = 0;
+        for( int i = 0; i != 20; ++i )
+            m += handle();
+        BOOST_TEST_LE(m, 10);
+        leaf::set_capture_sampling_policy(nullptr);
+    }
+
+    {
+        // try_capture_all captures all errors.
+        leaf::capture_sampling_policy p(1, 0, 1);
+        leaf::set_capture_sampling_policy(&p);
+        for( int i = 0; i != 3; ++i )
+        {
+            leaf::result<void> r = leaf::try_capture_all(
+                []
+                {
+                    return f();
+                } );
+            int x = 0;
+            leaf::try_handle_all(
+                [&]
+                {
+                    return std::move(r);
+                },
+                [&]( e_unhandled e, e_preloaded pre )
+                {
+                    x = e.value + pre.value;
+                },
+                []
+                {
+                } );
+            BOOST_TEST_EQ(x, 1234 + 4242);
+        }
+        BOOST_TEST_EQ(p.sampled() + p.declined(), 0u);
+        leaf::set_capture_sampling_policy(nullptr);
+    }
+
+    BOOST_TEST(handle());
+
+    return boost::report_errors();
+}
+
+#endif
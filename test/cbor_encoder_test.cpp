@@ -0,0 +1,369 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/common.hpp>
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/exception.hpp>
+#endif
+
+#include <boost/leaf/serialization/cbor_encoder.hpp>
+#include <boost/leaf/serialization/cbor_decoder.hpp>
+#include <boost/leaf/serialization/json_encoder.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lightweight_test.hpp"
+
+namespace leaf = boost::leaf;
+
+using leaf::serialization::cbor_encoder;
+using leaf::serialization::cbor_id;
+using leaf::serialization::cbor_names;
+using leaf::serialization::cbor_to_json;
+using leaf::serialization::json_encoder;
+
+namespace boost { namespace leaf {
+
+namespace serialization {
+
+template <class Handle, class T>
+void serialize(Handle & h, T const & x, char const * name)
+{
+    h.dispatch(
+        [&](cbor_encoder & e) { output_at(e, x, name); },
+        [&](json_encoder & e) { output_at(e, x, name); }
+    );
+}
+
+}
+
+} }
+
+template <int N>
+struct my_error
+{
+    int code;
+    char const * message;
+
+    template <class Encoder>
+    friend void output(Encoder & e, my_error const & x)
+    {
+        output_at(e, x.code, "code");
+        output_at(e, x.message, "message");
+    }
+};
+
+struct my_error_with_vector
+{
+    std::vector<int> value;
+};
+
+enum class color { red = 1, green = 2 };
+
+struct empty_object
+{
+    template <class Encoder>
+    friend void output(Encoder &, empty_object const &)
+    {
+    }
+};
+
+leaf::result<void> fail()
+{
+    auto load = leaf::on_error(my_error<2>{2, "error two"}, color::green);
+    return BOOST_LEAF_NEW_ERROR(
+        42,
+        -1234567890123ll,
+        0.5,
+        my_error<1>{1, "error \"one\""},
+        my_error_with_vector{{10, 20, 30}},
+        leaf::e_api_function{"my_api_function"} );
+}
+
+void append(void * state, char const * s, std::size_t n)
+{
+    static_cast<std::string *>(state)->append(s, n);
+}
+
+std::string bytes(std::initializer_list<unsigned> b)
+{
+    std::string s;
+    for( unsigned x: b )
+        s += static_cast<char>(x);
+    return s;
+}
+
+std::string id(char const * name)
+{
+    std::uint32_t x = cbor_id(name);
+    return bytes({0x1A, x >> 24, (x >> 16) & 0xFF, (x >> 8) & 0xFF, x & 0xFF});
+}
+
+// The key cbor_to_json writes for an id which is not registered.
+std::string unknown_id(char const * name)
+{
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "#%08x", static_cast<unsigned>(cbor_id(name)));
+    return buf;
+}
+
+template <class T>
+std::string encode_one(T const & x)
+{
+    std::string s;
+    {
+        cbor_encoder e(&append, &s);
+        output_at(e, x, "x");
+    }
+    BOOST_TEST_EQ(s.substr(0, 6), bytes({0xBF}) + id("x"));
+    BOOST_TEST_EQ(s.back(), static_cast<char>(0xFF));
+    return s.substr(6, s.size() - 7);
+}
+
+std::string to_json(std::string const & cbor, cbor_names const & names)
+{
+    std::ostringstream s;
+    BOOST_TEST(cbor_to_json(reinterpret_cast<unsigned char const *>(cbor.data()), cbor.size(), s, names));
+    return s.str();
+}
+
+int main()
+{
+    BOOST_TEST_EQ(cbor_id(""), 2166136261u);
+    BOOST_TEST_EQ(cbor_id("a"), 0xe40c292cu);
+    BOOST_TEST_EQ(cbor_id("foobar"), 0xbf9cf968u);
+    BOOST_TEST_EQ(cbor_id("foobar", 3), cbor_id("foo"));
+    {
+        leaf::detail::type_name tn = leaf::detail::get_type_name<my_error<1>>();
+        BOOST_TEST_EQ(cbor_id(tn.name_not_zero_terminated_at_length, tn.length), static_cast<std::uint32_t>(tn.hash));
+    }
+
+    {
+        unsigned char buf[16];
+        cbor_encoder e(buf, sizeof(buf));
+        BOOST_TEST_EQ(e.finish(), 1);
+        BOOST_TEST_EQ(buf[0], 0xA0);
+    }
+
+    BOOST_TEST_EQ(encode_one(0), bytes({0x00}));
+    BOOST_TEST_EQ(encode_one(23u), bytes({0x17}));
+    BOOST_TEST_EQ(encode_one(24), bytes({0x18, 0x18}));
+    BOOST_TEST_EQ(encode_one(256), bytes({0x19, 0x01, 0x00}));
+    BOOST_TEST_EQ(encode_one(70000), bytes({0x1A, 0x00, 0x01, 0x11, 0x70}));
+    BOOST_TEST_EQ(encode_one(std::numeric_limits<unsigned long long>::max()), bytes({0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+    BOOST_TEST_EQ(encode_one(-1), bytes({0x20}));
+    BOOST_TEST_EQ(encode_one(-500), bytes({0x39, 0x01, 0xF3}));
+    BOOST_TEST_EQ(encode_one(std::numeric_limits<long long>::min()), bytes({0x3B, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}));
+    BOOST_TEST_EQ(encode_one(true), bytes({0xF5}));
+    BOOST_TEST_EQ(encode_one(false), bytes({0xF4}));
+    BOOST_TEST_EQ(encode_one(color::green), bytes({0x02}));
+    BOOST_TEST_EQ(encode_one(1.5f), bytes({0xFA, 0x3F, 0xC0, 0x00, 0x00}));
+    BOOST_TEST_EQ(encode_one(0.5), bytes({0xFB, 0x3F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+    BOOST_TEST_EQ(encode_one("ab"), bytes({0x62, 'a', 'b'}));
+    BOOST_TEST_EQ(encode_one(std::string("ab")), bytes({0x62, 'a', 'b'}));
+    BOOST_TEST_EQ(encode_one(static_cast<char const *>(nullptr)), bytes({0xF6}));
+    BOOST_TEST_EQ(encode_one(std::vector<int>{1, -1}), bytes({0x9F, 0x01, 0x20, 0xFF}));
+    BOOST_TEST_EQ(encode_one(std::vector<int>{}), bytes({0x9F, 0xFF}));
+    BOOST_TEST_EQ(encode_one(empty_object{}), bytes({0xF6}));
+    BOOST_TEST_EQ(encode_one(my_error<1>{1, "one"}), bytes({0xBF}) + id("code") + bytes({0x01}) + id("message") + bytes({0x63, 'o', 'n', 'e', 0xFF}));
+
+    {
+        std::string s;
+        {
+            cbor_encoder e(&append, &s);
+            output_at(e, 1, "0");
+            output_at(e, 2, "123456789");
+            output_at(e, 3, "1234567890");
+            output_at(e, 4, "1a");
+        }
+        BOOST_TEST_EQ(s,
+            bytes({0xBF, 0x20, 0x01, 0x3A, 0x07, 0x5B, 0xCD, 0x15, 0x02}) +
+            id("1234567890") + bytes({0x03}) +
+            id("1a") + bytes({0x04, 0xFF}));
+        BOOST_TEST_EQ(to_json(s, cbor_names()), "{\"0\":1,\"123456789\":2,\"" + unknown_id("1234567890") + "\":3,\"" + unknown_id("1a") + "\":4}");
+    }
+
+    {
+        std::string s;
+        {
+            cbor_encoder e(&append, &s);
+            output_at(e, 42, "int");
+            output_at(e, my_error<1>{1, "one"}, "my_error");
+        }
+        unsigned char small[8];
+        std::memset(small, 0, sizeof(small));
+        {
+            cbor_encoder e(small, sizeof(small));
+            output_at(e, 42, "int");
+            output_at(e, my_error<1>{1, "one"}, "my_error");
+            BOOST_TEST_EQ(e.finish(), s.size());
+        }
+        BOOST_TEST_EQ(std::string(reinterpret_cast<char const *>(small), sizeof(small)), s.substr(0, sizeof(small)));
+
+        std::ostringstream os;
+        BOOST_TEST(!cbor_to_json(small, sizeof(small), os));
+        for( std::size_t n = 0; n != s.size(); ++n )
+        {
+            std::ostringstream os;
+            BOOST_TEST(!cbor_to_json(reinterpret_cast<unsigned char const *>(s.data()), n, os));
+        }
+    }
+
+    if( std::FILE * f = std::tmpfile() )
+    {
+        {
+            cbor_encoder e(f);
+            output_at(e, 42, "int");
+        }
+        std::rewind(f);
+        char buf[64] = { };
+        std::size_t n = std::fread(buf, 1, sizeof(buf), f);
+        std::fclose(f);
+        BOOST_TEST_EQ(std::string(buf, n), bytes({0xBF}) + id("int") + bytes({0x18, 0x2A, 0xFF}));
+    }
+
+    {
+        cbor_names names;
+        names.add<int>();
+        names.add<long long>();
+        names.add<double>();
+        names.add<color>();
+        names.add<my_error<1>>();
+        names.add<my_error<2>>();
+        names.add<my_error_with_vector>();
+        names.add("code");
+        names.add("message");
+
+        std::string cbor;
+        char json[2048];
+        leaf::try_handle_all(
+            []
+            {
+                return fail();
+            },
+            [&](leaf::diagnostic_details const & dd)
+            {
+                {
+                    cbor_encoder e(&append, &cbor);
+                    dd.serialize_to(e);
+                }
+                json_encoder e(json, sizeof(json));
+                dd.serialize_to(e);
+                BOOST_TEST_LT(e.finish(), sizeof(json));
+            } );
+        std::printf("%d diagnostic_details: %u bytes CBOR, %u bytes JSON\n", __LINE__, unsigned(cbor.size()), unsigned(std::strlen(json)));
+        BOOST_TEST_LT(cbor.size(), std::strlen(json));
+        BOOST_TEST_EQ(to_json(cbor, names), json);
+
+        std::string partial = to_json(cbor, cbor_names());
+        std::printf("%d decoded without user names:\n%s\n", __LINE__, partial.c_str());
+        BOOST_TEST(partial.find("\"boost::leaf::error_id\":") != std::string::npos);
+        BOOST_TEST(partial.find("\"boost::leaf::e_source_location\":{\"file\":\"") != std::string::npos);
+        BOOST_TEST(partial.find("my_error") == std::string::npos);
+    }
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        std::string cbor;
+        char json[2048];
+        leaf::try_catch(
+            []
+            {
+                throw std::runtime_error("what \"quoted\"");
+            },
+            [&](leaf::diagnostic_info const & di)
+            {
+                {
+                    cbor_encoder e(&append, &cbor);
+                    di.serialize_to(e);
+                }
+                json_encoder e(json, sizeof(json));
+                di.serialize_to(e);
+            } );
+        BOOST_TEST_EQ(to_json(cbor, cbor_names()), json);
+    }
+#endif
+
+    {
+        // Member names passed as name_id are encoded the same as when passed
+        // as char const *.
+        std::string s1, s2;
+        {
+            cbor_encoder e(&append, &s1);
+            output_at(e, 42, "file");
+            output_at(e, my_error<1>{1, "one"}, "my_error");
+        }
+        {
+            cbor_encoder e(&append, &s2);
+            output_at(e, 42, leaf::serialization::name_id("file"));
+            output_at(e, my_error<1>{1, "one"}, leaf::serialization::name_id("my_error", cbor_id("my_error")));
+        }
+        BOOST_TEST_EQ(s1, s2);
+    }
+
+    {
+        // cbor_names registers the names of the error types LEAF defines, and
+        // of their members.
+        std::string cbor;
+        leaf::try_handle_all(
+            []() -> leaf::result<void>
+            {
+                leaf::e_trace<4> tr;
+                tr.push("file.cpp", 1);
+                return BOOST_LEAF_NEW_ERROR(
+                    tr,
+                    leaf::e_api_function{"f"},
+                    leaf::e_file_name{"name"},
+                    leaf::e_errno{2},
+                    leaf::e_type_info_name{"t"},
+                    leaf::e_at_line{3},
+                    leaf::windows::e_LastError{4}
+#if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
+                    , std::make_error_code(std::errc::invalid_argument)
+#endif
+                    );
+            },
+            [&](
+                leaf::e_trace<4> const &,
+                leaf::e_api_function,
+                leaf::e_file_name const &,
+                leaf::e_errno,
+                leaf::e_type_info_name,
+                leaf::e_at_line,
+                leaf::windows::e_LastError,
+#if BOOST_LEAF_CFG_STD_SYSTEM_ERROR
+                std::error_code const &,
+#endif
+                leaf::diagnostic_info const & di )
+            {
+                cbor_encoder e(&append, &cbor);
+                di.serialize_to(e);
+            },
+            []
+            {
+                BOOST_TEST(false);
+            } );
+        cbor_names names;
+        names.add<leaf::e_trace<4>>();
+        std::string json = to_json(cbor, names);
+        std::printf("%d LEAF error types:\n%s\n", __LINE__, json.c_str());
+        BOOST_TEST_EQ(json.find("\"#"), std::string::npos);
+        BOOST_TEST(json.find("\"frames\":{\"0\":{\"file\":\"file.cpp\",\"line\":1}}") != std::string::npos);
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,126 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#ifdef BOOST_LEAF_NO_EXCEPTIONS
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/exception.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#endif
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "lightweight_test.hpp"
+
+#ifndef BOOST_LEAF_NO_THREADS
+#   include <thread>
+#   include <vector>
+#endif
+
+namespace leaf = boost::leaf;
+
+namespace leaf_test
+{
+    struct my_exception: std::exception { };
+    template <class T> struct my_template: std::runtime_error { my_template(): std::runtime_error("my_template") { } };
+}
+
+bool same_as_demangler( std::type_info const & type )
+{
+    leaf::detail::demangler d(type.name());
+    leaf::detail::type_info_demangler first(type);
+    bool ok = std::strcmp(first.get(), d.get()) == 0;
+    // The first call for a given type fills the cache, the others hit it.
+    for( int i = 0; i != 3; ++i )
+    {
+        leaf::detail::type_info_demangler td(type);
+        ok = ok && std::strcmp(td.get(), d.get()) == 0;
+#if BOOST_LEAF_CFG_DEMANGLE_CACHE && defined(BOOST_LEAF_HAS_CXXABI_H)
+        ok = ok && td.get() == first.get();
+#endif
+    }
+    return ok;
+}
+
+bool check_all()
+{
+    return
+        same_as_demangler(typeid(std::exception)) &&
+        same_as_demangler(typeid(std::runtime_error)) &&
+        same_as_demangler(typeid(leaf_test::my_exception)) &&
+        same_as_demangler(typeid(leaf_test::my_template<int>)) &&
+        same_as_demangler(typeid(leaf_test::my_template<leaf_test::my_exception>));
+}
+
+int main()
+{
+    BOOST_TEST(check_all());
+
+    for( int i = 0; i != 2; ++i )
+    {
+        std::string s = leaf::try_catch(
+            [i]() -> std::string
+            {
+                if( i == 0 )
+                    throw std::runtime_error("what");
+                else
+                    throw leaf_test::my_template<int>();
+            },
+            []( leaf::diagnostic_info const & di )
+            {
+                std::ostringstream st;
+                st << di;
+                return st.str();
+            } );
+        std::cout << s << std::endl;
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+        BOOST_TEST_NE(s.find(i == 0 ? "std::runtime_error" : "leaf_test::my_template<int>"), s.npos);
+#endif
+    }
+
+#ifndef BOOST_LEAF_NO_THREADS
+    {
+        // Several threads filling and reading the same cache entries
+        // (my_template<char> is not in the cache yet).
+        std::vector<std::thread> threads;
+        std::vector<int> ok(4, 0);
+        for( int t = 0; t != 4; ++t )
+            threads.emplace_back(
+                [t, &ok]
+                {
+                    bool r = true;
+                    for( int i = 0; i != 200; ++i )
+                        r = r && same_as_demangler(typeid(leaf_test::my_template<char>)) && check_all();
+                    ok[t] = r;
+                } );
+        for( auto & t : threads )
+            t.join();
+        for( int r : ok )
+            BOOST_TEST(r);
+    }
+#endif
+
+    return boost::report_errors();
+}
+
+#endif // #ifdef BOOST_LEAF_NO_EXCEPTIONS
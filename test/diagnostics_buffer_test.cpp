@@ -0,0 +1,197 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/config.hpp>
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/exception.hpp>
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#if BOOST_LEAF_CFG_STD_STRING
+#   include <sstream>
+#   include <string>
+#endif
+
+#include <cstring>
+#include <vector>
+
+#include "lightweight_test.hpp"
+
+namespace leaf = boost::leaf;
+
+template <int>
+struct info
+{
+    int value;
+};
+
+struct e_ratio
+{
+    double value;
+};
+
+enum class color { red = 1, green = 2 };
+
+struct point
+{
+    int x, y;
+#if BOOST_LEAF_CFG_DIAGNOSTICS
+    friend std::ostream & operator<<( std::ostream & os, point const & p )
+    {
+        return os << '(' << p.x << ", " << p.y << ')';
+    }
+#endif
+};
+
+struct e_unprintable
+{
+    std::vector<int> value;
+};
+
+struct e_pointer
+{
+    int const * value;
+};
+
+#if BOOST_LEAF_CFG_STD_STRING
+struct e_name
+{
+    std::string value;
+};
+#endif
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+struct my_exception: std::exception
+{
+    char const * what() const noexcept override
+    {
+        return "my_exception what";
+    }
+};
+#endif
+
+leaf::result<void> f()
+{
+    auto load = leaf::on_error(info<2>{-42}, color::green);
+    return BOOST_LEAF_NEW_ERROR(
+        info<1>{1},
+        e_ratio{0.125},
+        point{3, 4},
+        e_unprintable{},
+        e_pointer{nullptr}
+#if BOOST_LEAF_CFG_STD_STRING
+        , e_name{"name"}
+#endif
+        );
+}
+
+// Checks that print_to produces the same output as operator<<, and that it
+// truncates predictably when the buffer is too small.
+template <class T>
+void check( T const & x )
+{
+    char buf[2048];
+    std::size_t n = print_to(buf, sizeof(buf), x);
+    BOOST_TEST_EQ(n, std::strlen(buf));
+    BOOST_TEST_LT(n, sizeof(buf));
+
+#if BOOST_LEAF_CFG_STD_STRING
+    std::ostringstream s;
+    s << x;
+    BOOST_TEST_EQ(s.str(), buf);
+#endif
+
+    {
+        char small[16];
+        std::memset(small, 'x', sizeof(small));
+        BOOST_TEST_EQ(print_to(small, sizeof(small), x), n);
+        BOOST_TEST_EQ(std::strlen(small), sizeof(small) - 1);
+        BOOST_TEST_EQ(std::strncmp(small, buf, sizeof(small) - 1), 0);
+    }
+
+    {
+        char one = 'x';
+        BOOST_TEST_EQ(print_to(&one, 1, x), n);
+        BOOST_TEST_EQ(one, 0);
+    }
+
+    BOOST_TEST_EQ(print_to(nullptr, 0, x), n);
+
+    {
+        // The returned length is sufficient to retry with a larger buffer.
+        std::vector<char> arena(n + 1, 'x');
+        BOOST_TEST_EQ(print_to(arena.data(), arena.size(), x), n);
+        BOOST_TEST_EQ(std::strcmp(arena.data(), buf), 0);
+    }
+}
+
+int main()
+{
+    leaf::try_handle_all(
+        []
+        {
+            return f();
+        },
+        []( leaf::error_info const & ei, leaf::diagnostic_info const & di, leaf::diagnostic_details const & dd )
+        {
+            check(ei);
+            check(di);
+            check(dd);
+
+            char buf[2048];
+            (void) print_to(buf, sizeof(buf), dd);
+            BOOST_TEST(std::strstr(buf, "Error with serial #") == buf);
+            BOOST_TEST(std::strstr(buf, " reported at ") != nullptr);
+#if BOOST_LEAF_CFG_DIAGNOSTICS && BOOST_LEAF_CFG_CAPTURE
+            BOOST_TEST(std::strstr(buf, "Diagnostic details:") != nullptr);
+            BOOST_TEST(std::strstr(buf, "info<1>: 1") != nullptr);
+            BOOST_TEST(std::strstr(buf, "e_ratio: 0.125") != nullptr);
+            BOOST_TEST(std::strstr(buf, "point: (3, 4)") != nullptr);
+            BOOST_TEST(std::strstr(buf, "e_pointer: <nullptr>") != nullptr);
+#   if BOOST_LEAF_CFG_STD_STRING
+            BOOST_TEST(std::strstr(buf, "e_name: name") != nullptr);
+#   endif
+            BOOST_TEST(std::strstr(buf, "info<2>: -42") != nullptr);
+            BOOST_TEST(std::strstr(buf, "color: 2") != nullptr);
+#elif BOOST_LEAF_CFG_DIAGNOSTICS
+            BOOST_TEST(std::strstr(buf, "N/A due to BOOST_LEAF_CFG_CAPTURE=0") != nullptr);
+#else
+            BOOST_TEST(std::strstr(buf, "N/A due to BOOST_LEAF_CFG_DIAGNOSTICS=0") != nullptr);
+#endif
+        } );
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    leaf::try_catch(
+        []
+        {
+            leaf::throw_exception(my_exception{}, info<1>{1});
+        },
+        []( leaf::error_info const & ei, leaf::diagnostic_details const & dd )
+        {
+            check(ei);
+            check(dd);
+
+            char buf[2048];
+            (void) print_to(buf, sizeof(buf), ei);
+            BOOST_TEST(std::strstr(buf, "my_exception") != nullptr);
+            BOOST_TEST(std::strstr(buf, ": \"my_exception what\"") != nullptr);
+        } );
+
+    leaf::try_catch(
+        []
+        {
+            throw my_exception{};
+        },
+        []( leaf::error_info const & ei )
+        {
+            check(ei);
+        } );
+#endif
+
+    return boost::report_errors();
+}
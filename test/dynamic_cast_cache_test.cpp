@@ -0,0 +1,190 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/leaf/config.hpp>
+
+#ifdef BOOST_LEAF_NO_EXCEPTIONS
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/exception.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/pred.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+
+#ifndef BOOST_LEAF_NO_THREADS
+#   include <thread>
+#   include <vector>
+#endif
+
+namespace leaf = boost::leaf;
+
+struct info { int value; };
+struct base: std::exception { int b = 1; };
+struct mixin { virtual ~mixin() { } int m = 2; };
+struct derived: base, mixin { int d = 3; };
+struct vbase: virtual std::exception { int v = 4; };
+struct vderived1: vbase { };
+struct vderived2: vbase { };
+struct diamond: vderived1, vderived2 { };
+struct tagged: std::exception, info { tagged(): info{42} { } };
+struct other: std::exception { };
+
+template <class... Ex>
+bool same_as_dynamic_cast( std::exception const & ex )
+{
+    void const * p[sizeof...(Ex)];
+    void const * const expected[sizeof...(Ex)] = { static_cast<void const *>(dynamic_cast<Ex const *>(&ex))... };
+    bool ok = true;
+    // The first call for a given dynamic type fills the cache, the others
+    // hit it.
+    for( int i = 0; i != 3; ++i )
+    {
+        leaf::detail::dynamic_cast_cache<Ex...>::cast(ex, p);
+        for( std::size_t j = 0; j != sizeof...(Ex); ++j )
+            ok = ok && p[j] == expected[j];
+    }
+    return ok;
+}
+
+template <class... Ex>
+bool check_all()
+{
+    base b;
+    derived d;
+    vderived1 v;
+    diamond dd;
+    tagged t;
+    other o;
+    return
+        same_as_dynamic_cast<Ex...>(b) &&
+        same_as_dynamic_cast<Ex...>(d) &&
+        same_as_dynamic_cast<Ex...>(v) &&
+        same_as_dynamic_cast<Ex...>(static_cast<vderived1 const &>(dd)) &&
+        same_as_dynamic_cast<Ex...>(t) &&
+        same_as_dynamic_cast<Ex...>(o);
+}
+
+int main()
+{
+    // Includes ambiguous casts (vbase in diamond), cross casts (mixin,
+    // info) and virtual bases.
+    BOOST_TEST(check_all<base>());
+    BOOST_TEST(check_all<mixin>());
+    BOOST_TEST((check_all<base, mixin, derived, vbase, vderived1, vderived2, diamond, info, tagged, other>()));
+    BOOST_TEST((check_all<std::exception, info>()));
+
+    {
+        // Two distinct std::exception subobjects of the same dynamic type.
+        struct twice: base, other { };
+        twice x;
+        BOOST_TEST((same_as_dynamic_cast<base, other, twice>(static_cast<base const &>(x))));
+        BOOST_TEST((same_as_dynamic_cast<base, other, twice>(static_cast<other const &>(x))));
+    }
+
+    for( int i = 0; i != 3; ++i )
+    {
+        int r = leaf::try_catch(
+            [i]() -> int
+            {
+                if( i == 0 )
+                    throw derived();
+                else if( i == 1 )
+                    throw tagged();
+                else
+                    throw other();
+            },
+            []( leaf::catch_<vbase, mixin> m )
+            {
+                return dynamic_cast<derived const &>(m.matched).m;
+            },
+            []( leaf::catch_<tagged> t, info const & x )
+            {
+                return t.matched.value + x.value;
+            },
+            []( leaf::catch_<base, other> )
+            {
+                return 3;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, i == 0 ? 2 : i == 1 ? 84 : 3);
+    }
+
+    for( int i = 0; i != 3; ++i )
+    {
+        int r = leaf::try_handle_all(
+            [i]
+            {
+                return leaf::exception_to_result<base, info, mixin>(
+                    [i]() -> int
+                    {
+                        if( i == 0 )
+                            throw derived();
+                        else if( i == 1 )
+                            throw tagged();
+                        else
+                            throw other();
+                    } );
+            },
+            []( base const & b, mixin const & m )
+            {
+                return b.b * 10 + m.m;
+            },
+            []( info const & x )
+            {
+                return x.value;
+            },
+            []( std::exception_ptr const & )
+            {
+                return 5;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, i == 0 ? 12 : i == 1 ? 42 : 5);
+    }
+
+#ifndef BOOST_LEAF_NO_THREADS
+    {
+        // Several threads filling and reading the same cache entries.
+        std::vector<std::thread> threads;
+        std::vector<int> ok(4, 0);
+        for( int t = 0; t != 4; ++t )
+            threads.emplace_back(
+                [t, &ok]
+                {
+                    bool r = true;
+                    for( int i = 0; i != 2000; ++i )
+                        r = r && check_all<base, mixin, info, vbase>();
+                    ok[t] = r;
+                } );
+        for( auto & t : threads )
+            t.join();
+        for( int r : ok )
+            BOOST_TEST(r);
+    }
+#endif
+
+    return boost::report_errors();
+}
+
+#endif // #ifdef BOOST_LEAF_NO_EXCEPTIONS
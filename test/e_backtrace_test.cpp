@@ -0,0 +1,189 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include <boost/leaf/backtrace.hpp>
+
+#include "lightweight_test.hpp"
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace leaf = boost::leaf;
+
+using backtrace = leaf::e_backtrace<4>;
+
+#ifdef _MSC_VER
+#   define NOINLINE __declspec(noinline)
+#else
+#   define NOINLINE __attribute__((noinline))
+#endif
+
+NOINLINE leaf::result<int> f( int depth, bool fail )
+{
+    BOOST_LEAF_BACKTRACE(backtrace);
+    if( depth == 0 )
+    {
+        if( fail )
+            return leaf::new_error();
+        return 42;
+    }
+    auto r = f(depth - 1, fail);
+    return r;
+}
+
+NOINLINE leaf::result<int> g()
+{
+    return leaf::new_error(&backtrace::capture);
+}
+
+struct test_encoder
+{
+    std::string path;
+    std::string & out;
+
+    template <class Encoder, class T, class... Deprioritize>
+    friend typename std::enable_if<std::is_same<Encoder, test_encoder>::value>::type
+    output( Encoder & e, T const & x, Deprioritize... )
+    {
+        std::ostringstream s;
+        s << x;
+        e.out += e.path + '=' + s.str() + ';';
+    }
+
+    template <class T>
+    friend void output_at( test_encoder & e, T const & x, char const * name )
+    {
+        test_encoder nested{e.path + '/' + name, e.out};
+        output(nested, x);
+    }
+};
+
+int main()
+{
+    {
+        backtrace bt;
+        BOOST_TEST_EQ(bt.capacity(), 4);
+        BOOST_TEST_EQ(bt.size(), 0);
+        int x[6];
+        for( int i = 0; i != 6; ++i )
+            bt.push(&x[i]);
+        BOOST_TEST_EQ(bt.size(), 4);
+        BOOST_TEST_EQ(bt.dropped(), 2);
+        BOOST_TEST_EQ(bt[0], &x[0]);
+        BOOST_TEST_EQ(bt[3], &x[3]);
+
+        std::ostringstream s;
+        s << bt;
+        BOOST_TEST(s.str().find("0x") == 0);
+        BOOST_TEST(s.str().find(" (2 dropped)") != std::string::npos);
+
+        std::string out;
+        test_encoder e{"", out};
+        output(e, bt);
+        BOOST_TEST(out.find("/dropped=2;") == 0);
+        BOOST_TEST(out.find("/frames/0/address=0x") != std::string::npos);
+        BOOST_TEST(out.find("/frames/3/address=0x") != std::string::npos);
+        BOOST_TEST(out.find("/frames/4/") == std::string::npos);
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(2, true);
+            },
+            []( backtrace const & bt )
+            {
+                BOOST_TEST_EQ(bt.size(), 3);
+                BOOST_TEST_EQ(bt.dropped(), 0);
+#if defined(__GNUC__) || defined(_MSC_VER)
+                for( std::size_t i = 0; i != bt.size(); ++i )
+                    BOOST_TEST(bt[i] != nullptr);
+#endif
+#if BOOST_LEAF_CFG_DLADDR
+                std::string out;
+                test_encoder e{"", out};
+                output(e, bt);
+                BOOST_TEST(out.find("/frames/0/module=") != std::string::npos);
+                BOOST_TEST(out.find("/frames/0/module_offset=0x") != std::string::npos);
+#endif
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 1);
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(10, true);
+            },
+            []( backtrace const & bt )
+            {
+                BOOST_TEST_EQ(bt.size(), 4);
+                BOOST_TEST_EQ(bt.dropped(), 7);
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 1);
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(2, false);
+            },
+            []( backtrace const & )
+            {
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 42);
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return g();
+            },
+            []( backtrace const & bt )
+            {
+#if BOOST_LEAF_CFG_WIN32 || (defined(__GNUC__) && !defined(_WIN32))
+                BOOST_TEST_GT(bt.size(), 0);
+                for( std::size_t i = 0; i != bt.size(); ++i )
+                    BOOST_TEST(bt[i] != nullptr);
+#endif
+                std::ostringstream s;
+                s << bt;
+                BOOST_TEST(bt.size() == 0 || s.str().find("0x") == 0);
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 1);
+    }
+
+    return boost::report_errors();
+}
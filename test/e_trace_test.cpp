@@ -0,0 +1,188 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/common.hpp>
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace leaf = boost::leaf;
+
+using trace = leaf::e_trace<4>;
+
+int trace_line = 0;
+
+leaf::result<int> f( int depth, bool fail )
+{
+    BOOST_LEAF_TRACE(trace); trace_line = __LINE__;
+    if( depth == 0 )
+    {
+        if( fail )
+            return leaf::new_error();
+        return 42;
+    }
+    return f(depth - 1, fail);
+}
+
+struct test_encoder
+{
+    std::string path;
+    std::string & out;
+
+    template <class Encoder, class T, class... Deprioritize>
+    friend typename std::enable_if<std::is_same<Encoder, test_encoder>::value>::type
+    output( Encoder & e, T const & x, Deprioritize... )
+    {
+        std::ostringstream s;
+        s << x;
+        e.out += e.path + '=' + s.str() + ';';
+    }
+
+    template <class T>
+    friend void output_at( test_encoder & e, T const & x, char const * name )
+    {
+        test_encoder nested{e.path + '/' + name, e.out};
+        output(nested, x);
+    }
+};
+
+int main()
+{
+    {
+        trace tr;
+        BOOST_TEST_EQ(tr.capacity(), 4);
+        BOOST_TEST_EQ(tr.size(), 0);
+        BOOST_TEST_EQ(tr.dropped(), 0);
+        tr.push("a", 1);
+        tr.push("b", 2);
+        BOOST_TEST_EQ(tr.size(), 2);
+        BOOST_TEST_EQ(tr.dropped(), 0);
+        BOOST_TEST_EQ(tr[0].line, 1);
+        BOOST_TEST_EQ(tr[1].line, 2);
+        for( int i = 3; i != 8; ++i )
+            tr.push("c", i);
+        BOOST_TEST_EQ(tr.size(), 4);
+        BOOST_TEST_EQ(tr.dropped(), 3);
+        BOOST_TEST_EQ(tr[0].line, 4);
+        BOOST_TEST_EQ(tr[3].line, 7);
+
+        std::ostringstream s;
+        s << tr;
+        BOOST_TEST_EQ(s.str(), "c(4), c(5), c(6), c(7) (3 dropped)");
+
+        std::string out;
+        test_encoder e{"", out};
+        output(e, tr);
+        BOOST_TEST_EQ(out,
+            "/dropped=3;"
+            "/frames/0/file=c;/frames/0/line=4;"
+            "/frames/1/file=c;/frames/1/line=5;"
+            "/frames/2/file=c;/frames/2/line=6;"
+            "/frames/3/file=c;/frames/3/line=7;");
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(2, true);
+            },
+            []( trace const & tr )
+            {
+                BOOST_TEST_EQ(tr.size(), 3);
+                BOOST_TEST_EQ(tr.dropped(), 0);
+                for( std::size_t i = 0; i != tr.size(); ++i )
+                {
+                    BOOST_TEST_EQ(tr[i].line, trace_line);
+                    BOOST_TEST(std::strstr(tr[i].file, "e_trace_test.cpp") != nullptr);
+                }
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 1);
+    }
+
+    {
+        // Deep recursion keeps only the last 4 frames.
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(100, true);
+            },
+            []( trace const & tr )
+            {
+                BOOST_TEST_EQ(tr.size(), 4);
+                BOOST_TEST_EQ(tr.dropped(), 97);
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 1);
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(2, false);
+            },
+            []( trace const & )
+            {
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 42);
+    }
+
+    {
+        // Without a handler that takes the trace, nothing is recorded.
+        leaf::error_id id;
+        int r = leaf::try_handle_all(
+            [&]
+            {
+                auto r = f(2, true);
+                id = r.error();
+                return r;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 2);
+        r = leaf::try_handle_all(
+            [&]() -> leaf::result<int>
+            {
+                return id;
+            },
+            []( trace const & )
+            {
+                return 1;
+            },
+            []
+            {
+                return 2;
+            } );
+        BOOST_TEST_EQ(r, 2);
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,110 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_LEAF_CFG_ERROR_ID_BITS 64
+#define BOOST_LEAF_CFG_STD_SYSTEM_ERROR 0
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <future>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+namespace leaf = boost::leaf;
+
+static_assert(sizeof(leaf::error_id().value()) == 8, "Bad error_id value type");
+
+constexpr int ids_per_thread = 10000;
+
+std::vector<long long> generate_ids()
+{
+    std::vector<long long> ids;
+    ids.reserve(ids_per_thread);
+    for(int i=0; i!=ids_per_thread; ++i)
+    {
+        long long id = leaf::new_error().value();
+        BOOST_TEST_EQ(id&3, 1);
+        BOOST_TEST_GT(id, 0);
+        BOOST_TEST_EQ(id, leaf::detail::current_id());
+        if( !ids.empty() )
+            BOOST_TEST_EQ(id, ids.back() + 4);
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+struct info
+{
+    long long value;
+};
+
+leaf::result<void *> f( long long x )
+{
+    if( x )
+        return leaf::new_error(info{x});
+    return nullptr;
+}
+
+int main()
+{
+    if( sizeof(void *) == 8 && !(BOOST_LEAF_CFG_CAPTURE && BOOST_LEAF_CFG_CAPTURE_BUDGET) )
+    {
+        BOOST_TEST_EQ(sizeof(leaf::result<void *>), 2 * sizeof(void *));
+        BOOST_TEST_EQ(sizeof(leaf::result<long long>), 2 * sizeof(long long));
+    }
+
+    {
+        long long r = leaf::try_handle_all(
+            []() -> leaf::result<long long>
+            {
+                BOOST_LEAF_AUTO(p, f(42));
+                return p ? 1 : 2;
+            },
+            []( info const & i, leaf::error_info const & ei )
+            {
+                BOOST_TEST_EQ(ei.error().value(), leaf::detail::current_id());
+                return i.value;
+            },
+            []
+            {
+                return -1LL;
+            } );
+        BOOST_TEST_EQ(r, 42);
+    }
+
+#ifdef BOOST_LEAF_NO_THREADS
+    std::vector<long long> all_ids = generate_ids();
+#else
+    constexpr int thread_count = 100;
+    using thread_ids = std::future<std::vector<long long>>;
+    std::vector<thread_ids> fut;
+    fut.reserve(thread_count);
+    std::generate_n(
+        std::back_inserter(fut),
+        thread_count,
+        [=]
+        {
+            return std::async(std::launch::async, &generate_ids);
+        });
+    std::vector<long long> all_ids;
+    for(auto & f : fut)
+    {
+        auto fv = f.get();
+        all_ids.insert(all_ids.end(), fv.begin(), fv.end());
+    }
+#endif
+    std::sort(all_ids.begin(), all_ids.end());
+    auto u = std::unique(all_ids.begin(), all_ids.end());
+    BOOST_TEST(u == all_ids.end());
+
+    return boost::report_errors();
+}
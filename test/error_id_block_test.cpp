@@ -0,0 +1,85 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE 16
+
+#include <boost/leaf/config.hpp>
+
+#if defined(BOOST_LEAF_NO_THREADS) || defined(BOOST_LEAF_USE_TLS_ARRAY) || BOOST_LEAF_CFG_WIN32 == 2
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/error.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <future>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace leaf = boost::leaf;
+
+constexpr int ids_per_thread = 10000;
+
+std::vector<int> generate_ids()
+{
+    std::vector<int> ids;
+    ids.reserve(ids_per_thread);
+    for(int i=0; i!=ids_per_thread; ++i)
+    {
+        int id = leaf::new_error().value();
+        BOOST_TEST_EQ(id&3, 1);
+        BOOST_TEST_EQ(id, leaf::detail::current_id());
+        if( i % BOOST_LEAF_CFG_ERROR_ID_BLOCK_SIZE )
+            BOOST_TEST_EQ(id, ids.back() + 4);
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+int main()
+{
+    {
+        leaf::error_id e1 = leaf::new_error();
+        leaf::error_id e2 = leaf::new_error();
+        BOOST_TEST_EQ(e1.value(), 5);
+        BOOST_TEST_EQ(e2.value(), 9);
+    }
+    constexpr int thread_count = 100;
+    using thread_ids = std::future<std::vector<int>>;
+    std::vector<thread_ids> fut;
+    fut.reserve(thread_count);
+    std::generate_n(
+        std::back_inserter(fut),
+        thread_count,
+        [=]
+        {
+            return std::async(std::launch::async, &generate_ids);
+        });
+    std::vector<int> all_ids;
+    for(auto & f : fut)
+    {
+        auto fv = f.get();
+        all_ids.insert(all_ids.end(), fv.begin(), fv.end());
+    }
+    std::sort(all_ids.begin(), all_ids.end());
+    auto u = std::unique(all_ids.begin(), all_ids.end());
+    BOOST_TEST(u == all_ids.end());
+
+    return boost::report_errors();
+}
+
+#endif // #if defined(BOOST_LEAF_NO_THREADS) || defined(BOOST_LEAF_USE_TLS_ARRAY) || BOOST_LEAF_CFG_WIN32 == 2
@@ -0,0 +1,289 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/exception.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include <boost/leaf/fingerprint.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+
+#ifndef BOOST_LEAF_NO_THREADS
+#   include <thread>
+#   include <vector>
+#endif
+
+#include "lightweight_test.hpp"
+
+namespace leaf = boost::leaf;
+
+struct e_code { int value; };
+struct e_name { std::string value; };
+struct e_other { };
+enum class color { red = 1, green = 2 };
+
+leaf::result<void> fail( int kind, int code )
+{
+    auto load = leaf::on_error(e_name{"name"});
+    switch( kind )
+    {
+        case 0: return BOOST_LEAF_NEW_ERROR(e_code{code});
+        case 1: return BOOST_LEAF_NEW_ERROR(e_code{code}, e_other{});
+        case 2: return BOOST_LEAF_NEW_ERROR(e_code{code}, color::red);
+        case 3: return BOOST_LEAF_NEW_ERROR(e_code{code}, color::green);
+        default: return kind == 4 ? BOOST_LEAF_NEW_ERROR(e_code{code}, e_other{}) : BOOST_LEAF_NEW_ERROR(e_other{}, e_code{code});
+    }
+}
+
+template <class Key = void>
+std::uint64_t fingerprint_details( int kind, int code )
+{
+    std::uint64_t fp = 0;
+    leaf::try_handle_all(
+        [&]
+        {
+            return fail(kind, code);
+        },
+        [&]( leaf::diagnostic_details const & dd )
+        {
+            fp = leaf::fingerprint<Key>(dd);
+        } );
+    return fp;
+}
+
+template <class Key = void>
+std::uint64_t fingerprint_info( int kind, int code )
+{
+    std::uint64_t fp = 0;
+    leaf::try_handle_all(
+        [&]
+        {
+            return fail(kind, code);
+        },
+        [&]( e_code, leaf::diagnostic_info const & di )
+        {
+            fp = leaf::fingerprint<Key>(di);
+        },
+        [&]( leaf::error_info const & ei )
+        {
+            fp = leaf::fingerprint<Key>(ei);
+        } );
+    return fp;
+}
+
+int main()
+{
+    // Stable across occurrences, although the error ids differ.
+    BOOST_TEST_EQ(fingerprint_details(0, 1), fingerprint_details(0, 1));
+    BOOST_TEST_EQ(fingerprint_info(0, 1), fingerprint_info(0, 1));
+    BOOST_TEST_EQ(fingerprint_details(0, 1), fingerprint_details(0, 2));
+
+    // Different source locations.
+    BOOST_TEST_NE(fingerprint_info(0, 1), fingerprint_info(1, 1));
+
+    // Same source location, independent of the order of the error objects.
+    BOOST_TEST_EQ(fingerprint_details(4, 1), fingerprint_details(5, 1));
+
+#if BOOST_LEAF_CFG_CAPTURE
+    // Different sets of error objects (only diagnostic_details sees error
+    // objects which were not handled).
+    BOOST_TEST_NE(fingerprint_details(2, 1), fingerprint_details(0, 1));
+#endif
+
+    // Key values.
+    BOOST_TEST_NE(fingerprint_info<e_code>(0, 1), fingerprint_info<e_code>(0, 2));
+    BOOST_TEST_EQ(fingerprint_info<e_code>(0, 1), fingerprint_info<e_code>(0, 1));
+    BOOST_TEST_NE(fingerprint_info<e_code>(0, 1), fingerprint_info(0, 1));
+#if BOOST_LEAF_CFG_CAPTURE
+    BOOST_TEST_NE(fingerprint_details<e_code>(0, 1), fingerprint_details<e_code>(0, 2));
+    BOOST_TEST_EQ(fingerprint_details<e_name>(0, 1), fingerprint_details<e_name>(0, 2));
+    BOOST_TEST_NE(fingerprint_details<e_name>(0, 1), fingerprint_details(0, 1));
+#endif
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        struct error1: std::exception { };
+        struct error2: std::exception { };
+        auto fp = []( int i )
+        {
+            return leaf::try_catch(
+                [i]() -> std::uint64_t
+                {
+                    if( i == 1 )
+                        throw error1();
+                    else
+                        throw error2();
+                },
+                []( leaf::error_info const & ei )
+                {
+                    return leaf::fingerprint(ei);
+                } );
+        };
+        BOOST_TEST_EQ(fp(1), fp(1));
+        BOOST_TEST_NE(fp(1), fp(2));
+    }
+#endif
+
+    {
+        leaf::error_aggregator agg;
+        for( int i = 0; i != 10; ++i )
+            leaf::try_handle_all(
+                [&]
+                {
+                    return fail(i % 2, i);
+                },
+                [&]( leaf::diagnostic_details const & dd )
+                {
+                    BOOST_TEST(agg.record(dd));
+                } );
+        std::map<std::uint64_t, std::uint64_t> counts;
+        int n = 0;
+        agg.summarize(
+            [&]( std::uint64_t fp, std::uint64_t count, char const * exemplar )
+            {
+                counts[fp] = count;
+                ++n;
+                BOOST_TEST(std::strstr(exemplar, "Error with serial #") == exemplar);
+            } );
+        BOOST_TEST_EQ(n, 2);
+        BOOST_TEST_EQ(counts[fingerprint_details(0, 0)], 5u);
+        BOOST_TEST_EQ(counts[fingerprint_details(1, 0)], 5u);
+
+        n = 0;
+        agg.summarize(
+            [&]( std::uint64_t, std::uint64_t, char const * )
+            {
+                ++n;
+            } );
+        BOOST_TEST_EQ(n, 0);
+        BOOST_TEST_EQ(agg.dropped(), 0u);
+    }
+
+    {
+        leaf::error_aggregator agg(2, 16);
+        leaf::try_handle_all(
+            [&]
+            {
+                return fail(0, 0);
+            },
+            [&]( leaf::error_info const & ei )
+            {
+                BOOST_TEST(agg.record(4, ei));
+                BOOST_TEST(agg.record(5, ei));
+                BOOST_TEST(!agg.record(6, ei));
+                BOOST_TEST(agg.record(4, ei));
+            } );
+        BOOST_TEST_EQ(agg.dropped(), 1u);
+        int n = 0;
+        agg.summarize(
+            [&]( std::uint64_t fp, std::uint64_t count, char const * exemplar )
+            {
+                BOOST_TEST_EQ(count, fp == 4 ? 2u : 1u);
+                BOOST_TEST_EQ(std::strlen(exemplar), 15u);
+                ++n;
+            } );
+        BOOST_TEST_EQ(n, 2);
+    }
+
+    {
+        // Entries of errors which do not occur between two calls to
+        // summarize are reclaimed.
+        leaf::error_aggregator agg(2, 16);
+        std::map<std::uint64_t, std::uint64_t> counts;
+        auto summarize = [&]
+        {
+            counts.clear();
+            agg.summarize(
+                [&]( std::uint64_t fp, std::uint64_t count, char const * )
+                {
+                    BOOST_TEST(counts.insert(std::make_pair(fp, count)).second);
+                } );
+        };
+        leaf::try_handle_all(
+            [&]
+            {
+                return fail(0, 0);
+            },
+            [&]( leaf::error_info const & ei )
+            {
+                // 4 and 6 both start probing at the first entry.
+                BOOST_TEST(agg.record(4, ei));
+                BOOST_TEST(agg.record(6, ei));
+                BOOST_TEST(!agg.record(8, ei));
+                summarize();
+                BOOST_TEST_EQ(counts.size(), 2u);
+
+                // 4 is reclaimed; 6 must still be found past the hole.
+                BOOST_TEST(agg.record(6, ei));
+                summarize();
+                BOOST_TEST_EQ(counts.size(), 1u);
+                BOOST_TEST_EQ(counts[6], 1u);
+                BOOST_TEST(agg.record(6, ei));
+                BOOST_TEST(agg.record(8, ei));
+                BOOST_TEST(agg.record(8, ei));
+                summarize();
+                BOOST_TEST_EQ(counts.size(), 2u);
+                BOOST_TEST_EQ(counts[6], 1u);
+                BOOST_TEST_EQ(counts[8], 2u);
+
+                // Both are reclaimed, so new errors are counted again.
+                summarize();
+                BOOST_TEST(counts.empty());
+                summarize();
+                BOOST_TEST(counts.empty());
+                BOOST_TEST(agg.record(10, ei));
+                BOOST_TEST(agg.record(12, ei));
+                summarize();
+                BOOST_TEST_EQ(counts.size(), 2u);
+            } );
+        BOOST_TEST_EQ(agg.dropped(), 1u);
+    }
+
+#ifndef BOOST_LEAF_NO_THREADS
+    {
+        // Several threads recording the same errors.
+        leaf::error_aggregator agg;
+        std::vector<std::thread> threads;
+        for( int t = 0; t != 4; ++t )
+            threads.emplace_back(
+                [&agg]
+                {
+                    for( int i = 0; i != 1000; ++i )
+                        leaf::try_handle_all(
+                            [&]
+                            {
+                                return fail(i % 4, i);
+                            },
+                            [&]( leaf::diagnostic_info const & di )
+                            {
+                                agg.record(di);
+                            } );
+                } );
+        for( auto & t : threads )
+            t.join();
+        std::uint64_t total = 0;
+        int n = 0;
+        agg.summarize(
+            [&]( std::uint64_t, std::uint64_t count, char const * )
+            {
+                total += count;
+                ++n;
+            } );
+        BOOST_TEST_EQ(n, 4);
+        BOOST_TEST_EQ(total, 4000u);
+    }
+#endif
+
+    return boost::report_errors();
+}
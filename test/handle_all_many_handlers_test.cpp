@@ -0,0 +1,151 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/pred.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+
+namespace leaf = boost::leaf;
+
+struct e_common { int value; };
+template <int> struct e_kind { int value; };
+template <int> struct e_tag { int value; };
+
+// More than 64 handlers, each with its own e-type, so that the context has
+// more slots than fit in a single word of the slot mask.
+int const handler_count = 70;
+
+template <int I>
+struct handler
+{
+    int operator()( e_common const & c, e_kind<I % 3> const &, e_tag<I> const & ) const
+    {
+        return c.value * 1000 + I;
+    }
+};
+
+template <int N, class... H>
+struct handlers
+{
+    using type = typename handlers<N - 1, handler<N - 1>, H...>::type;
+};
+
+template <class... H>
+struct handlers<0, H...>
+{
+    using type = std::tuple<H...>;
+};
+
+template <int I>
+leaf::result<int> fail()
+{
+    return leaf::new_error(e_common{1}, e_kind<I % 3>{I}, e_tag<I>{I});
+}
+
+template <int I>
+int test()
+{
+    return leaf::try_handle_all(
+        []
+        {
+            return fail<I>();
+        },
+        typename handlers<handler_count>::type{ },
+        []
+        {
+            return -1;
+        } );
+}
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+struct mixin { int value; };
+struct my_exception: std::exception, mixin { my_exception(): mixin{42} { } };
+#endif
+
+int main()
+{
+    BOOST_TEST_EQ(test<0>(), 1000);
+    BOOST_TEST_EQ(test<1>(), 1001);
+    BOOST_TEST_EQ(test<63>(), 1063);
+    BOOST_TEST_EQ(test<64>(), 1064);
+    BOOST_TEST_EQ(test<69>(), 1069);
+
+    {
+        // e_kind<1> doesn't match e_tag<3>, so no handler matches.
+        int r = leaf::try_handle_all(
+            []() -> leaf::result<int>
+            {
+                return leaf::new_error(e_common{1}, e_kind<1>{1}, e_tag<3>{3});
+            },
+            typename handlers<handler_count>::type{ },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, -1);
+    }
+
+    {
+        // Predicates are still evaluated after the slot mask test.
+        int r = leaf::try_handle_all(
+            []() -> leaf::result<int>
+            {
+                return leaf::new_error(e_common{1}, e_tag<2>{2});
+            },
+            []( leaf::match_value<e_tag<2>, 1> )
+            {
+                return 1;
+            },
+            []( leaf::match_value<e_tag<1>, 2> )
+            {
+                return 2;
+            },
+            []( leaf::match_value<e_tag<2>, 2>, e_tag<3> const & )
+            {
+                return 3;
+            },
+            []( e_common const &, leaf::match_value<e_tag<2>, 2> )
+            {
+                return 4;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 4);
+    }
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        // Error types not found in a slot can still be matched by the
+        // exception object.
+        int r = leaf::try_catch(
+            []() -> int
+            {
+                leaf::throw_exception(my_exception{}, e_common{1});
+            },
+            []( e_tag<1> const & )
+            {
+                return 1;
+            },
+            []( e_common const & c, mixin const & m )
+            {
+                return c.value * 100 + m.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 142);
+    }
+#endif
+
+    return boost::report_errors();
+}
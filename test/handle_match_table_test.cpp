@@ -0,0 +1,187 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/pred.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+
+namespace leaf = boost::leaf;
+
+enum class err_code { a, b, c, d, e, f, g, h };
+enum other_code { x = -5, y = 0, z = 7 };
+
+struct e_status { int value; };
+struct e_kind { err_code value; };
+
+// Runs of two or more handlers which take a single match<> or match_value<>
+// argument with the same error type are dispatched through a sorted table.
+using match_a = leaf::match<err_code, err_code::a>;
+using match_bc = leaf::match<err_code, err_code::c, err_code::b>;
+using match_db = leaf::match<err_code, err_code::d, err_code::b>;
+using match_status_1 = leaf::match_value<e_status, 1>;
+using match_status_2_3 = leaf::match_value<e_status, 3, 2>;
+
+namespace boost { namespace leaf { namespace detail {
+
+static_assert(predicate_key<match_a>::value, "match<err_code, ...> must be keyed");
+static_assert(predicate_key<match_status_1>::value, "match_value<e_status, ...> must be keyed");
+static_assert(predicate_key<match<other_code, x, z>>::value, "match<other_code, ...> must be keyed");
+static_assert(std::is_same<predicate_key<match_a>::key_source, predicate_key<match_db>::key_source>::value, "Same key_source expected");
+static_assert(!std::is_same<predicate_key<match_a>::key_source, predicate_key<match_status_1>::key_source>::value, "Different key_source expected");
+static_assert(!predicate_key<if_not<match_a>>::value, "if_not<> is not keyed");
+static_assert(!predicate_key<e_status>::value, "Error types are not keyed");
+
+} } }
+
+template <class E>
+int handle( E e )
+{
+    return leaf::try_handle_all(
+        [&]() -> leaf::result<int>
+        {
+            return leaf::new_error(e);
+        },
+        []( match_a )
+        {
+            return 1;
+        },
+        []( match_bc )
+        {
+            return 2;
+        },
+        []( match_db ) // err_code::b is matched by the previous handler
+        {
+            return 3;
+        },
+        []( leaf::match<err_code, err_code::h, err_code::a> ) // err_code::a is matched by the first handler
+        {
+            return 4;
+        },
+        []( match_status_1 )
+        {
+            return 5;
+        },
+        []( match_status_2_3 m )
+        {
+            return 60 + m.matched.value;
+        },
+        []( leaf::match<other_code, z, x> )
+        {
+            return 7;
+        },
+        []( err_code )
+        {
+            return 8;
+        },
+        []
+        {
+            return -1;
+        } );
+}
+
+int handle_broken_run( err_code e )
+{
+    return leaf::try_handle_all(
+        [&]() -> leaf::result<int>
+        {
+            return leaf::new_error(e);
+        },
+        []( match_a )
+        {
+            return 1;
+        },
+        []( leaf::if_not<match_bc> )
+        {
+            return 2;
+        },
+        []( match_bc )
+        {
+            return 3;
+        },
+        []( match_db )
+        {
+            return 4;
+        },
+        []
+        {
+            return -1;
+        } );
+}
+
+int main()
+{
+    BOOST_TEST_EQ(handle(err_code::a), 1);
+    BOOST_TEST_EQ(handle(err_code::b), 2);
+    BOOST_TEST_EQ(handle(err_code::c), 2);
+    BOOST_TEST_EQ(handle(err_code::d), 3);
+    BOOST_TEST_EQ(handle(err_code::h), 4);
+    BOOST_TEST_EQ(handle(err_code::e), 8);
+    BOOST_TEST_EQ(handle(e_status{1}), 5);
+    BOOST_TEST_EQ(handle(e_status{2}), 62);
+    BOOST_TEST_EQ(handle(e_status{3}), 63);
+    BOOST_TEST_EQ(handle(e_status{4}), -1);
+    BOOST_TEST_EQ(handle(z), 7);
+    BOOST_TEST_EQ(handle(x), 7);
+    BOOST_TEST_EQ(handle(y), -1);
+    BOOST_TEST_EQ(handle(42), -1);
+
+    BOOST_TEST_EQ(handle_broken_run(err_code::a), 1);
+    BOOST_TEST_EQ(handle_broken_run(err_code::b), 3);
+    BOOST_TEST_EQ(handle_broken_run(err_code::c), 3);
+    BOOST_TEST_EQ(handle_broken_run(err_code::d), 2);
+
+    {
+        // match_value<> with an enum value.
+        int r = leaf::try_handle_all(
+            []() -> leaf::result<int>
+            {
+                return leaf::new_error(e_kind{err_code::c});
+            },
+            []( leaf::match_value<e_kind, err_code::a> )
+            {
+                return 1;
+            },
+            []( leaf::match_value<e_kind, err_code::c> )
+            {
+                return 2;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 2);
+    }
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        struct my_exception: std::exception, e_status { my_exception(): e_status{3} { } };
+        int r = leaf::try_catch(
+            []() -> int
+            {
+                throw my_exception();
+            },
+            []( match_status_1 )
+            {
+                return 1;
+            },
+            []( match_status_2_3 m )
+            {
+                return 60 + m.matched.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 63);
+    }
+#endif
+
+    return boost::report_errors();
+}
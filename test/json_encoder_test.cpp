@@ -0,0 +1,263 @@
+// Copyright 2018-2026 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/diagnostics.hpp>
+#   include <boost/leaf/common.hpp>
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/exception.hpp>
+#endif
+
+#include <boost/leaf/serialization/json_encoder.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lightweight_test.hpp"
+
+namespace leaf = boost::leaf;
+
+using leaf::serialization::json_encoder;
+
+namespace boost { namespace leaf {
+
+namespace serialization {
+
+template <class Handle, class T>
+void serialize(Handle & h, T const & x, char const * name)
+{
+    h.dispatch(
+        [&](json_encoder & e) { output_at(e, x, name); }
+    );
+}
+
+}
+
+} }
+
+template <int N>
+struct my_error
+{
+    int code;
+    char const * message;
+
+    template <class Encoder>
+    friend void output(Encoder & e, my_error const & x)
+    {
+        output_at(e, x.code, "code");
+        output_at(e, x.message, "message");
+    }
+};
+
+struct my_error_with_vector
+{
+    std::vector<int> value;
+};
+
+enum class color { red = 1, green = 2 };
+
+struct empty_object
+{
+    template <class Encoder>
+    friend void output(Encoder &, empty_object const &)
+    {
+    }
+};
+
+leaf::result<void> fail()
+{
+    auto load = leaf::on_error(my_error<2>{2, "error two"});
+    return BOOST_LEAF_NEW_ERROR(
+        42,
+        my_error<1>{1, "error one"},
+        my_error_with_vector{{10, 20, 30}},
+        leaf::e_api_function{"my_api_function"} );
+}
+
+// Counts nesting to verify that the output is balanced.
+bool balanced(char const * s)
+{
+    int depth = 0;
+    bool in_string = false;
+    for( ; *s; ++s )
+    {
+        if( in_string )
+        {
+            if( *s == '\\' )
+                ++s;
+            else if( *s == '"' )
+                in_string = false;
+        }
+        else if( *s == '"' )
+            in_string = true;
+        else if( *s == '{' || *s == '[' )
+            ++depth;
+        else if( *s == '}' || *s == ']' )
+            --depth;
+        if( depth < 0 )
+            return false;
+    }
+    return depth == 0 && !in_string;
+}
+
+void append(void * state, char const * s, std::size_t n)
+{
+    static_cast<std::string *>(state)->append(s, n);
+}
+
+int main()
+{
+    {
+        char buf[256];
+        json_encoder e(buf, sizeof(buf));
+        BOOST_TEST_EQ(e.finish(), 2);
+        BOOST_TEST_EQ(std::string(buf), "{}");
+    }
+
+    {
+        char buf[1024];
+        std::size_t n;
+        {
+            json_encoder e(buf, sizeof(buf));
+            output_at(e, 42, "int");
+            output_at(e, -7ll, "long long");
+            output_at(e, 0u, "unsigned");
+            output_at(e, true, "bool");
+            output_at(e, 0.5, "double");
+            output_at(e, std::numeric_limits<double>::infinity(), "inf");
+            output_at(e, color::green, "color");
+            output_at(e, "a\"b\\c\nd\x01", "escaped");
+            output_at(e, std::string("string"), "std::string");
+            output_at(e, static_cast<char const *>(nullptr), "null");
+            output_at(e, std::vector<int>{1, 2, 3}, "vector");
+            output_at(e, std::vector<int>{}, "empty vector");
+            output_at(e, my_error<1>{1, "one"}, "my_error");
+            output_at(e, empty_object{}, "empty");
+            n = e.finish();
+        }
+        char const * expected =
+            "{"
+            "\"int\":42,"
+            "\"long long\":-7,"
+            "\"unsigned\":0,"
+            "\"bool\":true,"
+            "\"double\":0.5,"
+            "\"inf\":null,"
+            "\"color\":2,"
+            "\"escaped\":\"a\\\"b\\\\c\\nd\\u0001\","
+            "\"std::string\":\"string\","
+            "\"null\":null,"
+            "\"vector\":[1,2,3],"
+            "\"empty vector\":[],"
+            "\"my_error\":{\"code\":1,\"message\":\"one\"},"
+            "\"empty\":null"
+            "}";
+        BOOST_TEST_EQ(std::string(buf), expected);
+        BOOST_TEST_EQ(n, std::strlen(expected));
+
+        char small[10];
+        {
+            json_encoder e(small, sizeof(small));
+            output_at(e, 42, "int");
+            output_at(e, my_error<1>{1, "one"}, "my_error");
+            BOOST_TEST_EQ(e.finish(), std::strlen("{\"int\":42,\"my_error\":{\"code\":1,\"message\":\"one\"}}"));
+        }
+        BOOST_TEST_EQ(std::string(small), "{\"int\":42");
+    }
+
+    {
+        std::string s;
+        {
+            json_encoder e(&append, &s);
+            output_at(e, my_error<1>{1, "one"}, "my_error");
+        }
+        BOOST_TEST_EQ(s, "{\"my_error\":{\"code\":1,\"message\":\"one\"}}");
+    }
+
+    if( std::FILE * f = std::tmpfile() )
+    {
+        {
+            json_encoder e(f);
+            output_at(e, 42, "int");
+        }
+        std::rewind(f);
+        char buf[64] = { };
+        std::size_t n = std::fread(buf, 1, sizeof(buf) - 1, f);
+        std::fclose(f);
+        BOOST_TEST_EQ(std::string(buf, n), "{\"int\":42}");
+    }
+
+    {
+        char buf[2048];
+        leaf::try_handle_all(
+            []
+            {
+                return fail();
+            },
+            [&buf](leaf::diagnostic_details const & dd, my_error<1> const * e1)
+            {
+                BOOST_TEST(e1 != nullptr);
+                json_encoder e(buf, sizeof(buf));
+                dd.serialize_to(e);
+                BOOST_TEST_LT(e.finish(), sizeof(buf));
+            } );
+        std::printf("%d diagnostic_details JSON output:\n%s\n", __LINE__, buf);
+        BOOST_TEST(balanced(buf));
+        BOOST_TEST(std::strstr(buf, "{\"boost::leaf::error_id\":") == buf);
+        BOOST_TEST(std::strstr(buf, "\"boost::leaf::e_source_location\":{\"file\":\"") != nullptr);
+        BOOST_TEST(std::strstr(buf, "\"my_error<1>\":{\"code\":1,\"message\":\"error one\"}") != nullptr);
+        if( BOOST_LEAF_CFG_CAPTURE )
+        {
+            BOOST_TEST(std::strstr(buf, "\"int\":42") != nullptr);
+            BOOST_TEST(std::strstr(buf, "\"my_error<2>\":{\"code\":2,\"message\":\"error two\"}") != nullptr);
+            BOOST_TEST(std::strstr(buf, "\"my_error_with_vector\":[10,20,30]") != nullptr);
+            BOOST_TEST(std::strstr(buf, "\"boost::leaf::e_api_function\":\"my_api_function\"") != nullptr);
+        }
+        else
+        {
+            BOOST_TEST(std::strstr(buf, "\"int\"") == nullptr);
+            BOOST_TEST(std::strstr(buf, "my_error<2>") == nullptr);
+        }
+    }
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        char buf[2048];
+        leaf::try_catch(
+            []
+            {
+                throw std::runtime_error("what \"quoted\"");
+            },
+            [&buf](leaf::diagnostic_info const & di)
+            {
+                json_encoder e(buf, sizeof(buf));
+                di.serialize_to(e);
+            } );
+        std::printf("%d exception JSON output:\n%s\n", __LINE__, buf);
+        BOOST_TEST(balanced(buf));
+        BOOST_TEST(std::strstr(buf, "\"std::exception\":{\"dynamic_type\":\"") != nullptr);
+        BOOST_TEST(std::strstr(buf, "\"what\":\"what \\\"quoted\\\"\"}") != nullptr);
+    }
+#endif
+
+    {
+        char buf[256];
+        leaf::result<int> r = 42;
+        {
+            json_encoder e(buf, sizeof(buf));
+            r.serialize_to(e);
+        }
+        BOOST_TEST_EQ(std::string(buf), "{\"int\":42}");
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,142 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_LEAF_CFG_MONITOR_EXCEPTIONS 0
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/on_error.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/exception.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <stdexcept>
+
+namespace leaf = boost::leaf;
+
+// Under BOOST_LEAF_CFG_MONITOR_EXCEPTIONS=0, error_monitor only keeps track
+// of the current error id.
+static_assert(sizeof(leaf::error_monitor) == sizeof(leaf::error_id), "Unexpected error_monitor size");
+
+template <int>
+struct info
+{
+    int value;
+};
+
+leaf::result<int> g( bool fail )
+{
+    auto load = leaf::on_error(info<1>{1});
+    if( fail )
+        return leaf::new_error(info<2>{2});
+    return 42;
+}
+
+leaf::result<int> f( bool fail )
+{
+    auto load = leaf::on_error(info<3>{3}, []{ return info<4>{4}; });
+    return g(fail);
+}
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+int throw_leaf()
+{
+    auto load = leaf::on_error(info<1>{1});
+    leaf::throw_exception(info<2>{2});
+}
+
+int throw_other()
+{
+    auto load = leaf::on_error(info<1>{1});
+    throw std::runtime_error("other");
+}
+#endif
+
+int main()
+{
+    {
+        leaf::error_monitor m;
+        BOOST_TEST_EQ(m.check_id(), 0);
+        leaf::error_id id = leaf::new_error();
+        BOOST_TEST_EQ(m.check(), id);
+        BOOST_TEST_EQ(m.assigned_error_id(), id);
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(false);
+            },
+            []( info<1> const &, info<3> const & )
+            {
+                return 1;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 42);
+    }
+
+    {
+        int r = leaf::try_handle_all(
+            []
+            {
+                return f(true);
+            },
+            []( info<1> const & a, info<2> const & b, info<3> const & c, info<4> const & d )
+            {
+                return a.value * 1000 + b.value * 100 + c.value * 10 + d.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 1234);
+    }
+
+#ifndef BOOST_LEAF_NO_EXCEPTIONS
+    {
+        // LEAF exceptions communicate an error id, which on_error detects.
+        int r = leaf::try_catch(
+            []
+            {
+                return throw_leaf();
+            },
+            []( info<1> const & a, info<2> const & b )
+            {
+                return a.value * 10 + b.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 12);
+    }
+
+    {
+        // Exceptions which don't communicate an error id are not detected.
+        int r = leaf::try_catch(
+            []
+            {
+                return throw_other();
+            },
+            []( info<1> const & )
+            {
+                return 1;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, -1);
+    }
+#endif
+
+    return boost::report_errors();
+}
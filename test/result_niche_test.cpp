@@ -0,0 +1,202 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_CFG_CAPTURE
+#   undef BOOST_LEAF_CFG_CAPTURE
+#endif
+#define BOOST_LEAF_CFG_CAPTURE 0
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <climits>
+#include <vector>
+
+namespace leaf = boost::leaf;
+
+struct base
+{
+    int x;
+};
+
+struct derived: base
+{
+};
+
+struct not_niche
+{
+    int x;
+};
+
+enum class color: unsigned
+{
+    red,
+    green,
+    blue
+};
+
+enum class narrow: unsigned char
+{
+    a,
+    b
+};
+
+enum wide: long long
+{
+    w0,
+    w1 = 1000
+};
+
+namespace boost { namespace leaf {
+
+template <> struct is_result_niche<base *>: std::true_type { };
+template <> struct is_result_niche<base const *>: std::true_type { };
+template <> struct is_result_niche<derived *>: std::true_type { };
+template <> struct is_result_niche<color>: std::true_type { };
+template <> struct is_result_niche<narrow>: std::true_type { };
+template <> struct is_result_niche<wide>: std::true_type { };
+
+} }
+
+static_assert(sizeof(leaf::result<base *>) == sizeof(base *), "result<base *> must be niche-packed");
+static_assert(sizeof(leaf::result<derived *>) == sizeof(derived *), "result<derived *> must be niche-packed");
+static_assert(sizeof(color) < sizeof(leaf::error_id) || sizeof(leaf::result<color>) == sizeof(color), "result<color> must be niche-packed");
+static_assert(sizeof(leaf::result<wide>) == sizeof(wide), "result<wide> must be niche-packed");
+static_assert(sizeof(leaf::result<not_niche *>) > sizeof(not_niche *), "result<not_niche *> must not be niche-packed");
+static_assert(sizeof(leaf::result<narrow>) > sizeof(narrow), "result<narrow> is too narrow to be niche-packed");
+static_assert(std::is_trivially_copyable<leaf::result<base *>>::value, "result<base *> must be trivially copyable");
+static_assert(std::is_trivially_copyable<leaf::result<color>>::value, "result<color> must be trivially copyable");
+
+struct info
+{
+    int value;
+};
+
+template <class T>
+leaf::result<T> f( T v, int err )
+{
+    if( err )
+        return leaf::new_error(info{err});
+    return v;
+}
+
+template <class F>
+int handle( F f )
+{
+    return leaf::try_handle_all(
+        [&]() -> leaf::result<int>
+        {
+            BOOST_LEAF_CHECK(f());
+            return 0;
+        },
+        []( info const & i )
+        {
+            return i.value;
+        },
+        []
+        {
+            return -1;
+        } );
+}
+
+int main()
+{
+    derived d;
+    d.x = 42;
+
+    {
+        leaf::result<base *> r = f<base *>(&d, 0);
+        BOOST_TEST(r);
+        BOOST_TEST_EQ(r.value(), &d);
+        BOOST_TEST_EQ((*r)->x, 42);
+        leaf::result<base *> r2 = f<base *>(&d, 1);
+        BOOST_TEST(!r2);
+        BOOST_TEST_EQ(handle([&]{ return f<base *>(&d, 1); }), 1);
+        leaf::result<base *> n = f<base *>(nullptr, 0);
+        BOOST_TEST(n);
+        BOOST_TEST(n.value() == nullptr);
+    }
+
+    {
+        // Conversions between niche-packed results.
+        leaf::result<derived *> r = f<derived *>(&d, 0);
+        leaf::result<base *> rb = std::move(r);
+        BOOST_TEST(rb);
+        BOOST_TEST_EQ(rb.value(), &d);
+        leaf::result<base const *> rbc = std::move(rb);
+        BOOST_TEST(rbc);
+        BOOST_TEST_EQ(rbc.value(), &d);
+        leaf::result<derived *> e = f<derived *>(&d, 2);
+        leaf::error_id id = e.error();
+        rb = std::move(e);
+        BOOST_TEST(!rb);
+        BOOST_TEST_EQ(leaf::error_id(rb.error()), id);
+        BOOST_TEST_EQ(handle([&]() -> leaf::result<base *> { return f<derived *>(&d, 2); }), 2);
+    }
+
+    {
+        leaf::result<color> r = f(color::blue, 0);
+        BOOST_TEST(r);
+        BOOST_TEST(*r == color::blue);
+        leaf::result<color> r2 = f(color::blue, 3);
+        BOOST_TEST(!r2);
+        BOOST_TEST_EQ(handle([]{ return f(color::blue, 3); }), 3);
+        r2 = std::move(r);
+        BOOST_TEST(r2);
+        BOOST_TEST(*r2 == color::blue);
+    }
+
+    {
+        // Conversions between niche-packed and non-niche-packed results.
+        leaf::result<wide> r = f(w1, 0);
+        leaf::result<long long> rl = std::move(r);
+        BOOST_TEST(rl);
+        BOOST_TEST_EQ(rl.value(), 1000);
+        leaf::result<wide> e = f(w1, 4);
+        leaf::error_id id = e.error();
+        rl = std::move(e);
+        BOOST_TEST(!rl);
+        BOOST_TEST_EQ(leaf::error_id(rl.error()), id);
+        BOOST_TEST_EQ(handle([]() -> leaf::result<long long> { return f(w1, 5); }), 5);
+        BOOST_TEST_EQ(handle([]() -> leaf::result<long long> { return f(w1, 0); }), 0);
+        BOOST_TEST_EQ(handle([]{ return f(narrow::b, 6); }), 6);
+    }
+
+    {
+        // Default-constructed errors.
+        leaf::result<base *> r = leaf::error_id();
+        BOOST_TEST(!r);
+        leaf::result<color> c = leaf::error_id();
+        BOOST_TEST(!c);
+    }
+
+    {
+        // Error ids are preserved for all possible values.
+        std::vector<leaf::result<color>> v;
+        for( int i = 0; i != 100; ++i )
+            if( i % 3 )
+                v.push_back(color(i % 3));
+            else
+                v.push_back(leaf::new_error());
+        int values = 0;
+        for( auto & r : v )
+        {
+            if( r )
+            {
+                BOOST_TEST(*r == color::green || *r == color::blue);
+                ++values;
+            }
+            else
+                BOOST_TEST_NE(leaf::error_id(r.error()).value(), 0);
+        }
+        BOOST_TEST_EQ(values, 66);
+    }
+
+    return boost::report_errors();
+}
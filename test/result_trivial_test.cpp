@@ -0,0 +1,182 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifdef BOOST_LEAF_CFG_CAPTURE
+#   undef BOOST_LEAF_CFG_CAPTURE
+#endif
+#define BOOST_LEAF_CFG_CAPTURE 0
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/result.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <string>
+#include <type_traits>
+
+namespace leaf = boost::leaf;
+
+struct trivial
+{
+    int a;
+    short b;
+};
+
+static_assert(std::is_trivially_copyable<leaf::result<int>>::value, "result<int> must be trivially copyable");
+static_assert(std::is_trivially_copyable<leaf::result<void>>::value, "result<void> must be trivially copyable");
+static_assert(std::is_trivially_copyable<leaf::result<int &>>::value, "result<int &> must be trivially copyable");
+static_assert(std::is_trivially_copyable<leaf::result<trivial>>::value, "result<trivial> must be trivially copyable");
+static_assert(std::is_trivially_destructible<leaf::result<int>>::value, "result<int> must be trivially destructible");
+static_assert(std::is_trivially_destructible<leaf::result<void>>::value, "result<void> must be trivially destructible");
+static_assert(!std::is_trivially_copyable<leaf::result<std::string>>::value, "result<std::string> must not be trivially copyable");
+
+static_assert(!std::is_copy_constructible<leaf::result<int>>::value, "result<int> must not be copyable");
+static_assert(!std::is_copy_assignable<leaf::result<int>>::value, "result<int> must not be copyable");
+static_assert(std::is_nothrow_move_constructible<leaf::result<int>>::value, "result<int> must be nothrow movable");
+static_assert(std::is_nothrow_move_assignable<leaf::result<int>>::value, "result<int> must be nothrow movable");
+static_assert(std::is_nothrow_move_constructible<leaf::result<std::string>>::value, "result<std::string> must be nothrow movable");
+static_assert(std::is_nothrow_move_assignable<leaf::result<std::string>>::value, "result<std::string> must be nothrow movable");
+
+// On x86-64 (System V), a trivially copyable class of up to 16 bytes is
+// returned in rax:rdx. The probes below are written in assembly to return a
+// result<int> and a result<void> that way; if result<T> was returned in
+// memory, the caller would read it through a hidden pointer instead, and the
+// tests below would fail.
+#if defined(__x86_64__) && defined(__ELF__) && defined(__GNUC__)
+
+#define BOOST_LEAF_TEST_ABI_PROBES
+
+leaf::result<int> abi_probe_value() __asm__("boost_leaf_abi_probe_value");
+leaf::result<int> abi_probe_error() __asm__("boost_leaf_abi_probe_error");
+leaf::result<void> abi_probe_void() __asm__("boost_leaf_abi_probe_void");
+
+#if BOOST_LEAF_CFG_ERROR_ID_BITS == 64
+// The value is in rax, the result_discriminant is in rdx.
+__asm__(
+    ".pushsection .text\n"
+    "boost_leaf_abi_probe_value:\n"
+    "    movq $42, %rax\n"
+    "    movq $3, %rdx\n"
+    "    ret\n"
+    "boost_leaf_abi_probe_error:\n"
+    "    xorl %eax, %eax\n"
+    "    movq $5, %rdx\n"
+    "    ret\n"
+    "boost_leaf_abi_probe_void:\n" // result<void> has no data in the first eightbyte.
+    "    movq $3, %rax\n"
+    "    movq $3, %rdx\n"
+    "    ret\n"
+    ".popsection\n");
+#else
+// The value is in the low half of rax, the result_discriminant in the high
+// half.
+__asm__(
+    ".pushsection .text\n"
+    "boost_leaf_abi_probe_value:\n"
+    "    movabsq $0x30000002a, %rax\n"
+    "    ret\n"
+    "boost_leaf_abi_probe_error:\n"
+    "    movabsq $0x500000000, %rax\n"
+    "    ret\n"
+    "boost_leaf_abi_probe_void:\n"
+    "    movabsq $0x300000000, %rax\n"
+    "    ret\n"
+    ".popsection\n");
+#endif
+
+#endif // #if defined(__x86_64__) && defined(__ELF__) && defined(__GNUC__)
+
+leaf::result<int> f( int x )
+{
+    if( x )
+        return leaf::new_error(x);
+    return 42;
+}
+
+leaf::result<long> g( int x )
+{
+    BOOST_LEAF_AUTO(r, f(x));
+    return r;
+}
+
+int main()
+{
+    {
+        leaf::result<int> r = f(0);
+        BOOST_TEST(r);
+        leaf::result<int> r2 = std::move(r);
+        BOOST_TEST(r2);
+        BOOST_TEST_EQ(r2.value(), 42);
+        leaf::result<int> r3 = f(1);
+        BOOST_TEST(!r3);
+        r3 = std::move(r2);
+        BOOST_TEST(r3);
+        BOOST_TEST_EQ(*r3, 42);
+    }
+
+    {
+        leaf::result<long> r = g(0);
+        BOOST_TEST(r);
+        BOOST_TEST_EQ(r.value(), 42);
+        leaf::result<long> r2 = f(0);
+        BOOST_TEST_EQ(r2.value(), 42);
+    }
+
+    {
+        int v = leaf::try_handle_all(
+            []
+            {
+                return g(7);
+            },
+            []( int x )
+            {
+                return x;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(v, 7);
+    }
+
+    {
+        int x = 0;
+        leaf::result<int &> r(x);
+        leaf::result<int &> r2 = std::move(r);
+        ++*r2;
+        BOOST_TEST_EQ(x, 1);
+    }
+
+    {
+        leaf::result<void> r;
+        BOOST_TEST(r);
+        leaf::error_id id = leaf::new_error();
+        leaf::result<void> r2 = id;
+        BOOST_TEST(!r2);
+        r2 = std::move(r);
+        BOOST_TEST(r2);
+    }
+
+#ifdef BOOST_LEAF_TEST_ABI_PROBES
+    {
+        leaf::result<int> r = abi_probe_value();
+        BOOST_TEST(r);
+        BOOST_TEST_EQ(*r, 42);
+    }
+    {
+        leaf::result<int> r = abi_probe_error();
+        BOOST_TEST(!r);
+        BOOST_TEST_EQ(leaf::error_id(r.error()).value(), 5);
+    }
+    {
+        leaf::result<void> r = abi_probe_void();
+        BOOST_TEST(r);
+    }
+#endif
+
+    return boost::report_errors();
+}
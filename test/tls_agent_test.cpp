@@ -0,0 +1,141 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_LEAF_USE_TLS_AGENT
+
+#include <boost/leaf/config.hpp>
+
+#if defined(BOOST_LEAF_NO_THREADS) || defined(BOOST_LEAF_TLS_FREERTOS)
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/context.hpp>
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <thread>
+
+namespace leaf = boost::leaf;
+
+template <int>
+struct info
+{
+    int value;
+};
+
+// Simulates a scheduler resuming a suspended task on a different thread: the
+// task's agent_state is installed on a new thread, f is called, then the task
+// is suspended again.
+template <class F>
+void resume_on_another_thread( leaf::tls::agent_state & task, F f )
+{
+    std::thread t(
+        [&]
+        {
+            leaf::tls::agent_state * prev = leaf::tls::exchange_agent_state(&task);
+            BOOST_TEST_EQ(prev, nullptr);
+            f();
+            BOOST_TEST_EQ(leaf::tls::exchange_agent_state(prev), &task);
+        } );
+    t.join();
+}
+
+int main()
+{
+    leaf::tls::agent_state task;
+    BOOST_TEST_EQ(leaf::tls::exchange_agent_state(&task), nullptr);
+
+    {
+        leaf::result<int> r = leaf::try_handle_some(
+            [&]() -> leaf::result<int>
+            {
+                leaf::error_id id = leaf::new_error(info<1>{1});
+                BOOST_TEST_EQ(leaf::current_error(), id);
+
+                // Suspend the task in the middle of try_handle_some.
+                BOOST_TEST_EQ(leaf::tls::exchange_agent_state(nullptr), &task);
+                BOOST_TEST(leaf::current_error() != id);
+                BOOST_TEST_EQ(leaf::tls::read_ptr<leaf::detail::slot<info<1>>>(), nullptr);
+
+                // Threads that do not run the task do not see its state.
+                std::thread(
+                    [&]
+                    {
+                        BOOST_TEST_EQ(leaf::tls::read_ptr<leaf::detail::slot<info<1>>>(), nullptr);
+                        (void) leaf::new_error(info<1>{42}, info<2>{42});
+                    } ).join();
+
+                // Resume the task on another thread, where the in-flight error
+                // is still the current error, and can be augmented.
+                resume_on_another_thread(task,
+                    [&]
+                    {
+                        BOOST_TEST(leaf::tls::read_ptr<leaf::detail::slot<info<1>>>() != nullptr);
+                        BOOST_TEST_EQ(leaf::current_error(), id);
+                        id.load(info<2>{2});
+                    } );
+
+                // Resume the task on the original thread.
+                BOOST_TEST_EQ(leaf::tls::exchange_agent_state(&task), nullptr);
+                BOOST_TEST_EQ(leaf::current_error(), id);
+                return id;
+            },
+            []( info<1> const & i1, info<2> const & i2 ) -> leaf::result<int>
+            {
+                return i1.value * 10 + i2.value;
+            } );
+        BOOST_TEST(r);
+        BOOST_TEST_EQ(r.value(), 12);
+    }
+
+    {
+        // A context activated by a task on one thread can be deactivated by
+        // the same task on another thread.
+        leaf::tls::agent_state task2;
+        leaf::context<info<1>, info<2>> ctx;
+        leaf::error_id id;
+        resume_on_another_thread(task2,
+            [&]
+            {
+                ctx.activate();
+                id = leaf::new_error(info<1>{1});
+            } );
+        resume_on_another_thread(task2,
+            [&]
+            {
+                BOOST_TEST(ctx.is_active());
+                BOOST_TEST_EQ(leaf::current_error(), id);
+                id.load(info<2>{2});
+                ctx.deactivate();
+            } );
+        int r = ctx.handle_error<int>(id,
+            []( info<1> const & i1, info<2> const & i2 )
+            {
+                return i1.value * 10 + i2.value;
+            },
+            []
+            {
+                return -1;
+            } );
+        BOOST_TEST_EQ(r, 12);
+    }
+
+    BOOST_TEST_EQ(leaf::tls::exchange_agent_state(nullptr), &task);
+    return boost::report_errors();
+}
+
+#endif // #if defined(BOOST_LEAF_NO_THREADS) || defined(BOOST_LEAF_TLS_FREERTOS)
@@ -0,0 +1,126 @@
+// Copyright 2018-2025 Emil Dotchevski and Reverge Studios, Inc.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#define BOOST_LEAF_USE_TLS_BLOCK
+
+#include <boost/leaf/config.hpp>
+
+#if defined(BOOST_LEAF_NO_THREADS) || defined(BOOST_LEAF_TLS_FREERTOS)
+
+#include <iostream>
+
+int main()
+{
+    std::cout << "Unit test not applicable." << std::endl;
+    return 0;
+}
+
+#else
+
+#ifdef BOOST_LEAF_TEST_SINGLE_HEADER
+#   include "leaf.hpp"
+#else
+#   include <boost/leaf/handle_errors.hpp>
+#   include <boost/leaf/result.hpp>
+#endif
+
+#include "lightweight_test.hpp"
+#include <cstdint>
+#include <future>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace leaf = boost::leaf;
+
+template <int>
+struct info
+{
+    int value;
+};
+
+template <class T>
+bool in_tls_block( T const * p )
+{
+    void * const * b = leaf::detail::tls_block<>::p;
+    return std::find(b, b + BOOST_LEAF_CFG_TLS_ARRAY_SIZE, static_cast<void const *>(p)) != b + BOOST_LEAF_CFG_TLS_ARRAY_SIZE;
+}
+
+leaf::result<int> f( int x )
+{
+    if( x & 1 )
+        return leaf::new_error(info<1>{x}, info<2>{x + 1});
+    if( x & 2 )
+        return leaf::new_error(info<3>{x});
+    return x;
+}
+
+int test( int x )
+{
+    return leaf::try_handle_all(
+        [&]() -> leaf::result<int>
+        {
+            BOOST_TEST(in_tls_block(leaf::tls::read_ptr<leaf::detail::slot<info<1>>>()));
+            BOOST_TEST(in_tls_block(leaf::tls::read_ptr<leaf::detail::slot<info<2>>>()));
+            BOOST_TEST(in_tls_block(leaf::tls::read_ptr<leaf::detail::slot<info<3>>>()));
+            return leaf::try_handle_some(
+                [&]() -> leaf::result<int>
+                {
+                    return f(x);
+                },
+                []( info<3> const & i3 ) -> leaf::result<int>
+                {
+                    return -i3.value;
+                } );
+        },
+        []( info<1> const & i1, info<2> const & i2 )
+        {
+            BOOST_TEST_EQ(i1.value + 1, i2.value);
+            return -i1.value;
+        },
+        []
+        {
+            return 0;
+        } );
+}
+
+int run( int n )
+{
+    BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(&leaf::detail::tls_block<>::p[0]) % 64, 0);
+    int errors = 0;
+    for( int i = 0; i != n; ++i )
+    {
+        int r = test(i);
+        if( i & 3 )
+        {
+            BOOST_TEST_EQ(r, -i);
+            ++errors;
+        }
+        else
+            BOOST_TEST_EQ(r, i);
+    }
+    BOOST_TEST_EQ(leaf::tls::read_ptr<leaf::detail::slot<info<1>>>(), nullptr);
+    BOOST_TEST_EQ(leaf::tls::read_ptr<leaf::detail::slot<info<3>>>(), nullptr);
+    return errors;
+}
+
+int main()
+{
+    constexpr int thread_count = 16;
+    constexpr int iterations = 1000;
+    std::vector<std::future<int>> fut;
+    fut.reserve(thread_count);
+    std::generate_n(
+        std::back_inserter(fut),
+        thread_count,
+        [=]
+        {
+            return std::async(std::launch::async, &run, iterations);
+        });
+    for( auto & f : fut )
+        BOOST_TEST_EQ(f.get(), iterations * 3 / 4);
+    return boost::report_errors();
+}
+
+#endif // #if defined(BOOST_LEAF_NO_THREADS) || defined(BOOST_LEAF_TLS_FREERTOS)
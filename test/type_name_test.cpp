@@ -41,11 +41,23 @@ template <class> struct struct_template2 { };
 
 bool test(detail::type_name const & tn, char const * correct)
 {
+    std::size_t h = 2166136261u;
+    for( char const * p = correct; *p; ++p )
+        h = (h ^ static_cast<std::size_t>(*p)) * 16777619u;
     return
         std::strlen(correct) == tn.length &&
-        std::memcmp(correct, tn.name_not_zero_terminated_at_length, tn.length) == 0;
+        std::memcmp(correct, tn.name_not_zero_terminated_at_length, tn.length) == 0 &&
+        tn.hash == h;
 }
 
+#if BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME
+constexpr detail::type_name int_name = detail::get_type_name<int>();
+static_assert(int_name.length == 3, "get_type_name must be constexpr");
+static_assert(int_name.name_not_zero_terminated_at_length[0] == 'i', "get_type_name must be constexpr");
+static_assert(int_name.name_not_zero_terminated_at_length[3] == 0, "get_type_name must be zero-terminated");
+static_assert(detail::get_type_name_zstr<int>() == int_name.name_not_zero_terminated_at_length, "get_type_name_zstr must match get_type_name");
+#endif
+
 int main()
 {
     using leaf::detail::get_type_name;
@@ -70,6 +82,10 @@ int main()
     BOOST_TEST(test(get_type_name<class_template2<int>>(), "class_template2<int>"));
     BOOST_TEST(test(get_type_name<struct_template2<int>>(), "struct_template2<int>"));
 
+#if BOOST_LEAF_CFG_CONSTEXPR_TYPE_NAME
+    BOOST_TEST(std::strcmp(leaf::detail::get_type_name_zstr<leaf_test::class_template2<int>>(), "leaf_test::class_template2<int>") == 0);
+#endif
+
     BOOST_TEST(get_type_name<int>() == get_type_name<int>());
     BOOST_TEST(get_type_name<class_>() == get_type_name<class_>());
     BOOST_TEST(!(get_type_name<int>() == get_type_name<float>()));